@@ -0,0 +1,157 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+//
+//  Beacon anomaly governor
+//
+
+#include <climits>
+#include <cstdio>
+
+#include "beaconAnomalyGovernor.h"
+
+static const double beaconAnomalyGovernorPeriod = 0.1; // sec
+static const double beaconAnomalyMaxDelay = 2.0; // sec
+static const double beaconAnomalyBurstPeriod = 1.0; // sec
+
+beaconAnomalyGovernor::beaconAnomalyGovernor (
+    beaconAnomalyGovernorNotify & iiuIn,
+    epicsTimerQueue & queueIn,
+    epicsMutex & mutexIn,
+    double rateIn ) :
+        lastRefill ( epicsTime::getCurrent () ),
+    mutex ( mutexIn ), timer ( queueIn.createTimer () ),
+    iiu ( iiuIn ), rate ( rateIn > 0.0 ? rateIn : 0.0 ),
+    tokens ( 0.0 ), backlog ( 0u ), nAnomalies ( 0u ),
+    nRescheduled ( 0u ), randomState ( 0u ),
+    active ( false ), stopped ( false )
+{
+    // all of the clients on the network see the same anomaly at
+    // about the same time so each must choose a different delay
+    epicsTimeStamp ts = this->lastRefill;
+    this->randomState = ts.nsec ^ ( ts.secPastEpoch << 16u ) ^
+        static_cast < unsigned > ( reinterpret_cast < size_t > ( this ) );
+}
+
+beaconAnomalyGovernor::~beaconAnomalyGovernor ()
+{
+    this->timer.destroy ();
+}
+
+void beaconAnomalyGovernor::anomalyNotify (
+    epicsGuard < epicsMutex > & guard )
+{
+    guard.assertIdenticalMutex ( this->mutex );
+
+    if ( this->stopped ) {
+        return;
+    }
+
+    this->nAnomalies++;
+
+    // a second anomaly prior to finishing with the first one does
+    // not add to the backlog because the same channels are involved
+    this->backlog = this->iiu.beaconAnomalyBacklog ( guard );
+    if ( this->backlog == 0u ) {
+        return;
+    }
+
+    if ( this->rate == 0.0 ) {
+        this->nRescheduled +=
+            this->iiu.beaconAnomalyReschedule ( guard, this->backlog );
+        this->backlog = 0u;
+        return;
+    }
+
+    if ( ! this->active ) {
+        this->active = true;
+        this->timer.start ( *this, this->randomDelay () );
+    }
+}
+
+void beaconAnomalyGovernor::shutdown (
+    epicsGuard < epicsMutex > & cbGuard,
+    epicsGuard < epicsMutex > & guard )
+{
+    this->stopped = true;
+    {
+        epicsGuardRelease < epicsMutex > unguard ( guard );
+        {
+            epicsGuardRelease < epicsMutex > cbUnguard ( cbGuard );
+            this->timer.cancel ();
+        }
+    }
+    this->active = false;
+}
+
+double beaconAnomalyGovernor::randomDelay ()
+{
+    this->randomState = this->randomState * 1664525u + 1013904223u;
+    unsigned fraction = ( this->randomState >> 8u ) & 0xffffff;
+    return beaconAnomalyMaxDelay * fraction / 0x1000000;
+}
+
+epicsTimerNotify::expireStatus beaconAnomalyGovernor::expire (
+    const epicsTime & currentTime )
+{
+    epicsGuard < epicsMutex > guard ( this->mutex );
+
+    if ( this->stopped ) {
+        this->active = false;
+        return noRestart;
+    }
+
+    double bucketSize = this->rate * beaconAnomalyBurstPeriod;
+    if ( bucketSize < 1.0 ) {
+        bucketSize = 1.0;
+    }
+    this->tokens += this->rate * ( currentTime - this->lastRefill );
+    if ( this->tokens > bucketSize ) {
+        this->tokens = bucketSize;
+    }
+    this->lastRefill = currentTime;
+
+    unsigned nMax = this->backlog;
+    if ( this->tokens < nMax ) {
+        nMax = static_cast < unsigned > ( this->tokens );
+    }
+    unsigned nMoved = this->iiu.beaconAnomalyReschedule ( guard, nMax );
+    this->tokens -= nMoved;
+    this->nRescheduled += nMoved;
+
+    if ( nMoved < nMax ) {
+        // the slow search timers are empty
+        this->backlog = 0u;
+    }
+    else {
+        this->backlog -= nMoved;
+    }
+
+    if ( this->backlog > 0u ) {
+        return expireStatus ( restart, beaconAnomalyGovernorPeriod );
+    }
+    this->active = false;
+    return noRestart;
+}
+
+void beaconAnomalyGovernor::show ( unsigned level ) const
+{
+    epicsGuard < epicsMutex > guard ( this->mutex );
+    ::printf ( "beacon anomaly governor: %u anomalies, "
+        "%lu channels rescheduled, %u channels waiting\n",
+        this->nAnomalies, this->nRescheduled, this->backlog );
+    if ( level > 0u ) {
+        if ( this->rate > 0.0 ) {
+            ::printf ( "\trate limit %g channels per second, "
+                "%g tokens available\n", this->rate, this->tokens );
+        }
+        else {
+            ::printf ( "\trate limit disabled\n" );
+        }
+    }
+}
+
+beaconAnomalyGovernorNotify::~beaconAnomalyGovernorNotify () {}
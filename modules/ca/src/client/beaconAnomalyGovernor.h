@@ -0,0 +1,68 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+//
+//  Beacon anomaly governor
+//
+//  When a beacon anomaly is detected the channels waiting in the slow
+//  search timers are moved to the beacon anomaly search timer. Moving
+//  them all at once causes every client on the network to search for all
+//  of its unresolved channels at the same time, so they are instead moved
+//  after a random delay, at a limited rate (token bucket), and in order
+//  of increasing search period (most recently disconnected first).
+//
+
+#ifndef INC_beaconAnomalyGovernor_H
+#define INC_beaconAnomalyGovernor_H
+
+#include "epicsMutex.h"
+#include "epicsGuard.h"
+#include "epicsTimer.h"
+
+#include "libCaAPI.h"
+
+class beaconAnomalyGovernorNotify {
+public:
+    virtual ~beaconAnomalyGovernorNotify () = 0;
+    // number of channels that a beacon anomaly would reschedule
+    virtual unsigned beaconAnomalyBacklog (
+        epicsGuard < epicsMutex > & ) const = 0;
+    // reschedule up to nMax channels, returning the number rescheduled
+    virtual unsigned beaconAnomalyReschedule (
+        epicsGuard < epicsMutex > &, unsigned nMax ) = 0;
+};
+
+class beaconAnomalyGovernor : private epicsTimerNotify {
+public:
+    beaconAnomalyGovernor (
+        class beaconAnomalyGovernorNotify &, epicsTimerQueue &,
+        epicsMutex &, double rate );
+    virtual ~beaconAnomalyGovernor ();
+    void anomalyNotify ( epicsGuard < epicsMutex > & );
+    void shutdown (
+        epicsGuard < epicsMutex > & cbGuard,
+        epicsGuard < epicsMutex > & guard );
+    void show ( unsigned level ) const;
+private:
+    epicsTime lastRefill;
+    epicsMutex & mutex;
+    epicsTimer & timer;
+    class beaconAnomalyGovernorNotify & iiu;
+    const double rate; // channels per second, zero if unlimited
+    double tokens;
+    unsigned backlog;
+    unsigned nAnomalies;
+    unsigned long nRescheduled;
+    unsigned randomState;
+    bool active;
+    bool stopped;
+    double randomDelay ();
+    epicsTimerNotify::expireStatus expire ( const epicsTime & currentTime );
+    beaconAnomalyGovernor ( const beaconAnomalyGovernor & );
+    beaconAnomalyGovernor & operator = ( const beaconAnomalyGovernor & );
+};
+
+#endif // ifdef INC_beaconAnomalyGovernor_H
@@ -439,6 +439,8 @@ void cac::show (
         this->timerQueue.show ( level - 3u );
         ::printf ( "IP address to name conversion engine:\n" );
         this->ipToAEngine.show ( level - 3u );
+        ::printf ( "Communication buffer pool:\n" );
+        this->comBufMemMgr.show ( level - 3u );
     }
 
     if ( level > 3u ) {
@@ -1298,14 +1300,41 @@ void cac::initiateConnect (
     this->pudpiiu->installNewChannel ( guard, chan, piiu );
 }
 
+cacComBufMemoryManager::cacComBufMemoryManager () :
+    pool ( sizeof ( comBuf ) )
+{
+}
+
 void *cacComBufMemoryManager::allocate ( size_t size )
 {
-    return this->freeList.allocate ( size );
+    assert ( size <= sizeof ( comBuf ) );
+    void * pBuf = this->pool.allocate ();
+    if ( ! pBuf ) {
+        throw std::bad_alloc ();
+    }
+    return pBuf;
 }
 
 void cacComBufMemoryManager::release ( void * pCadaver )
 {
-    this->freeList.release ( pCadaver );
+    this->pool.release ( pCadaver );
+}
+
+void * cacComBufMemoryManager::allocateLarge (
+    size_t nBytes, size_t & capacity )
+{
+    return this->pool.allocate ( nBytes, capacity );
+}
+
+void cacComBufMemoryManager::releaseLarge (
+    void * pCadaver, size_t capacity )
+{
+    this->pool.release ( pCadaver, capacity );
+}
+
+void cacComBufMemoryManager::show ( unsigned level ) const
+{
+    this->pool.show ( level );
 }
 
 void cac::pvMultiplyDefinedNotify ( msgForMultiplyDefinedPV & mfmdpv,
@@ -34,6 +34,7 @@
 #include "libCaAPI.h"
 #include "nciu.h"
 #include "comBuf.h"
+#include "comBufPool.h"
 #include "bhe.h"
 #include "cacIO.h"
 #include "netIO.h"
@@ -68,11 +69,14 @@ struct caHdrLargeArray;
 class cacComBufMemoryManager : public comBufMemoryManager
 {
 public:
-    cacComBufMemoryManager () {}
+    cacComBufMemoryManager ();
     void * allocate ( size_t );
     void release ( void * );
+    void * allocateLarge ( size_t nBytes, size_t & capacity );
+    void releaseLarge ( void *, size_t capacity );
+    void show ( unsigned level ) const;
 private:
-    tsFreeList < comBuf, 0x20 > freeList;
+    comBufPool pool;
     cacComBufMemoryManager ( const cacComBufMemoryManager & );
     cacComBufMemoryManager & operator = ( const cacComBufMemoryManager & );
 };
@@ -348,6 +348,68 @@ LIBCA_API int epicsStdCall ca_array_put_callback
 #define ca_put_callback(type, chan, pValue, pFunc, pArg) \
     ca_array_put_callback(type, 1u, chan, pValue, pFunc, pArg)
 
+/*
+ * one write in a batch passed to ca_put_batch()
+ *
+ * type         R   data type from db_access.h
+ * count        R   array element count
+ * chan         R   channel identifier
+ * pValue       R   new channel value copied from this location
+ * status       W   ECA_XXX status of this write
+ */
+typedef struct ca_put_batch_item {
+    chtype          type;
+    unsigned long   count;
+    chid            chan;
+    const void *    pValue;
+    int             status;
+} ca_put_batch_item;
+
+/* arguments passed to ca_put_batch() completion handlers */
+struct put_batch_handler_args {
+    void                *usr;       /* user argument supplied with request */
+    ca_put_batch_item   *pItems;    /* the items passed to ca_put_batch() */
+    unsigned            nItems;     /* number of items in the batch */
+    unsigned            nFailed;    /* items whose status is not ECA_NORMAL */
+};
+typedef void caPutBatchCallBackFunc (struct put_batch_handler_args);
+
+/*
+ * ca_put_batch()
+ *
+ * Issues a put with completion notification, as with
+ * ca_array_put_callback(), for every item in the array. All of the
+ * requests are queued while the client library's lock is held once,
+ * and so they are framed back to back into the outgoing message buffers.
+ * Instead of a callback per write, a single call back to the user
+ * supplied function occurs after the last write in the batch completes
+ * in the IOC (or fails). The status of each write is stored into the
+ * status member of its item, and therefore the item array must not
+ * be modified or freed until the call back has occurred. As with
+ * other put requests the writes are not sent until ca_flush_io(),
+ * ca_pend_io(), or ca_pend_event() is called.
+ *
+ * All of the channels must belong to the same client context. If none
+ * of the writes can be queued then the status of the first item is
+ * returned and the call back will not occur.
+ *
+ * Clearing one of the channels while its write is pending cancels the
+ * batch: the call back will not occur and the item array is not used
+ * again once ca_clear_channel() returns.
+ *
+ * pItems       RW  array of writes to issue
+ * nItems       R   number of items in the array
+ * pFunc        R   pointer to call-back function
+ * pArg         R   copy of this pointer passed to pFunc
+ */
+LIBCA_API int epicsStdCall ca_put_batch
+(
+     ca_put_batch_item *        pItems,
+     unsigned                   nItems,
+     caPutBatchCallBackFunc *   pFunc,
+     void *                     pArg
+);
+
 /************************************************************************/
 /*  Read a value from a channel                                         */
 /************************************************************************/
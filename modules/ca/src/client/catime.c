@@ -352,6 +352,93 @@ unsigned    *pInlineIter
     *pInlineIter = 1;
 }
 
+/*
+ * put callback completion
+ */
+static unsigned putCallbacksPending;
+
+static void putCallbackComplete ( struct event_handler_args args )
+{
+    SEVCHK ( args.status, NULL );
+    putCallbacksPending--;
+}
+
+static void putBatchComplete ( struct put_batch_handler_args args )
+{
+    if ( args.nFailed ) {
+        printf ( "%u of %u batched writes failed\n",
+            args.nFailed, args.nItems );
+    }
+    putCallbacksPending--;
+}
+
+static void waitForPutCallbacks ( void )
+{
+    int status = ca_flush_io ();
+    SEVCHK (status, NULL);
+    while ( putCallbacksPending ) {
+        ca_pend_event ( 1e-3 );
+    }
+}
+
+/*
+ * test_put_callback ()
+ */
+static void test_put_callback (
+ti      *pItems,
+unsigned    iterations,
+unsigned    *pInlineIter
+)
+{
+    ti  *pi;
+    int status;
+
+    for (pi=pItems; pi<&pItems[iterations]; pi++) {
+        status = ca_array_put_callback(
+                pi->type,
+                pi->count,
+                pi->chix,
+                pi->pValue,
+                putCallbackComplete,
+                NULL);
+        SEVCHK (status, NULL);
+        putCallbacksPending++;
+    }
+    waitForPutCallbacks ();
+
+    *pInlineIter = 1;
+}
+
+/*
+ * test_put_batch ()
+ */
+static void test_put_batch (
+ti      *pItems,
+unsigned    iterations,
+unsigned    *pInlineIter
+)
+{
+    ca_put_batch_item *pBatch;
+    unsigned i;
+    int status;
+
+    pBatch = (ca_put_batch_item *) calloc ( iterations, sizeof ( *pBatch ) );
+    assert ( pBatch != NULL );
+    for (i=0; i<iterations; i++) {
+        pBatch[i].type = pItems[i].type;
+        pBatch[i].count = pItems[i].count;
+        pBatch[i].chan = pItems[i].chix;
+        pBatch[i].pValue = pItems[i].pValue;
+    }
+    status = ca_put_batch ( pBatch, iterations, putBatchComplete, NULL );
+    SEVCHK (status, NULL);
+    putCallbacksPending++;
+    waitForPutCallbacks ();
+    free ( pBatch );
+
+    *pInlineIter = 1;
+}
+
 /*
  * measure_get_latency
  */
@@ -504,6 +591,18 @@ static void test ( ti *pItems, unsigned iterations )
         nBytesSent * iterations,
         nBytesRecv * iterations );
 
+    printf ( "\t### put callback test ###\n");
+    nBytesSent = sizeof ( caHdr ) + CA_MESSAGE_ALIGN( payloadSize );
+    nBytesRecv = sizeof ( caHdr );
+    timeIt ( test_put_callback, pItems, iterations,
+        nBytesSent * iterations,
+        nBytesRecv * iterations );
+
+    printf ( "\t### put batch test ###\n");
+    timeIt ( test_put_batch, pItems, iterations,
+        nBytesSent * iterations,
+        nBytesRecv * iterations );
+
     printf ( "\t### async get test ###\n");
     nBytesSent = sizeof ( caHdr );
     nBytesRecv = sizeof ( caHdr ) + CA_MESSAGE_ALIGN ( payloadSize );
@@ -0,0 +1,240 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Size classed, thread sharded buffer cache for the CA client library.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "epicsAssert.h"
+#include "epicsAtomic.h"
+#include "epicsGuard.h"
+#include "epicsThread.h"
+
+#include "comBufPool.h"
+
+comBufPool::shard::shard ()
+{
+    for ( unsigned i = 0u; i < nClasses; i++ ) {
+        this->pFree[i] = 0;
+    }
+}
+
+comBufPool::comBufPool ( size_t fixedBlockSizeIn ) :
+    heldBytes ( 0u ), nOversizeAlloc ( 0u ), oversizeBytesOutstanding ( 0u ),
+    fixedBlockSize ( fixedBlockSizeIn < sizeof ( freeBlock ) ?
+        sizeof ( freeBlock ) : fixedBlockSizeIn )
+{
+    for ( unsigned i = 0u; i < nClasses; i++ ) {
+        statistics & st = this->stats[i];
+        st.nAlloc = 0u;
+        st.nHit = 0u;
+        st.nSteal = 0u;
+        st.nFree = 0u;
+        st.nHeld = 0u;
+        st.nOutstanding = 0u;
+    }
+}
+
+comBufPool::~comBufPool ()
+{
+    for ( unsigned i = 0u; i < nShards; i++ ) {
+        shard & sh = this->shards[i];
+        epicsGuard < epicsMutex > guard ( sh.mutex );
+        for ( unsigned j = 0u; j < nClasses; j++ ) {
+            while ( freeBlock * pBlock = sh.pFree[j] ) {
+                sh.pFree[j] = pBlock->pNext;
+                ::free ( pBlock );
+            }
+        }
+    }
+}
+
+size_t comBufPool::classCapacity ( unsigned sizeClass ) const
+{
+    if ( sizeClass == 0u ) {
+        return this->fixedBlockSize;
+    }
+    return minLargeBlockSize << ( sizeClass - 1u );
+}
+
+unsigned comBufPool::sizeClassOf ( size_t nBytes ) const
+{
+    for ( unsigned i = 1u; i < nClasses; i++ ) {
+        if ( nBytes <= this->classCapacity ( i ) ) {
+            return i;
+        }
+    }
+    return nClasses;
+}
+
+unsigned comBufPool::shardIndexSelf ()
+{
+    size_t id = reinterpret_cast < size_t > ( epicsThreadGetIdSelf () );
+    id ^= id >> 7u;
+    id ^= id >> 13u;
+    return static_cast < unsigned > ( id % nShards );
+}
+
+void * comBufPool::allocateFromClass ( unsigned sizeClass )
+{
+    statistics & st = this->stats[sizeClass];
+    epicsAtomicIncrSizeT ( & st.nAlloc );
+
+    unsigned self = shardIndexSelf ();
+    freeBlock * pBlock = 0;
+    {
+        shard & sh = this->shards[self];
+        epicsGuard < epicsMutex > guard ( sh.mutex );
+        pBlock = sh.pFree[sizeClass];
+        if ( pBlock ) {
+            sh.pFree[sizeClass] = pBlock->pNext;
+        }
+    }
+    if ( pBlock ) {
+        epicsAtomicIncrSizeT ( & st.nHit );
+    }
+    else {
+        // buffers are frequently released by a different thread than
+        // the one that allocated them so look in the other shards, but
+        // never wait for a shard that is busy
+        for ( unsigned i = 1u; i < nShards && ! pBlock; i++ ) {
+            shard & sh = this->shards[ ( self + i ) % nShards ];
+            if ( sh.mutex.tryLock () ) {
+                pBlock = sh.pFree[sizeClass];
+                if ( pBlock ) {
+                    sh.pFree[sizeClass] = pBlock->pNext;
+                }
+                sh.mutex.unlock ();
+            }
+        }
+        if ( pBlock ) {
+            epicsAtomicIncrSizeT ( & st.nSteal );
+        }
+    }
+
+    if ( pBlock ) {
+        epicsAtomicDecrSizeT ( & st.nHeld );
+        epicsAtomicSubSizeT ( & this->heldBytes,
+            this->classCapacity ( sizeClass ) );
+    }
+    else {
+        pBlock = static_cast < freeBlock * >
+            ( ::malloc ( this->classCapacity ( sizeClass ) ) );
+        if ( ! pBlock ) {
+            return 0;
+        }
+    }
+    epicsAtomicIncrSizeT ( & st.nOutstanding );
+    return pBlock;
+}
+
+void comBufPool::releaseToClass ( unsigned sizeClass, void * pCadaver )
+{
+    if ( ! pCadaver ) {
+        return;
+    }
+    statistics & st = this->stats[sizeClass];
+    epicsAtomicDecrSizeT ( & st.nOutstanding );
+
+    // limit on the number of bytes cached in all size classes
+    size_t capacity = this->classCapacity ( sizeClass );
+    if ( epicsAtomicAddSizeT ( & this->heldBytes, capacity ) > maxHeldBytes ) {
+        epicsAtomicSubSizeT ( & this->heldBytes, capacity );
+        epicsAtomicIncrSizeT ( & st.nFree );
+        ::free ( pCadaver );
+        return;
+    }
+
+    freeBlock * pBlock = static_cast < freeBlock * > ( pCadaver );
+    {
+        shard & sh = this->shards[shardIndexSelf ()];
+        epicsGuard < epicsMutex > guard ( sh.mutex );
+        pBlock->pNext = sh.pFree[sizeClass];
+        sh.pFree[sizeClass] = pBlock;
+    }
+    epicsAtomicIncrSizeT ( & st.nHeld );
+}
+
+void * comBufPool::allocate ( size_t nBytes, size_t & capacity )
+{
+    unsigned sizeClass = this->sizeClassOf ( nBytes );
+    if ( sizeClass < nClasses ) {
+        capacity = this->classCapacity ( sizeClass );
+        return this->allocateFromClass ( sizeClass );
+    }
+    // round size up to a whole number of pages
+    capacity = ( ( nBytes - 1u ) | ( pageSize - 1u ) ) + 1u;
+    void * pBuf = ::malloc ( capacity );
+    if ( pBuf ) {
+        epicsAtomicIncrSizeT ( & this->nOversizeAlloc );
+        epicsAtomicAddSizeT ( & this->oversizeBytesOutstanding, capacity );
+    }
+    return pBuf;
+}
+
+void comBufPool::release ( void * pCadaver, size_t capacity )
+{
+    unsigned sizeClass = this->sizeClassOf ( capacity );
+    if ( sizeClass < nClasses ) {
+        assert ( capacity == this->classCapacity ( sizeClass ) );
+        this->releaseToClass ( sizeClass, pCadaver );
+    }
+    else if ( pCadaver ) {
+        epicsAtomicSubSizeT ( & this->oversizeBytesOutstanding, capacity );
+        ::free ( pCadaver );
+    }
+}
+
+size_t comBufPool::bytesHeld () const
+{
+    return epicsAtomicGetSizeT ( & this->heldBytes );
+}
+
+size_t comBufPool::bytesOutstanding () const
+{
+    size_t total = epicsAtomicGetSizeT ( & this->oversizeBytesOutstanding );
+    for ( unsigned i = 0u; i < nClasses; i++ ) {
+        total += epicsAtomicGetSizeT ( & this->stats[i].nOutstanding ) *
+            this->classCapacity ( i );
+    }
+    return total;
+}
+
+void comBufPool::show ( unsigned level ) const
+{
+    ::printf ( "Buffer pool at %p, %u shards, %lu bytes held, %lu bytes in use\n",
+        static_cast < const void * > ( this ), nShards,
+        static_cast < unsigned long > ( this->bytesHeld () ),
+        static_cast < unsigned long > ( this->bytesOutstanding () ) );
+    if ( level > 0u ) {
+        for ( unsigned i = 0u; i < nClasses; i++ ) {
+            const statistics & st = this->stats[i];
+            size_t nAlloc = epicsAtomicGetSizeT ( & st.nAlloc );
+            if ( nAlloc == 0u ) {
+                continue;
+            }
+            size_t nHit = epicsAtomicGetSizeT ( & st.nHit );
+            size_t nSteal = epicsAtomicGetSizeT ( & st.nSteal );
+            ::printf ( "\tclass %8lu bytes: alloc=%lu hit=%lu steal=%lu "
+                "hit rate=%.1f%% freed=%lu held=%lu in use=%lu\n",
+                static_cast < unsigned long > ( this->classCapacity ( i ) ),
+                static_cast < unsigned long > ( nAlloc ),
+                static_cast < unsigned long > ( nHit ),
+                static_cast < unsigned long > ( nSteal ),
+                100.0 * ( nHit + nSteal ) / nAlloc,
+                static_cast < unsigned long > ( epicsAtomicGetSizeT ( & st.nFree ) ),
+                static_cast < unsigned long > ( epicsAtomicGetSizeT ( & st.nHeld ) ),
+                static_cast < unsigned long > ( epicsAtomicGetSizeT ( & st.nOutstanding ) ) );
+        }
+        ::printf ( "\toversize: alloc=%lu in use=%lu bytes\n",
+            static_cast < unsigned long > ( epicsAtomicGetSizeT ( & this->nOversizeAlloc ) ),
+            static_cast < unsigned long > (
+                epicsAtomicGetSizeT ( & this->oversizeBytesOutstanding ) ) );
+    }
+}
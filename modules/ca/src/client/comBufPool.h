@@ -0,0 +1,97 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Size classed, thread sharded buffer cache used by the CA client
+ *  library for comBuf and for large array message body buffers.
+ *
+ *  Each calling thread is hashed onto one of a small number of shards
+ *  so that the receive thread, the send thread, and the application's
+ *  callback threads rarely contend for the same lock. A buffer released
+ *  by one thread is cached in that thread's shard, and an allocation
+ *  that misses in its own shard attempts to steal (without blocking)
+ *  from the other shards before falling back to malloc.
+ */
+
+#ifndef INC_comBufPool_H
+#define INC_comBufPool_H
+
+#include <cstddef>
+
+#include "epicsMutex.h"
+#include "compilerDependencies.h"
+
+class comBufPool {
+public:
+    comBufPool ( size_t fixedBlockSize );
+    ~comBufPool ();
+    // fixed size blocks (ie comBuf)
+    void * allocate ();
+    void release ( void * );
+    // variable size blocks, capacity is rounded up to a size class,
+    // or to a whole number of pages above the largest class
+    void * allocate ( size_t nBytes, size_t & capacity );
+    void release ( void *, size_t capacity );
+    void show ( unsigned level ) const;
+    size_t bytesHeld () const;
+    size_t bytesOutstanding () const;
+private:
+    // class zero is the fixed size, the remainder are powers of two
+    // from minLargeBlockSize up to 1 MB, and anything larger than the
+    // last class is rounded up to a multiple of pageSize and passed
+    // directly to malloc / free so that it is never cached
+    enum { nShards = 8u };
+    enum { nLargeClasses = 6u };
+    enum { nClasses = nLargeClasses + 1u };
+    static const size_t minLargeBlockSize = 0x8000;
+    static const size_t pageSize = 0x1000;
+    // limit on the bytes cached in all classes together
+    static const size_t maxHeldBytes = 0x1000000;
+
+    struct freeBlock {
+        freeBlock * pNext;
+    };
+    struct shard {
+        mutable epicsMutex mutex;
+        freeBlock * pFree [ nClasses ];
+        shard ();
+    };
+    struct statistics {
+        size_t nAlloc;
+        size_t nHit;
+        size_t nSteal;
+        size_t nFree;
+        size_t nHeld;
+        size_t nOutstanding;
+    };
+
+    shard shards [ nShards ];
+    statistics stats [ nClasses ];
+    size_t heldBytes;
+    size_t nOversizeAlloc;
+    size_t oversizeBytesOutstanding;
+    const size_t fixedBlockSize;
+
+    size_t classCapacity ( unsigned sizeClass ) const;
+    unsigned sizeClassOf ( size_t nBytes ) const;
+    void * allocateFromClass ( unsigned sizeClass );
+    void releaseToClass ( unsigned sizeClass, void * );
+    static unsigned shardIndexSelf ();
+    comBufPool ( const comBufPool & );
+    comBufPool & operator = ( const comBufPool & );
+};
+
+inline void * comBufPool::allocate ()
+{
+    return this->allocateFromClass ( 0u );
+}
+
+inline void comBufPool::release ( void * pBlock )
+{
+    this->releaseToClass ( 0u, pBlock );
+}
+
+#endif // ifndef INC_comBufPool_H
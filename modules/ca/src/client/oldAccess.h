@@ -250,6 +250,50 @@ private:
     void operator delete ( void * );
 };
 
+class putBatch;
+
+class putBatchNotify : public cacWriteNotify {
+public:
+    putBatchNotify ();
+    void install ( putBatch &, unsigned index );
+private:
+    putBatch * pBatch;
+    unsigned index;
+    void completion ( epicsGuard < epicsMutex > & );
+    void exception (
+        epicsGuard < epicsMutex > &, int status, const char *pContext,
+        unsigned type, arrayElementCount count );
+    putBatchNotify ( const putBatchNotify & );
+    putBatchNotify & operator = ( const putBatchNotify & );
+};
+
+// A single completion object shared by all of the writes issued by
+// ca_put_batch(). It destroys itself when the last write completes.
+// If one of the channels is cleared while its write is pending the
+// batch is cancelled, and the user isn't called back.
+class putBatch {
+public:
+    putBatch (
+        ca_put_batch_item * pItems, unsigned nItems,
+        caPutBatchCallBackFunc * pFunc, void * pPrivate );
+    ~putBatch ();
+    int issue ( epicsGuard < epicsMutex > & );
+    void itemComplete (
+        epicsGuard < epicsMutex > &, unsigned index, int status );
+private:
+    putBatchNotify * pNotify;
+    ca_put_batch_item * pItems;
+    caPutBatchCallBackFunc * pFunc;
+    void * pPrivate;
+    unsigned nItems;
+    unsigned nPending;
+    unsigned nFailed;
+    bool cancelled;
+    void release ( epicsGuard < epicsMutex > & );
+    putBatch ( const putBatch & );
+    putBatch & operator = ( const putBatch & );
+};
+
 struct oldSubscription : private cacStateNotify {
 public:
     oldSubscription (
@@ -0,0 +1,232 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ *  Batched put with completion notification (ca_put_batch)
+ */
+
+#include <string>
+#include <stdexcept>
+
+#include "iocinf.h"
+#include "oldAccess.h"
+
+putBatchNotify::putBatchNotify () :
+    pBatch ( 0 ), index ( 0u )
+{
+}
+
+void putBatchNotify::install ( putBatch & batch, unsigned indexIn )
+{
+    this->pBatch = & batch;
+    this->index = indexIn;
+}
+
+void putBatchNotify::completion ( epicsGuard < epicsMutex > & guard )
+{
+    this->pBatch->itemComplete ( guard, this->index, ECA_NORMAL );
+}
+
+void putBatchNotify::exception (
+    epicsGuard < epicsMutex > & guard,
+    int status, const char * /* pContext */,
+    unsigned /* type */, arrayElementCount /* count */ )
+{
+    this->pBatch->itemComplete ( guard, this->index, status );
+}
+
+putBatch::putBatch (
+    ca_put_batch_item * pItemsIn, unsigned nItemsIn,
+    caPutBatchCallBackFunc * pFuncIn, void * pPrivateIn ) :
+    pNotify ( new putBatchNotify [ nItemsIn ] ),
+    pItems ( pItemsIn ), pFunc ( pFuncIn ), pPrivate ( pPrivateIn ),
+    nItems ( nItemsIn ), nPending ( 0u ), nFailed ( 0u ),
+    cancelled ( false )
+{
+    for ( unsigned i = 0u; i < nItemsIn; i++ ) {
+        this->pNotify[i].install ( *this, i );
+    }
+}
+
+putBatch::~putBatch ()
+{
+    delete [] this->pNotify;
+}
+
+int putBatch::issue ( epicsGuard < epicsMutex > & guard )
+{
+    ca_client_context & cac = this->pItems[0].chan->getClientCtx ();
+
+    // This may temporarily release the lock, so it is done for every
+    // channel before any of the writes are installed. Thereafter the
+    // network client holds the lock continuously while the writes are
+    // queued.
+    for ( unsigned i = 0u; i < this->nItems; i++ ) {
+        chid pChan = this->pItems[i].chan;
+        if ( pChan && & pChan->getClientCtx () == & cac ) {
+            pChan->eliminateExcessiveSendBacklog ( guard );
+        }
+    }
+
+    // The in-memory service releases the lock while it writes, and may
+    // complete the write before returning, so the batch holds a count
+    // of its own until every write has been issued.
+    unsigned nQueued = 0u;
+    this->nPending = 1u;
+    for ( unsigned i = 0u; i < this->nItems; i++ ) {
+        ca_put_batch_item & item = this->pItems[i];
+        int caStatus;
+        item.status = ECA_NORMAL;
+        if ( ! item.chan || & item.chan->getClientCtx () != & cac ) {
+            caStatus = ECA_BADCHID;
+        }
+        else if ( item.type < 0 ) {
+            caStatus = ECA_BADTYPE;
+        }
+        else {
+            this->nPending++;
+            try {
+                item.chan->write ( guard,
+                    static_cast < unsigned > ( item.type ), item.count,
+                    item.pValue, this->pNotify[i] );
+                caStatus = ECA_NORMAL;
+            }
+            catch ( cacChannel::badString & )
+            {
+                caStatus = ECA_BADSTR;
+            }
+            catch ( cacChannel::badType & )
+            {
+                caStatus = ECA_BADTYPE;
+            }
+            catch ( cacChannel::outOfBounds & )
+            {
+                caStatus = ECA_BADCOUNT;
+            }
+            catch ( cacChannel::noWriteAccess & )
+            {
+                caStatus = ECA_NOWTACCESS;
+            }
+            catch ( cacChannel::notConnected & )
+            {
+                caStatus = ECA_DISCONN;
+            }
+            catch ( cacChannel::unsupportedByService & )
+            {
+                caStatus = ECA_UNAVAILINSERV;
+            }
+            catch ( cacChannel::requestTimedOut & )
+            {
+                caStatus = ECA_TIMEOUT;
+            }
+            catch ( std::bad_alloc & )
+            {
+                caStatus = ECA_ALLOCMEM;
+            }
+            catch ( ... )
+            {
+                caStatus = ECA_PUTFAIL;
+            }
+            if ( caStatus != ECA_NORMAL ) {
+                this->nPending--;
+            }
+        }
+        if ( caStatus == ECA_NORMAL ) {
+            nQueued++;
+        }
+        else {
+            item.status = caStatus;
+            this->nFailed++;
+        }
+    }
+
+    if ( nQueued == 0u ) {
+        return this->pItems[0].status;
+    }
+    // this may call the user back, and destroy the batch
+    this->release ( guard );
+    return ECA_NORMAL;
+}
+
+void putBatch::itemComplete (
+    epicsGuard < epicsMutex > & guard, unsigned index, int status )
+{
+    if ( status == ECA_CHANDESTROY ) {
+        // As with ca_array_put_callback(), clearing the channel cancels
+        // the callback. The item array may be gone once
+        // ca_clear_channel() returns, so it isn't touched again.
+        this->cancelled = true;
+    }
+    else if ( status != ECA_NORMAL && ! this->cancelled ) {
+        this->pItems[index].status = status;
+    }
+    if ( status != ECA_NORMAL ) {
+        this->nFailed++;
+    }
+    this->release ( guard );
+}
+
+void putBatch::release ( epicsGuard < epicsMutex > & guard )
+{
+    assert ( this->nPending > 0u );
+    if ( --this->nPending == 0u ) {
+        if ( this->cancelled ) {
+            delete this;
+            return;
+        }
+        struct put_batch_handler_args args;
+        args.usr = this->pPrivate;
+        args.pItems = this->pItems;
+        args.nItems = this->nItems;
+        args.nFailed = this->nFailed;
+        caPutBatchCallBackFunc * pFuncTmp = this->pFunc;
+        // destroy prior to releasing the lock and calling the
+        // call back in case they destroy channels there
+        delete this;
+        {
+            epicsGuardRelease < epicsMutex > unguard ( guard );
+            ( *pFuncTmp ) ( args );
+        }
+    }
+}
+
+/*
+ *  ca_put_batch ()
+ */
+int epicsStdCall ca_put_batch ( ca_put_batch_item * pItems, unsigned nItems,
+    caPutBatchCallBackFunc * pFunc, void * pArg )
+{
+    if ( pFunc == NULL ) {
+        return ECA_BADFUNCPTR;
+    }
+    if ( pItems == NULL || nItems == 0u ) {
+        return ECA_BADCOUNT;
+    }
+    if ( pItems[0].chan == NULL ) {
+        return ECA_BADCHID;
+    }
+
+    int caStatus;
+    try {
+        epicsGuard < epicsMutex > guard (
+            pItems[0].chan->getClientCtx().mutexRef () );
+        putBatch * pBatch = new putBatch ( pItems, nItems, pFunc, pArg );
+        caStatus = pBatch->issue ( guard );
+        if ( caStatus != ECA_NORMAL ) {
+            // nothing was queued so there will not be a call back
+            delete pBatch;
+        }
+    }
+    catch ( std::bad_alloc & )
+    {
+        caStatus = ECA_ALLOCMEM;
+    }
+    catch ( ... )
+    {
+        caStatus = ECA_PUTFAIL;
+    }
+    return caStatus;
+}
@@ -55,6 +55,20 @@
  * the validity of all existing connections only when a new client
  * registers with the repeater (and not when fanning out each beacon
  * received).                                           -- Jeff
+ *
+ * The clients are now also verified periodically (see verifyClientsPeriod)
+ * so that, when there are no new registrations, clients that went away
+ * without an ICMP error getting through are not fanned out to indefinitely.
+ */
+
+/* Batched System Calls
+ *
+ * Where the IP kernel provides recvmmsg() and sendmmsg() the repeater
+ * receives up to repeaterClient::maxBatchSize datagrams with one system
+ * call, and then sends all of them to each client with one system call.
+ * During a beacon storm (for example when many IOCs reboot together) this
+ * reduces the number of system calls by about the batch size. Otherwise
+ * one datagram at a time is received, and sent to each client.
  */
 
 #include <string>
@@ -65,6 +79,7 @@
 
 #include "tsDLList.h"
 #include "envDefs.h"
+#include "epicsTime.h"
 #include "tsFreeList.h"
 #include "osiWireFormat.h"
 #include "taskwd.h"
@@ -76,6 +91,9 @@
 #include "repeaterClient.h"
 #include "addrList.h"
 
+#if defined ( MSG_WAITFORONE )
+#   define REPEATER_BATCH_SYSCALLS
+#endif
 
 /*
  *  these can be external since there is only one instance
@@ -85,6 +103,22 @@ static tsDLList < repeaterClient > client_list;
 
 static const unsigned short PORT_ANY = 0u;
 
+/*
+ * maximum delay, in seconds, between verifications that the clients still exist
+ */
+static const double verifyClientsPeriod = 30.0;
+
+/*
+ * datagrams received by one call to receiveMessages()
+ */
+struct repeaterRecvBatch {
+    // rounded up so that each message header is aligned
+    enum { bufSize = ( MAX_UDP_RECV + 7u ) & ~7u };
+    char * pBuf [ repeaterClient::maxBatchSize ];
+    osiSockAddr from [ repeaterClient::maxBatchSize ];
+    unsigned size [ repeaterClient::maxBatchSize ];
+};
+
 /*
  * makeSocket()
  */
@@ -216,6 +250,60 @@ bool repeaterClient::sendMessage ( const void *pBuf, unsigned bufSize )
     }
 }
 
+bool repeaterClient::sendMessages (
+    const repeaterMessage * pMsgs, unsigned nMsgs )
+{
+#if defined ( REPEATER_BATCH_SYSCALLS )
+    struct mmsghdr msgs [ maxBatchSize ];
+    struct iovec iov [ maxBatchSize ];
+    unsigned nSend = 0u;
+
+    assert ( nMsgs <= maxBatchSize );
+    for ( unsigned i = 0u; i < nMsgs; i++ ) {
+        /* Don't reflect back to sender */
+        if ( this->identicalAddress ( *pMsgs[i].pFrom ) ) {
+            continue;
+        }
+        iov[nSend].iov_base = const_cast < void * > ( pMsgs[i].pBuf );
+        iov[nSend].iov_len = pMsgs[i].size;
+        memset ( & msgs[nSend], 0, sizeof ( msgs[nSend] ) );
+        msgs[nSend].msg_hdr.msg_iov = & iov[nSend];
+        msgs[nSend].msg_hdr.msg_iovlen = 1u;
+        nSend++;
+    }
+    if ( nSend == 0u ) {
+        return true;
+    }
+
+    int status = sendmmsg ( this->sock, msgs, nSend, 0 );
+    if ( status >= 0 ) {
+        // The error code is discarded when only some of the messages
+        // are sent, so the caller must verify that the client exists.
+        return static_cast < unsigned > ( status ) == nSend;
+    }
+    else {
+        int errnoCpy = SOCKERRNO;
+        if ( errnoCpy != SOCK_ECONNREFUSED ) {
+            char sockErrBuf[64];
+            epicsSocketConvertErrnoToString ( sockErrBuf, sizeof ( sockErrBuf ) );
+            debugPrintf ( ( "CA Repeater: UDP send err was \"%s\"\n", sockErrBuf) );
+        }
+        return false;
+    }
+#else
+    for ( unsigned i = 0u; i < nMsgs; i++ ) {
+        /* Don't reflect back to sender */
+        if ( this->identicalAddress ( *pMsgs[i].pFrom ) ) {
+            continue;
+        }
+        if ( ! this->sendMessage ( pMsgs[i].pBuf, pMsgs[i].size ) ) {
+            return false;
+        }
+    }
+    return true;
+#endif
+}
+
 repeaterClient::~repeaterClient ()
 {
     if ( this->sock != INVALID_SOCKET ) {
@@ -327,20 +415,19 @@ static void verifyClients ( tsFreeList < repeaterClient, 0x20 > & freeList )
 /*
  * fanOut()
  */
-static void fanOut ( const osiSockAddr & from, const void * pMsg,
-    unsigned msgSize, tsFreeList < repeaterClient, 0x20 > & freeList )
+static void fanOut ( const repeaterMessage * pMsgs, unsigned nMsgs,
+    tsFreeList < repeaterClient, 0x20 > & freeList )
 {
     static tsDLList < repeaterClient > theClients;
     repeaterClient *pclient;
 
+    if ( nMsgs == 0u ) {
+        return;
+    }
+
     while ( ( pclient = client_list.get () ) ) {
         theClients.add ( *pclient );
-        /* Don't reflect back to sender */
-        if ( pclient->identicalAddress ( from ) ) {
-            continue;
-        }
-
-        if ( ! pclient->sendMessage ( pMsg, msgSize ) ) {
+        if ( ! pclient->sendMessages ( pMsgs, nMsgs ) ) {
             if ( ! pclient->verify () ) {
                 theClients.remove ( *pclient );
                 pclient->~repeaterClient ();
@@ -352,6 +439,74 @@ static void fanOut ( const osiSockAddr & from, const void * pMsg,
     client_list.add ( theClients );
 }
 
+static void fanOut ( const osiSockAddr & from, const void * pMsg,
+    unsigned msgSize, tsFreeList < repeaterClient, 0x20 > & freeList )
+{
+    repeaterMessage msg;
+    msg.pBuf = pMsg;
+    msg.pFrom = & from;
+    msg.size = msgSize;
+    fanOut ( & msg, 1u, freeList );
+}
+
+/*
+ * receiveMessages()
+ *
+ * blocks until at least one datagram is available, and returns the
+ * number of datagrams received (zero if there was an error)
+ */
+static unsigned receiveMessages ( SOCKET sock, repeaterRecvBatch & batch )
+{
+    int status;
+
+#if defined ( REPEATER_BATCH_SYSCALLS )
+    struct mmsghdr msgs [ repeaterClient::maxBatchSize ];
+    struct iovec iov [ repeaterClient::maxBatchSize ];
+
+    for ( unsigned i = 0u; i < repeaterClient::maxBatchSize; i++ ) {
+        iov[i].iov_base = batch.pBuf[i];
+        iov[i].iov_len = MAX_UDP_RECV;
+        memset ( & msgs[i], 0, sizeof ( msgs[i] ) );
+        msgs[i].msg_hdr.msg_name = & batch.from[i].sa;
+        msgs[i].msg_hdr.msg_namelen = sizeof ( batch.from[i] );
+        msgs[i].msg_hdr.msg_iov = & iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1u;
+    }
+    /*
+     * MSG_WAITFORONE: block for the first datagram only, and then
+     * return whatever else is already queued
+     */
+    status = recvmmsg ( sock, msgs, repeaterClient::maxBatchSize,
+                    MSG_WAITFORONE, 0 );
+    if ( status > 0 ) {
+        for ( int i = 0; i < status; i++ ) {
+            batch.size[i] = msgs[i].msg_len;
+        }
+        return static_cast < unsigned > ( status );
+    }
+#else
+    osiSocklen_t from_size = sizeof ( batch.from[0] );
+    status = recvfrom ( sock, batch.pBuf[0], MAX_UDP_RECV, 0,
+                &batch.from[0].sa, &from_size );
+    if ( status >= 0 ) {
+        batch.size[0] = static_cast < unsigned > ( status );
+        return 1u;
+    }
+#endif
+
+    int errnoCpy = SOCKERRNO;
+    // Avoid spurious ECONNREFUSED bug in linux
+    // Avoid ECONNRESET from connected socket in windows
+    if ( errnoCpy != SOCK_ECONNREFUSED && errnoCpy != SOCK_ECONNRESET ) {
+        char sockErrBuf[64];
+        epicsSocketConvertErrnoToString (
+            sockErrBuf, sizeof ( sockErrBuf ) );
+        fprintf ( stderr, "CA Repeater: unexpected UDP recv err: %s\n",
+            sockErrBuf );
+    }
+    return 0u;
+}
+
 /*
  * register_new_client()
  */
@@ -483,13 +638,16 @@ static void register_new_client ( osiSockAddr & from,
 void ca_repeater ()
 {
     tsFreeList < repeaterClient, 0x20 > freeList;
-    int size;
+    repeaterRecvBatch batch;
+    repeaterMessage msgs [ repeaterClient::maxBatchSize ];
     SOCKET sock;
-    osiSockAddr from;
     unsigned short port;
     char * pBuf;
 
-    pBuf = new char [MAX_UDP_RECV];
+    pBuf = new char [ repeaterRecvBatch::bufSize * repeaterClient::maxBatchSize ];
+    for ( unsigned i = 0u; i < repeaterClient::maxBatchSize; i++ ) {
+        batch.pBuf[i] = pBuf + i * repeaterRecvBatch::bufSize;
+    }
 
     {
         bool success = osiSockAttach();
@@ -570,59 +728,68 @@ void ca_repeater ()
 
     debugPrintf ( ( "CA Repeater: Attached and initialized\n" ) );
 
+    epicsTime lastVerify = epicsTime::getCurrent ();
+
     while ( true ) {
-        osiSocklen_t from_size = sizeof ( from );
-        size = recvfrom ( sock, pBuf, MAX_UDP_RECV, 0,
-                    &from.sa, &from_size );
-        if ( size < 0 ) {
-            int errnoCpy = SOCKERRNO;
-            // Avoid spurious ECONNREFUSED bug in linux
-            if ( errnoCpy == SOCK_ECONNREFUSED ) {
-                continue;
+        unsigned nRecv = receiveMessages ( sock, batch );
+        unsigned nMsgs = 0u;
+
+        for ( unsigned i = 0u; i < nRecv; i++ ) {
+            osiSockAddr & from = batch.from[i];
+            unsigned size = batch.size[i];
+            caHdr * pMsg = ( caHdr * ) batch.pBuf[i];
+
+            /*
+             * both zero length message and a registration message
+             * will register a new client
+             */
+            if ( size >= sizeof (*pMsg) ) {
+                if ( AlignedWireRef < epicsUInt16 > ( pMsg->m_cmmd ) == REPEATER_REGISTER ) {
+                    /*
+                     * datagrams received before the registration are
+                     * not sent to the new client
+                     */
+                    fanOut ( msgs, nMsgs, freeList );
+                    nMsgs = 0u;
+                    register_new_client ( from, freeList );
+
+                    /*
+                     * strip register client message
+                     */
+                    pMsg++;
+                    size -= sizeof ( *pMsg );
+                    if ( size==0 ) {
+                        continue;
+                    }
+                }
+                else if ( AlignedWireRef < epicsUInt16 > ( pMsg->m_cmmd ) == CA_PROTO_RSRV_IS_UP ) {
+                    if ( pMsg->m_available == 0u ) {
+                        pMsg->m_available = from.ia.sin_addr.s_addr;
+                    }
+                }
             }
-            // Avoid ECONNRESET from connected socket in windows
-            if ( errnoCpy == SOCK_ECONNRESET ) {
+            else if ( size == 0 ) {
+                fanOut ( msgs, nMsgs, freeList );
+                nMsgs = 0u;
+                register_new_client ( from, freeList );
                 continue;
             }
-            char sockErrBuf[64];
-            epicsSocketConvertErrnoToString (
-                sockErrBuf, sizeof ( sockErrBuf ) );
-            fprintf ( stderr, "CA Repeater: unexpected UDP recv err: %s\n",
-                sockErrBuf );
-            continue;
-        }
 
-        caHdr * pMsg = ( caHdr * ) pBuf;
+            msgs[nMsgs].pBuf = pMsg;
+            msgs[nMsgs].pFrom = & from;
+            msgs[nMsgs].size = size;
+            nMsgs++;
+        }
 
-        /*
-         * both zero length message and a registration message
-         * will register a new client
-         */
-        if ( ( (size_t) size) >= sizeof (*pMsg) ) {
-            if ( AlignedWireRef < epicsUInt16 > ( pMsg->m_cmmd ) == REPEATER_REGISTER ) {
-                register_new_client ( from, freeList );
+        fanOut ( msgs, nMsgs, freeList );
 
-                /*
-                 * strip register client message
-                 */
-                pMsg++;
-                size -= sizeof ( *pMsg );
-                if ( size==0 ) {
-                    continue;
-                }
-            }
-            else if ( AlignedWireRef < epicsUInt16 > ( pMsg->m_cmmd ) == CA_PROTO_RSRV_IS_UP ) {
-                if ( pMsg->m_available == 0u ) {
-                    pMsg->m_available = from.ia.sin_addr.s_addr;
-                }
+        if ( client_list.count () > 0u ) {
+            epicsTime current = epicsTime::getCurrent ();
+            if ( current - lastVerify >= verifyClientsPeriod ) {
+                verifyClients ( freeList );
+                lastVerify = current;
             }
         }
-        else if ( size == 0 ) {
-            register_new_client ( from, freeList );
-            continue;
-        }
-
-        fanOut ( from, pMsg, size, freeList );
     }
 }
 
@@ -34,17 +34,30 @@
 
 union osiSockAddr;
 
+/*
+ * a datagram waiting to be fanned out to the clients
+ */
+struct repeaterMessage {
+    const void * pBuf;
+    const osiSockAddr * pFrom;
+    unsigned size;
+};
+
 /*
  * one socket per client so we will get the ECONNREFUSED
  * error code (and then delete the client)
  */
 class repeaterClient : public tsDLNode < repeaterClient > {
 public:
+    // maximum number of datagrams received, and then sent
+    // to each client, with one system call
+    enum { maxBatchSize = 16u };
     repeaterClient ( const osiSockAddr & from );
     ~repeaterClient ();
     bool connect ();
     bool sendConfirm ();
     bool sendMessage ( const void *pBuf, unsigned bufSize );
+    bool sendMessages ( const repeaterMessage * pMsgs, unsigned nMsgs );
     bool verify ();
     bool identicalAddress ( const osiSockAddr &from );
     bool identicalPort ( const osiSockAddr &from );
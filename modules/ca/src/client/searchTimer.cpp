@@ -104,18 +104,39 @@ void searchTimer::installChannel (
     chan.channelNode::setReqPendingState ( guard, this->index );
 }
 
-void searchTimer::moveChannels (
-    epicsGuard < epicsMutex > & guard, searchTimer & dest )
+unsigned searchTimer::moveChannels (
+    epicsGuard < epicsMutex > & guard, searchTimer & dest,
+    unsigned nMax )
 {
-    while ( nciu * pChan = this->chanListRespPending.get () ) {
+    unsigned nMoved = 0u;
+    while ( nMoved < nMax ) {
+        nciu * pChan = this->chanListRespPending.get ();
+        if ( ! pChan ) {
+            break;
+        }
         if ( this->searchAttempts > 0 ) {
             this->searchAttempts--;
         }
         dest.installChannel ( guard, *pChan );
+        nMoved++;
     }
-    while ( nciu * pChan = this->chanListReqPending.get () ) {
+    while ( nMoved < nMax ) {
+        nciu * pChan = this->chanListReqPending.get ();
+        if ( ! pChan ) {
+            break;
+        }
         dest.installChannel ( guard, *pChan );
+        nMoved++;
     }
+    return nMoved;
+}
+
+unsigned searchTimer::channelCount (
+    epicsGuard < epicsMutex > & guard ) const
+{
+    guard.assertIdenticalMutex ( this->mutex );
+    return this->chanListReqPending.count () +
+        this->chanListRespPending.count ();
 }
 
 //
@@ -61,8 +61,11 @@ public:
     void shutdown (
         epicsGuard < epicsMutex > & cbGuard,
         epicsGuard < epicsMutex > & guard );
-    void moveChannels (
-        epicsGuard < epicsMutex > &, searchTimer & dest );
+    unsigned moveChannels (
+        epicsGuard < epicsMutex > &, searchTimer & dest,
+        unsigned nMax );
+    unsigned channelCount (
+        epicsGuard < epicsMutex > & ) const;
     void installChannel (
         epicsGuard < epicsMutex > &, nciu & );
     void uninstallChan (
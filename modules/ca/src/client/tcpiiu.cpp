@@ -1036,7 +1036,8 @@ tcpiiu :: ~tcpiiu ()
             freeListFree(this->cacRef.tcpLargeRecvBufFreeList, this->pCurData);
         }
         else {
-            free ( this->pCurData );
+            this->cacRef.comBufMemMgr.releaseLarge (
+                this->pCurData, this->curDataMax );
         }
     }
 }
@@ -1212,17 +1213,11 @@ bool tcpiiu::processIncoming (
             arrayElementCount newsize;
 
             if ( !this->cacRef.tcpLargeRecvBufFreeList ) {
-                // round size up to multiple of 4K
-                newsize = ((this->curMsg.m_postsize-1)|0xfff)+1;
-
-                if ( this->curDataMax <= MAX_TCP ) {
-                    // small -> large
-                    newbuf = (char*)malloc(newsize);
-
-                } else {
-                    // expand large to larger
-                    newbuf = (char*)realloc(this->pCurData, newsize);
-                }
+                // size classed buffers are recycled between circuits
+                size_t capacity = 0u;
+                newbuf = (char*) this->cacRef.comBufMemMgr.allocateLarge (
+                    this->curMsg.m_postsize, capacity );
+                newsize = capacity;
 
             } else if ( this->curMsg.m_postsize <= this->cacRef.maxRecvBytesTCP ) {
                 newbuf = (char*) freeListMalloc(this->cacRef.tcpLargeRecvBufFreeList);
@@ -1238,7 +1233,8 @@ bool tcpiiu::processIncoming (
                     freeListFree(this->cacRef.tcpLargeRecvBufFreeList, this->pCurData );
 
                 } else {
-                    // called realloc()
+                    this->cacRef.comBufMemMgr.releaseLarge (
+                        this->pCurData, this->curDataMax );
                 }
                 this->pCurData = newbuf;
                 this->curDataMax = newsize;
@@ -93,6 +93,28 @@ double getMaxPeriod()
     return maxPeriod;
 }
 
+static
+double getAnomalySearchRate()
+{
+    double rate = 0.0;
+
+    if ( envGetConfigParamPtr ( & EPICS_CA_ANOMALY_SEARCH_RATE ) ) {
+        long longStatus = envGetDoubleConfigParam (
+            & EPICS_CA_ANOMALY_SEARCH_RATE, & rate );
+        if ( longStatus ) {
+            rate = 0.0;
+            epicsPrintf ( "EPICS \"%s\" wasnt a real number\n",
+                            EPICS_CA_ANOMALY_SEARCH_RATE.name );
+            epicsPrintf ( "Beacon anomaly search rate limit disabled\n" );
+        }
+        else if ( rate < 0.0 ) {
+            rate = 0.0;
+        }
+    }
+
+    return rate;
+}
+
 static
 unsigned getNTimers(double maxPeriod)
 {
@@ -131,6 +153,7 @@ udpiiu::udpiiu (
     repeaterSubscribeTmr (
         m_repeaterTimerNotify, timerQueue, cbMutexIn, ctxNotifyIn ),
     govTmr ( *this, timerQueue, cacMutexIn ),
+    anomalyGov ( *this, timerQueue, cacMutexIn, getAnomalySearchRate () ),
     maxPeriod ( getMaxPeriod() ),
     rtteMean ( minRoundTripEstimate ),
     rtteMeanDev ( 0 ),
@@ -139,6 +162,11 @@ udpiiu::udpiiu (
     cacMutex ( cacMutexIn ),
     nTimers ( getNTimers(maxPeriod) ),
     ppSearchTmr ( nTimers ),
+    searchRateIntervalBegin ( epicsTime::getCurrent () ),
+    searchFrameRate ( 0.0 ),
+    searchFrameRatePeak ( 0.0 ),
+    nSearchFrames ( 0u ),
+    nSearchFramesThisInterval ( 0u ),
     nBytesInXmitBuf ( 0 ),
     beaconAnomalyTimerIndex ( 0 ),
     sequenceNumber ( 0 ),
@@ -337,6 +365,7 @@ void udpiiu::shutdown (
     // stop all of the timers
     this->repeaterSubscribeTmr.shutdown ( cbGuard, guard );
     this->govTmr.shutdown ( cbGuard, guard );
+    this->anomalyGov.shutdown ( cbGuard, guard );
     for ( unsigned i =0; i < this->nTimers; i++ ) {
         this->ppSearchTmr[i]->shutdown ( cbGuard, guard );
     }
@@ -1135,6 +1164,18 @@ bool udpiiu :: datagramFlush (
 
     this->pushVersionMsg ();
 
+    this->nSearchFrames++;
+    this->nSearchFramesThisInterval++;
+    double delay = currentTime - this->searchRateIntervalBegin;
+    if ( delay >= searchRateInterval ) {
+        this->searchFrameRate = this->nSearchFramesThisInterval / delay;
+        if ( this->searchFrameRate > this->searchFrameRatePeak ) {
+            this->searchFrameRatePeak = this->searchFrameRate;
+        }
+        this->nSearchFramesThisInterval = 0u;
+        this->searchRateIntervalBegin = currentTime;
+    }
+
     return true;
 }
 
@@ -1143,6 +1184,10 @@ void udpiiu :: show ( unsigned level ) const
     epicsGuard < epicsMutex > guard ( this->cacMutex );
 
     ::printf ( "Datagram IO circuit (and disconnected channel repository)\n");
+    ::printf ( "\t%lu search frames sent, %g frames per second "
+        "(peak %g)\n", this->nSearchFrames,
+        this->searchFrameRate, this->searchFrameRatePeak );
+    this->anomalyGov.show ( level );
     if ( level > 1u ) {
         ::printf ("\trepeater port %u\n", this->repeaterPort );
         ::printf ("\tdefault server port %u\n", this->serverPort );
@@ -1198,11 +1243,33 @@ bool udpiiu::wakeupMsg ()
 void udpiiu::beaconAnomalyNotify (
     epicsGuard < epicsMutex > & cacGuard )
 {
+    this->anomalyGov.anomalyNotify ( cacGuard );
+}
+
+unsigned udpiiu::beaconAnomalyBacklog (
+    epicsGuard < epicsMutex > & cacGuard ) const
+{
+    unsigned nChan = 0u;
     for ( unsigned i = this->beaconAnomalyTimerIndex+1u;
             i < this->nTimers; i++ ) {
-        this->ppSearchTmr[i]->moveChannels ( cacGuard,
-            *this->ppSearchTmr[this->beaconAnomalyTimerIndex] );
+        nChan += this->ppSearchTmr[i]->channelCount ( cacGuard );
+    }
+    return nChan;
+}
+
+// channels in the faster search timers were disconnected, or
+// created, more recently and so are rescheduled first
+unsigned udpiiu::beaconAnomalyReschedule (
+    epicsGuard < epicsMutex > & cacGuard, unsigned nMax )
+{
+    unsigned nMoved = 0u;
+    for ( unsigned i = this->beaconAnomalyTimerIndex+1u;
+            i < this->nTimers && nMoved < nMax; i++ ) {
+        nMoved += this->ppSearchTmr[i]->moveChannels ( cacGuard,
+            *this->ppSearchTmr[this->beaconAnomalyTimerIndex],
+            nMax - nMoved );
     }
+    return nMoved;
 }
 
 void udpiiu::uninstallChanDueToSuccessfulSearchResponse (
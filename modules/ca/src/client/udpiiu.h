@@ -37,6 +37,7 @@
 #include "netiiu.h"
 #include "searchTimer.h"
 #include "disconnectGovernorTimer.h"
+#include "beaconAnomalyGovernor.h"
 #include "repeaterSubscribeTimer.h"
 #include "SearchDest.h"
 
@@ -87,11 +88,13 @@ static const double maxRoundTripEstimate = 30; // seconds
 static const double maxSearchPeriodDefault = 5.0 * 60.0; // seconds
 static const double maxSearchPeriodLowerLimit = 60.0; // seconds
 static const double beaconAnomalySearchPeriod = 5.0; // seconds
+static const double searchRateInterval = 1.0; // seconds
 
 class udpiiu :
     private netiiu,
     private searchTimerNotify,
-    private disconnectGovernorNotify {
+    private disconnectGovernorNotify,
+    private beaconAnomalyGovernorNotify {
 public:
     udpiiu (
         epicsGuard < epicsMutex > & cacGuard,
@@ -163,6 +166,7 @@ private:
     M_repeaterTimerNotify m_repeaterTimerNotify;
     repeaterSubscribeTimer repeaterSubscribeTmr;
     disconnectGovernorTimer govTmr;
+    beaconAnomalyGovernor anomalyGov;
     tsDLList < SearchDest > _searchDestList;
     const double maxPeriod;
     double rtteMean;
@@ -181,6 +185,11 @@ private:
         SearchArray(const SearchArray&);
         SearchArray& operator=(const SearchArray&);
     } ppSearchTmr;
+    epicsTime searchRateIntervalBegin;
+    double searchFrameRate;
+    double searchFrameRatePeak;
+    unsigned long nSearchFrames;
+    unsigned nSearchFramesThisInterval;
     unsigned nBytesInXmitBuf;
     unsigned beaconAnomalyTimerIndex;
     ca_uint32_t sequenceNumber;
@@ -306,6 +315,12 @@ private:
     void govExpireNotify (
         epicsGuard < epicsMutex > &, nciu & );
 
+    // beaconAnomalyGovernorNotify
+    unsigned beaconAnomalyBacklog (
+        epicsGuard < epicsMutex > & ) const;
+    unsigned beaconAnomalyReschedule (
+        epicsGuard < epicsMutex > &, unsigned nMax );
+
     udpiiu ( const udpiiu & );
     udpiiu & operator = ( const udpiiu & );
 
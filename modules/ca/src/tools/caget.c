@@ -43,7 +43,7 @@
 #define PEND_EVENT_SLICES 5     /* No. of pend_event slices for callback requests */
 
 /* Different output formats */
-typedef enum { plain, terse, all, specifiedDbr } OutputT;
+typedef enum { plain, terse, all, specifiedDbr, binary } OutputT;
 
 /* Different request types */
 typedef enum { get, callback } RequestT;
@@ -101,6 +101,9 @@ static void usage (void)
     "  -0b: Print as binary number\n"
     "Alternate output field separator:\n"
     "  -F <ofs>: Use <ofs> as an alternate output field separator\n"
+    "Binary output:\n"
+    "  -B: Write a binary record stream to stdout instead of text\n"
+    "      (values in native type, with server timestamp and alarm status)\n"
     "\nExample: caget -a -f8 my_channel another_channel\n"
     "  (uses wide output format, doubles are printed as %%f with precision of 8)\n\n"
              , DEFAULT_TIMEOUT, CA_PRIORITY_MAX);
@@ -172,7 +175,11 @@ static int caget (pv *pvs, int nPvs, RequestT request, OutputT format,
         pvs[n].dbrType = dbrType;
 
                                 /* Set up value structures */
-        if (format != specifiedDbr)
+        if (format == binary)
+        {
+            pvs[n].dbrType = dbf_type_to_DBR_TIME(pvs[n].dbfType); /* Always native */
+        }
+        else if (format != specifiedDbr)
         {
             pvs[n].dbrType = dbf_type_to_DBR_TIME(pvs[n].dbfType); /* Use native type */
             if (dbr_type_is_ENUM(pvs[n].dbrType))                  /* Enums honour -n option */
@@ -253,6 +260,17 @@ static int caget (pv *pvs, int nPvs, RequestT request, OutputT format,
                                 /* Print the data */
                                 /* -------------- */
 
+    if (format == binary)
+    {
+        size_t bufSize = sizeof(binRecordHeader) * (2 * nPvs + 1);
+        for (n = 0; n < nPvs; n++) {
+            bufSize += strlen(pvs[n].name) + 8 +
+                dbr_size_n(pvs[n].dbrType, pvs[n].nElems);
+        }
+        if (binary_output_start(pvs, nPvs, bufSize))
+            return 1;
+    }
+
     for (n = 0; n < nPvs; n++) {
 
         switch (format) {
@@ -295,6 +313,9 @@ static int caget (pv *pvs, int nPvs, RequestT request, OutputT format,
         case all:
             print_time_val_sts(&pvs[n], reqElems);
             break;
+        case binary:
+            binary_output_write(&pvs[n]);
+            break;
         case specifiedDbr:
             printf("%s\n", pvs[n].name);
             if (pvs[n].status == ECA_DISCONN)
@@ -344,6 +365,8 @@ static int caget (pv *pvs, int nPvs, RequestT request, OutputT format,
             break;
         }
     }
+    if (format == binary)
+        binary_output_stop();
     return 0;
 }
 
@@ -369,7 +392,7 @@ static void complainIfNotPlainAndSet (OutputT *current, const OutputT requested)
 {
     if (*current != plain)
         fprintf(stderr,
-                "Options t,d,a are mutually exclusive. "
+                "Options t,d,a,B are mutually exclusive. "
                 "('caget -h' for help.)\n");
     *current = requested;
 }
@@ -392,7 +415,7 @@ int main (int argc, char *argv[])
 
     LINE_BUFFER(stdout);        /* Configure stdout buffering */
 
-    while ((opt = getopt(argc, argv, ":taicnhsSVe:f:g:l:#:d:0:w:p:F:")) != -1) {
+    while ((opt = getopt(argc, argv, ":taicnhsSBVe:f:g:l:#:d:0:w:p:F:")) != -1) {
         switch (opt) {
         case 'h':               /* Print usage */
             usage();
@@ -406,6 +429,9 @@ int main (int argc, char *argv[])
         case 'a':               /* Wide output mode */
             complainIfNotPlainAndSet(&format, all);
             break;
+        case 'B':               /* Binary output stream */
+            complainIfNotPlainAndSet(&format, binary);
+            break;
         case 'c':               /* Callback mode */
             request = callback;
             break;
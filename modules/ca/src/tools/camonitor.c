@@ -40,6 +40,9 @@ static unsigned long reqElems = 0;
 static unsigned long eventMask = DBE_VALUE | DBE_ALARM;   /* Event mask used */
 static int floatAsString = 0;                             /* Flag: fetch floats as string */
 static int nConn = 0;                                     /* Number of connected PVs */
+static int binaryOutput = 0;                              /* Flag: binary output stream */
+
+#define BIN_BUFFER_SIZE 0x1000000   /* Ring buffer size for binary output */
 
 
 void usage (void)
@@ -86,6 +89,10 @@ void usage (void)
     "  -0b:      Print as binary number\n"
     "Alternate output field separator:\n"
     "  -F <ofs>: Use <ofs> to separate fields in output\n"
+    "Binary output:\n"
+    "  -B:       Write a binary record stream to stdout instead of text\n"
+    "            (values in native type, with server timestamp and alarm status,\n"
+    "            updates that can't be written fast enough are dropped and counted)\n"
     "\n"
     "Example: camonitor -f8 my_channel another_channel\n"
     "  (doubles are printed as %%f with precision of 8)\n\n"
@@ -116,8 +123,12 @@ static void event_handler (evargs args)
         pv->nElems = args.count;
         pv->value = (void *) args.dbr;    /* casting away const */
 
-        print_time_val_sts(pv, reqElems);
-        fflush(stdout);
+        if (binaryOutput) {
+            binary_output_write(pv);
+        } else {
+            print_time_val_sts(pv, reqElems);
+            fflush(stdout);
+        }
 
         pv->value = NULL;
     }
@@ -154,7 +165,11 @@ static void connection_handler ( struct connection_handler_args args )
                                 /* Get natural type and array count */
             ppv->dbfType = ca_field_type(ppv->chid);
             ppv->dbrType = dbf_type_to_DBR_TIME(ppv->dbfType); /* Use native type */
-            if (dbr_type_is_ENUM(ppv->dbrType))                /* Enums honour -n option */
+            if (binaryOutput)
+            {
+                /* Binary output always uses the native type */
+            }
+            else if (dbr_type_is_ENUM(ppv->dbrType))           /* Enums honour -n option */
             {
                 if (enumAsNr) ppv->dbrType = DBR_TIME_INT;
                 else          ppv->dbrType = DBR_TIME_STRING;
@@ -183,7 +198,10 @@ static void connection_handler ( struct connection_handler_args args )
     else if ( args.op == CA_OP_CONN_DOWN ) {
         nConn--;
         ppv->status = ECA_DISCONN;
-        print_time_val_sts(ppv, reqElems);
+        if (binaryOutput)
+            binary_output_write(ppv);
+        else
+            print_time_val_sts(ppv, reqElems);
     }
 }
 
@@ -219,7 +237,7 @@ int main (int argc, char *argv[])
 
     LINE_BUFFER(stdout);        /* Configure stdout buffering */
 
-    while ((opt = getopt(argc, argv, ":nhVm:sSe:f:g:l:#:0:w:t:p:F:")) != -1) {
+    while ((opt = getopt(argc, argv, ":nhVm:sSBe:f:g:l:#:0:w:t:p:F:")) != -1) {
         switch (opt) {
         case 'h':               /* Print usage */
             usage();
@@ -300,6 +318,9 @@ int main (int argc, char *argv[])
         case 'S':               /* Treat char array as (long) string */
             charArrAsStr = 1;
             break;
+        case 'B':               /* Binary output stream */
+            binaryOutput = 1;
+            break;
         case 'e':               /* Select %e/%f/%g format, using <arg> digits */
         case 'f':
         case 'g':
@@ -380,6 +401,9 @@ int main (int argc, char *argv[])
     for (n = 0; optind < argc; n++, optind++)
     {
         pvs[n].name   = argv[optind];
+    }
+    if (binaryOutput && binary_output_start(pvs, nPvs, BIN_BUFFER_SIZE)) {
+        return 1;
     }
                                       /* Create CA connections */
     returncode = create_pvs(pvs, nPvs, connection_handler);
@@ -390,8 +414,12 @@ int main (int argc, char *argv[])
     ca_pend_event(caTimeout);
     for (n = 0; n < nPvs; n++)
     {
-        if (!pvs[n].onceConnected)
-            print_time_val_sts(&pvs[n], reqElems);
+        if (!pvs[n].onceConnected) {
+            if (binaryOutput)
+                binary_output_write(&pvs[n]);
+            else
+                print_time_val_sts(&pvs[n], reqElems);
+        }
     }
 
                                 /* Read and print data forever */
@@ -399,6 +427,8 @@ int main (int argc, char *argv[])
 
                                 /* Shut down Channel Access */
     ca_context_destroy();
+    if (binaryOutput)
+        binary_output_stop();
 
     return result;
 }
@@ -29,8 +29,16 @@
 #include <alarm.h>
 #include <epicsTime.h>
 #include <epicsString.h>
+#include <epicsThread.h>
+#include <epicsEvent.h>
+#include <epicsRingBytes.h>
 #include <cadef.h>
 
+#ifdef _WIN32
+#  include <io.h>
+#  include <fcntl.h>
+#endif
+
 #include "tool_lib.h"
 
 /* Time stamps for program start, first incoming monitor,
@@ -639,3 +647,212 @@ int connect_pvs (pv* pvs, int nPvs)
     }
     return returncode;
 }
+
+
+/* Binary output (-B option): records are queued by the CA callbacks into
+   a ring buffer that is drained to stdout by a separate writer thread, so
+   that a slow consumer does not stall CA. If the ring is full the update
+   is dropped and counted */
+
+#define BIN_WRITE_CHUNK 0x10000
+#define BIN_DROP_REPORT_PERIOD 1.0
+
+static epicsRingBytesId binRing;
+static epicsEventId binWakeup;
+static epicsThreadId binThread;
+static pv *binPvs;
+static char *binRecord;
+static size_t binRecordSize;
+static volatile int binExit;
+static unsigned long binDroppedTotal;
+
+static void binary_writer (void *arg)
+{
+    char *chunk = malloc(BIN_WRITE_CHUNK);
+    unsigned long nReported = 0;
+    epicsTimeStamp lastReport;
+
+    epicsTimeGetCurrent(&lastReport);
+    while (chunk) {
+        int done = binExit;
+        int n;
+
+        while ((n = epicsRingBytesGet(binRing, chunk, BIN_WRITE_CHUNK)) > 0)
+            fwrite(chunk, 1, n, stdout);
+        fflush(stdout);
+
+        if (binDroppedTotal != nReported) {
+            epicsTimeStamp now;
+            epicsTimeGetCurrent(&now);
+            if (done ||
+                epicsTimeDiffInSeconds(&now, &lastReport) >= BIN_DROP_REPORT_PERIOD) {
+                nReported = binDroppedTotal;
+                lastReport = now;
+                fprintf(stderr, "%lu update(s) dropped so far, output too slow\n",
+                        nReported);
+            }
+        }
+        if (done) break;
+        epicsEventWaitWithTimeout(binWakeup, BIN_DROP_REPORT_PERIOD);
+    }
+    free(chunk);
+}
+
+static void binary_queue (pv *ppv, unsigned kind, unsigned dbrType,
+                          unsigned long count, const void *pData, size_t dataSize,
+                          const epicsTimeStamp *stamp, int status, int severity)
+{
+    binRecordHeader *hdr;
+    size_t length = (sizeof(binRecordHeader) + dataSize + 7u) & ~(size_t) 7u;
+
+    if (length > (size_t) epicsRingBytesSize(binRing)) {
+        ppv->nDropped++;
+        binDroppedTotal++;
+        return;
+    }
+    if (length > binRecordSize) {
+        char *tmp = realloc(binRecord, length);
+        if (!tmp) {
+            ppv->nDropped++;
+            binDroppedTotal++;
+            return;
+        }
+        binRecord = tmp;
+        binRecordSize = length;
+    }
+    hdr = (binRecordHeader *) binRecord;
+    memset(hdr, 0, sizeof(*hdr));
+    hdr->length = (epicsUInt32) length;
+    hdr->kind = (epicsUInt16) kind;
+    hdr->dbrType = (epicsUInt16) dbrType;
+    hdr->channel = (epicsUInt32) (ppv - binPvs);
+    hdr->count = (epicsUInt32) count;
+    if (stamp) {
+        hdr->secPastEpoch = stamp->secPastEpoch;
+        hdr->nsec = stamp->nsec;
+    }
+    hdr->status = (epicsInt16) status;
+    hdr->severity = (epicsInt16) severity;
+    hdr->nDropped = (epicsUInt32) ppv->nDropped;
+    if (dataSize)
+        memcpy(binRecord + sizeof(*hdr), pData, dataSize);
+    memset(binRecord + sizeof(*hdr) + dataSize, 0,
+           length - sizeof(*hdr) - dataSize);
+
+    if (epicsRingBytesPut(binRing, binRecord, (int) length)) {
+        ppv->nDropped = 0;
+        epicsEventSignal(binWakeup);
+    } else {
+        ppv->nDropped++;
+        binDroppedTotal++;
+    }
+}
+
+
+/*+**************************************************************************
+ *
+ * Function:    binary_output_start
+ *
+ * Description: Switch stdout to the binary stream format and start the
+ *              writer thread. Writes the stream header and one channel
+ *              record for each PV.
+ *
+ * Arg(s) In:   pvs      -  Pointer to an array of pv structures
+ *              nPvs     -  Number of elements in the pvs array
+ *              bufSize  -  Size of the output ring buffer in bytes
+ *
+ * Return(s):   Error code: 0 = OK, 1 = Error
+ *
+ **************************************************************************-*/
+
+int binary_output_start (pv *pvs, int nPvs, size_t bufSize)
+{
+    binFileHeader fh;
+    epicsThreadOpts opts = EPICS_THREAD_OPTS_INIT;
+    int n;
+
+#ifdef _WIN32
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    setvbuf(stdout, NULL, _IOFBF, BIN_WRITE_CHUNK);
+
+    binPvs = pvs;
+    binRing = epicsRingBytesCreate((int) bufSize);
+    binWakeup = epicsEventCreate(epicsEventEmpty);
+    if (!binRing || !binWakeup) {
+        fprintf(stderr, "Memory allocation for binary output failed.\n");
+        return 1;
+    }
+
+    memcpy(fh.magic, BIN_MAGIC, sizeof(fh.magic));
+    fh.version = BIN_VERSION;
+    fh.byteOrder = BIN_BYTE_ORDER;
+    fh.nChannels = (epicsUInt32) nPvs;
+    fh.reserved = 0;
+    fwrite(&fh, sizeof(fh), 1, stdout);
+    for (n = 0; n < nPvs; n++) {
+        size_t len = strlen(pvs[n].name) + 1;
+        binary_queue(&pvs[n], binChannel, 0, 0, pvs[n].name, len, NULL, 0, 0);
+    }
+
+    opts.joinable = 1;
+    binThread = epicsThreadCreateOpt("binWriter", binary_writer, NULL, &opts);
+    if (!binThread) {
+        fprintf(stderr, "Failed to start binary output thread.\n");
+        return 1;
+    }
+    return 0;
+}
+
+
+/*+**************************************************************************
+ *
+ * Function:    binary_output_write
+ *
+ * Description: Queue a value (or disconnect) record for a PV. The value
+ *              must have been fetched as a DBR_TIME_xxx type.
+ *
+ * Arg(s) In:   pv  -  Pointer to the pv structure
+ *
+ **************************************************************************-*/
+
+void binary_output_write (pv *ppv)
+{
+    if (ppv->status == ECA_NORMAL && ppv->value && dbr_type_is_TIME(ppv->dbrType)) {
+        const struct dbr_time_short *pts = ppv->value;
+        unsigned plainType = ppv->dbrType - DBR_TIME_STRING;
+        binary_queue(ppv, binValue, plainType, ppv->nElems,
+                     dbr_value_ptr(ppv->value, ppv->dbrType),
+                     dbr_value_size[ppv->dbrType] * ppv->nElems,
+                     &pts->stamp, pts->status, pts->severity);
+    } else {
+        binary_queue(ppv, binDisconnect, 0, 0, NULL, 0, NULL, 0, 0);
+    }
+}
+
+
+/*+**************************************************************************
+ *
+ * Function:    binary_output_stop
+ *
+ * Description: Wait for the writer thread to drain the ring buffer and
+ *              release the binary output resources.
+ *
+ **************************************************************************-*/
+
+void binary_output_stop (void)
+{
+    if (binThread) {
+        binExit = 1;
+        epicsEventSignal(binWakeup);
+        epicsThreadMustJoin(binThread);
+        binThread = NULL;
+    }
+    if (binRing) epicsRingBytesDelete(binRing);
+    if (binWakeup) epicsEventDestroy(binWakeup);
+    free(binRecord);
+    binRing = NULL;
+    binWakeup = NULL;
+    binRecord = NULL;
+    binRecordSize = 0;
+}
@@ -22,6 +22,8 @@
 #ifndef INCLtool_libh
 #define INCLtool_libh
 
+#include <stddef.h>
+#include <epicsTypes.h>
 #include <epicsTime.h>
 
 /* Convert status and severity to strings */
@@ -80,9 +82,57 @@ typedef struct
     char firstStampPrinted;
     char onceConnected;
     evid evid;
+    unsigned long nDropped;     /* Updates dropped by binary output (-B) */
 } pv;
 
 
+/* Binary output stream (-B option)
+ *
+ * The stream starts with a binFileHeader, followed by one binChannel
+ * record for each PV (in command line order), followed by binValue and
+ * binDisconnect records as they arrive. All fields are in the byte
+ * order of the host that wrote the stream; a reader can detect this
+ * from the byteOrder field. Every record starts with a binRecordHeader
+ * and its length is a multiple of 8 bytes.
+ *
+ * binChannel:    count is 0, the payload is the PV name (nil terminated)
+ * binValue:      dbrType is the plain DBR_xxx type of the payload, the
+ *                payload holds count elements of that type
+ * binDisconnect: no payload
+ *
+ * nDropped is the number of updates of this channel that were discarded
+ * since its previous record because the output could not keep up.
+ */
+#define BIN_MAGIC "CABS"
+#define BIN_VERSION 1
+#define BIN_BYTE_ORDER 0x0102
+
+typedef enum { binChannel = 1, binValue = 2, binDisconnect = 3 } BinRecordT;
+
+typedef struct
+{
+    char        magic[4];       /* BIN_MAGIC */
+    epicsUInt16 version;        /* BIN_VERSION */
+    epicsUInt16 byteOrder;      /* BIN_BYTE_ORDER in the writer's order */
+    epicsUInt32 nChannels;      /* Number of binChannel records that follow */
+    epicsUInt32 reserved;
+} binFileHeader;
+
+typedef struct
+{
+    epicsUInt32 length;         /* Record length in bytes, including header */
+    epicsUInt16 kind;           /* BinRecordT */
+    epicsUInt16 dbrType;        /* Plain DBR type of the payload */
+    epicsUInt32 channel;        /* Index of the PV */
+    epicsUInt32 count;          /* Number of elements in the payload */
+    epicsUInt32 secPastEpoch;   /* Server time stamp (EPICS epoch) */
+    epicsUInt32 nsec;
+    epicsInt16  status;         /* Alarm status */
+    epicsInt16  severity;       /* Alarm severity */
+    epicsUInt32 nDropped;       /* Updates dropped before this record */
+} binRecordHeader;
+
+
 extern TimeT tsType;        /* Timestamp type flag (-t option) */
 extern int tsSrcServer;     /* Timestamp source flag (-t option) */
 extern int tsSrcClient;     /* Timestamp source flag (-t option) */
@@ -100,6 +150,9 @@ extern char *dbr2str (const void *value, unsigned type);
 extern void print_time_val_sts (pv *pv, unsigned long reqElems);
 extern int  create_pvs (pv *pvs, int nPvs, caCh *pCB );
 extern int  connect_pvs (pv *pvs, int nPvs );
+extern int  binary_output_start (pv *pvs, int nPvs, size_t bufSize);
+extern void binary_output_write (pv *pv);
+extern void binary_output_stop (void);
 
 /*
  * no additions below this endif
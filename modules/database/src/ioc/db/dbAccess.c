@@ -49,6 +49,8 @@
 #include "dbFldTypes.h"
 #include "dbFldTypes.h"
 #include "dbLink.h"
+#include "dbLoadQueue.h"
+#include "dbSnapshot.h"
 #include "dbLockPvt.h"
 #include "dbNotify.h"
 #include "dbScan.h"
@@ -786,6 +788,8 @@ int dbLoadDatabase(const char *file, const char *path, const char *subs)
         printf("Usage: dbLoadDatabase \"file\", \"path\", \"subs\"\n");
         return -1;
     }
+    dbSnapshotFlush();
+    dbLoadQueueFlush();
     return dbReadDatabase(&pdbbase, file, path, subs);
 }
 
@@ -797,6 +801,11 @@ int dbLoadRecords(const char* file, const char* subs)
         printf("Usage: dbLoadRecords \"file\", \"subs\"\n");
         return -1;
     }
+    if (dbSnapshotEnabled())
+        return dbSnapshotAdd(file, subs);
+    if (dbLoadQueueEnabled())
+        return dbLoadQueueAdd(file, subs);
+    dbLoadQueueFlush();
     status = dbReadDatabase(&pdbbase, file, 0, subs);
     switch(status)
     {
@@ -25,8 +25,10 @@
 #include "epicsAssert.h"
 #include "epicsEvent.h"
 #include "epicsExit.h"
+#include "epicsExport.h"
 #include "epicsMutex.h"
 #include "epicsPrint.h"
+#include "epicsStdio.h"
 #include "epicsString.h"
 #include "epicsThread.h"
 #include "epicsAtomic.h"
@@ -61,18 +63,22 @@
 extern void dbServiceIOInit();
 extern int dbServiceIsolate;
 
-static ELLLIST workList = ELLLIST_INIT;    /* Work list for dbCaTask */
-static epicsMutexId workListLock; /*Mutual exclusions semaphores for workList*/
-static epicsEventId workListEvent; /*wakeup event for dbCaTask*/
-static int removesOutstanding = 0;
+/* Links are shared between this many dbCaTask threads, each with its own
+ * CA client context and work list. Set before iocInit.
+ */
+int dbCaLinkThreads = 1;
+epicsExportAddress(int, dbCaLinkThreads);
+
+#define DBCA_MAX_WORKERS 16
+static dbCaWorker workers[DBCA_MAX_WORKERS];
+static int nWorkers;
 #define removesOutstandingWarning 10000
 
 static volatile enum dbCaCtl_t {
     ctlInit, ctlRun, ctlPause, ctlExit
 } dbCaCtl;
-static epicsEventId startStopEvent;
-static epicsThreadId dbCaWorker;
 
+/* The context of the first worker */
 struct ca_client_context * dbCaClientContext;
 
 /* Forward declarations */
@@ -84,15 +90,14 @@ static lset dbCa_lset;
     errlogPrintf("%s has DB CA link to %s\n",\
         pcaLink->plink->precord->name, pcaLink->pvname)
 
-static int dbca_chan_count;
-
 /* caLink locking
  *
  * Lock ordering:
  *  dbScanLock -> caLink.lock -> workListLock
  *
  * workListLock:
- *   Guards access to workList.
+ *   Guards access to the workList of one worker. Each caLink is given to
+ *   a worker when it is created, and stays with it until it is freed.
  *
  * dbScanLock:
  *   All dbCa* functions operating on a single link may only be called when
@@ -110,7 +115,7 @@ static int dbca_chan_count;
  * caLink.lock:
  *   Guards the caLink structure (but not the struct DBLINK)
  *
- * The dbCaTask only locks caLink, and must not lock the record (a violation of lock order).
+ * The dbCaTask threads only lock caLink, and must not lock the record (a violation of lock order).
  *
  * During link modification or IOC shutdown the pca->plink pointer (guarded by caLink.lock)
  * is used as a flag to indicate that a link is no longer active.
@@ -130,9 +135,10 @@ static int dbca_chan_count;
 
 static void addAction(caLink *pca, short link_action)
 {
+    dbCaWorker *pw = pca->worker;
     int callAdd;
 
-    epicsMutexMustLock(workListLock);
+    epicsMutexMustLock(pw->workListLock);
     callAdd = (pca->link_action == 0);
     if (pca->link_action & CA_CLEAR_CHANNEL) {
         errlogPrintf("dbCa::addAction %d with CA_CLEAR_CHANNEL set\n",
@@ -141,22 +147,26 @@ static void addAction(caLink *pca, short link_action)
         link_action = 0;
     }
     if (link_action & CA_CLEAR_CHANNEL) {
-        if (++removesOutstanding >= removesOutstandingWarning) {
+        if (++pw->removesOutstanding >= removesOutstandingWarning) {
             errlogPrintf("dbCa::addAction pausing, %d channels to clear\n",
-                removesOutstanding);
+                pw->removesOutstanding);
         }
-        while (removesOutstanding >= removesOutstandingWarning) {
-            epicsMutexUnlock(workListLock);
+        while (pw->removesOutstanding >= removesOutstandingWarning) {
+            epicsMutexUnlock(pw->workListLock);
             epicsThreadSleep(1.0);
-            epicsMutexMustLock(workListLock);
+            epicsMutexMustLock(pw->workListLock);
         }
     }
     pca->link_action |= link_action;
+    if (callAdd) {
+        pca->queued = epicsMonotonicGet();
+        ellAdd(&pw->workList, &pca->node);
+        if (ellCount(&pw->workList) > pw->maxQueued)
+            pw->maxQueued = ellCount(&pw->workList);
+    }
+    epicsMutexUnlock(pw->workListLock);
     if (callAdd)
-        ellAdd(&workList, &pca->node);
-    epicsMutexUnlock(workListLock);
-    if (callAdd)
-        epicsEventSignal(workListEvent);
+        epicsEventSignal(pw->workListEvent);
 }
 
 static void caLinkInc(caLink *pca)
@@ -178,8 +188,9 @@ static void caLinkDec(caLink *pca)
 
     if (pca->chid) {
         ca_clear_channel(pca->chid);
-        --dbca_chan_count;
+        epicsAtomicDecrIntT(&pca->worker->chanCount);
     }
+    epicsAtomicDecrIntT(&pca->worker->nLinks);
     callback = pca->putCallback;
     if (callback) {
         userPvt = pca->putUserPvt;
@@ -263,13 +274,14 @@ void testdbCaWaitForUpdateCount(DBLINK *plink, unsigned long cnt)
     testdbCaWaitForEvent(plink, cnt, testEventCount);
 }
 
-/* Block until worker thread has processed all previously queued actions.
+/* Block until worker threads have processed all previously queued actions.
  * Does not prevent additional actions from being queued.
  */
 void dbCaSync(void)
 {
     epicsEventId wake;
     caLink templink;
+    int i;
 
     /* we only partially initialize templink.
      * It has no link field and no subscription
@@ -283,15 +295,20 @@ void dbCaSync(void)
 
     templink.userPvt = wake;
 
-    addAction(&templink, CA_SYNC);
+    for (i = 0; i < nWorkers; i++) {
+        dbCaWorker *pw = &workers[i];
 
-    epicsEventMustWait(wake);
-    /* Worker holds workListLock when calling epicsEventMustTrigger()
-     * we cycle through workListLock to ensure worker call to
-     * epicsEventMustTrigger() returns before we destroy the event.
-     */
-    epicsMutexMustLock(workListLock);
-    epicsMutexUnlock(workListLock);
+        templink.worker = pw;
+        addAction(&templink, CA_SYNC);
+
+        epicsEventMustWait(wake);
+        /* Worker holds workListLock when calling epicsEventMustTrigger()
+         * we cycle through workListLock to ensure worker call to
+         * epicsEventMustTrigger() returns before we reuse the event.
+         */
+        epicsMutexMustLock(pw->workListLock);
+        epicsMutexUnlock(pw->workListLock);
+    }
 
     assert(templink.refcount==1);
 
@@ -306,20 +323,36 @@ void dbCaCallbackProcess(void *userPvt)
     dbLinkAsyncComplete(plink);
 }
 
+static void signalWorkers(void)
+{
+    int i;
+
+    for (i = 0; i < nWorkers; i++)
+        epicsEventSignal(workers[i].workListEvent);
+}
+
 void dbCaShutdown(void)
 {
     enum dbCaCtl_t cur = dbCaCtl;
+    int i;
+
     assert(cur == ctlRun || cur == ctlPause);
     dbCaCtl = ctlExit;
-    epicsEventSignal(workListEvent);
-    epicsEventMustWait(startStopEvent);
-    if(dbCaWorker)
-        epicsThreadMustJoin(dbCaWorker);
+    signalWorkers();
+    for (i = 0; i < nWorkers; i++) {
+        dbCaWorker *pw = &workers[i];
+
+        epicsEventMustWait(pw->startStopEvent);
+        if (pw->thread)
+            epicsThreadMustJoin(pw->thread);
+        pw->thread = NULL;
+    }
 }
 
 static void dbCaLinkInitImpl(int isolate)
 {
     epicsThreadOpts opts = EPICS_THREAD_OPTS_INIT;
+    int i;
 
     opts.stackSize = epicsThreadGetStackSize(epicsThreadStackBig);
     opts.priority = epicsThreadPriorityMedium;
@@ -328,18 +361,37 @@ static void dbCaLinkInitImpl(int isolate)
     dbServiceIsolate = isolate;
     dbServiceIOInit();
 
-    if (!workListLock)
-        workListLock = epicsMutexMustCreate();
-    if (!workListEvent)
-        workListEvent = epicsEventMustCreate(epicsEventEmpty);
-
-    if(!startStopEvent)
-        startStopEvent = epicsEventMustCreate(epicsEventEmpty);
+    nWorkers = dbCaLinkThreads;
+    if (nWorkers < 1)
+        nWorkers = 1;
+    if (nWorkers > DBCA_MAX_WORKERS) {
+        errlogPrintf("dbCaLinkInit: dbCaLinkThreads limited to %d\n",
+            DBCA_MAX_WORKERS);
+        nWorkers = DBCA_MAX_WORKERS;
+    }
     dbCaCtl = ctlPause;
 
-    dbCaWorker = epicsThreadCreateOpt("dbCaLink", dbCaTask, NULL, &opts);
-    /* wait for worker to startup and initialize dbCaClientContext */
-    epicsEventMustWait(startStopEvent);
+    for (i = 0; i < nWorkers; i++) {
+        dbCaWorker *pw = &workers[i];
+        char name[20] = "dbCaLink";
+
+        if (!pw->workListLock)
+            pw->workListLock = epicsMutexMustCreate();
+        if (!pw->workListEvent)
+            pw->workListEvent = epicsEventMustCreate(epicsEventEmpty);
+        if (!pw->startStopEvent)
+            pw->startStopEvent = epicsEventMustCreate(epicsEventEmpty);
+        pw->maxQueued = 0;
+        pw->nActions = 0;
+        pw->totalLatency = pw->maxLatency = 0;
+
+        if (i)
+            sprintf(name, "dbCaLink%d", i);
+        pw->thread = epicsThreadCreateOpt(name, dbCaTask, pw, &opts);
+        /* wait for worker to startup and initialize its context */
+        epicsEventMustWait(pw->startStopEvent);
+    }
+    dbCaClientContext = workers[0].context;
 }
 
 void dbCaLinkInitIsolated(void)
@@ -356,7 +408,7 @@ void dbCaRun(void)
 {
     if (dbCaCtl == ctlPause) {
         dbCaCtl = ctlRun;
-        epicsEventSignal(workListEvent);
+        signalWorkers();
     }
 }
 
@@ -364,7 +416,7 @@ void dbCaPause(void)
 {
     if (dbCaCtl == ctlRun) {
         dbCaCtl = ctlPause;
-        epicsEventSignal(workListEvent);
+        signalWorkers();
     }
 }
 
@@ -380,6 +432,9 @@ void dbCaAddLinkCallback(struct link *plink,
     pca->lock = epicsMutexMustCreate();
     pca->plink = plink;
     pca->pvname = epicsStrDup(plink->value.pv_link.pvname);
+    pca->worker = &workers[nWorkers > 1 ?
+        epicsStrHash(pca->pvname, 0) % nWorkers : 0];
+    epicsAtomicIncrIntT(&pca->worker->nLinks);
     pca->connect = connect;
     pca->monitor = monitor;
     pca->userPvt = userPvt;
@@ -1116,33 +1171,35 @@ static void getAttribEventCallback(struct event_handler_args arg)
 
 static void dbCaTask(void *arg)
 {
+    dbCaWorker *pw = (dbCaWorker *) arg;
     epicsEventId requestSync = NULL;
     taskwdInsert(0, NULL, NULL);
     SEVCHK(ca_context_create(ca_enable_preemptive_callback),
         "dbCaTask calling ca_context_create");
-    dbCaClientContext = ca_current_context ();
+    pw->context = ca_current_context ();
     SEVCHK(ca_add_exception_event(exceptionCallback,NULL),
         "ca_add_exception_event");
-    epicsEventSignal(startStopEvent);
+    epicsEventSignal(pw->startStopEvent);
 
     /* channel access event loop */
     while (TRUE){
         do {
-            epicsEventMustWait(workListEvent);
+            epicsEventMustWait(pw->workListEvent);
         } while (dbCaCtl == ctlPause);
         while (TRUE) { /* process all requests in workList*/
             caLink *pca;
             short  link_action;
             int    status;
+            epicsUInt64 latency;
 
-            epicsMutexMustLock(workListLock);
-            if (!(pca = (caLink *)ellGet(&workList))){  /* Take off list head */
+            epicsMutexMustLock(pw->workListLock);
+            if (!(pca = (caLink *)ellGet(&pw->workList))){  /* Take off list head */
                 if(requestSync) {
                     /* dbCaSync() requires workListLock to be held here */
                     epicsEventMustTrigger(requestSync);
                     requestSync = NULL;
                 }
-                epicsMutexUnlock(workListLock);
+                epicsMutexUnlock(pw->workListLock);
                 if (dbCaCtl == ctlExit) goto shutdown;
                 break; /* workList is empty */
             }
@@ -1152,8 +1209,13 @@ static void dbCaTask(void *arg)
                 requestSync = pca->userPvt;
             }
             pca->link_action = 0;
-            if (link_action & CA_CLEAR_CHANNEL) --removesOutstanding;
-            epicsMutexUnlock(workListLock);         /* Give back immediately */
+            if (link_action & CA_CLEAR_CHANNEL) --pw->removesOutstanding;
+            latency = epicsMonotonicGet() - pca->queued;
+            pw->nActions++;
+            pw->totalLatency += latency;
+            if (latency > pw->maxLatency)
+                pw->maxLatency = latency;
+            epicsMutexUnlock(pw->workListLock);     /* Give back immediately */
             if (link_action&CA_SYNC)
                 continue;
             if (link_action & CA_CLEAR_CHANNEL) {   /* This must be first */
@@ -1171,7 +1233,7 @@ static void dbCaTask(void *arg)
                     printLinks(pca);
                     continue;
                 }
-                dbca_chan_count++;
+                epicsAtomicIncrIntT(&pw->chanCount);
                 status = ca_replace_access_rights_event(pca->chid,
                     accessRightsCallback);
                 if (status != ECA_NORMAL) {
@@ -1275,9 +1337,40 @@ static void dbCaTask(void *arg)
     }
 shutdown:
     taskwdRemove(0);
-    if (dbca_chan_count == 0)
+    if (pw->chanCount == 0)
         ca_context_destroy();
     else
-        fprintf(stderr, "dbCa: chan_count = %d at shutdown\n", dbca_chan_count);
-    epicsEventSignal(startStopEvent);
+        fprintf(stderr, "dbCa: chan_count = %d at shutdown\n", pw->chanCount);
+    epicsEventSignal(pw->startStopEvent);
+}
+
+void dbCaReportWorkers(int level)
+{
+    int i;
+
+    if (nWorkers < 2 && level < 1)
+        return;
+    printf("dbCaLink threads: links, queued (max), actions, "
+        "latency avg/max ms\n");
+    for (i = 0; i < nWorkers; i++) {
+        dbCaWorker *pw = &workers[i];
+        int queued, maxQueued;
+        unsigned long nActions;
+        double avg, max;
+
+        epicsMutexMustLock(pw->workListLock);
+        queued = ellCount(&pw->workList);
+        maxQueued = pw->maxQueued;
+        nActions = pw->nActions;
+        avg = nActions ? pw->totalLatency * 1e-6 / nActions : 0.0;
+        max = pw->maxLatency * 1e-6;
+        epicsMutexUnlock(pw->workListLock);
+
+        printf("    %2d: %6d, %6d (%d), %lu, %.3f/%.3f\n", i,
+            epicsAtomicGetIntT(&pw->nLinks), queued, maxQueued,
+            nActions, avg, max);
+        if (level > 2 && pw->context)
+            ca_context_status(pw->context, level - 2);
+    }
+    printf("\n");
 }
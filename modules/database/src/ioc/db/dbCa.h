@@ -47,6 +47,9 @@ DBCORE_API long dbCaPutLink(struct link *plink,short dbrType,
 
 extern struct ca_client_context * dbCaClientContext;
 
+/* Number of dbCaLink threads, read by iocInit */
+DBCORE_API extern int dbCaLinkThreads;
+
 #ifdef EPICS_DBCA_PRIVATE_API
 /* Wait CA link work queue to become empty.  eg. after from dbPut() to OUT */
 DBCORE_API void dbCaSync(void);
@@ -18,7 +18,9 @@
 
 #include "dbCa.h"
 #include "ellLib.h"
+#include "epicsEvent.h"
 #include "epicsMutex.h"
+#include "epicsThread.h"
 #include "epicsTypes.h"
 #include "link.h"
 
@@ -35,10 +37,31 @@
 #define CA_PUT          0x1
 #define CA_PUT_CALLBACK 0x2
 
+/* One of these per dbCaLink thread */
+typedef struct dbCaWorker
+{
+    ELLLIST         workList;       /* caLinks with actions to perform */
+    epicsMutexId    workListLock;   /* guards workList and the counts below */
+    epicsEventId    workListEvent;  /* wakes up the thread */
+    epicsEventId    startStopEvent;
+    epicsThreadId   thread;
+    struct ca_client_context *context;
+    int             removesOutstanding;
+    int             chanCount;
+    /* The following are for dbcar */
+    int             nLinks;
+    int             maxQueued;
+    unsigned long   nActions;
+    epicsUInt64     totalLatency;   /* ns from addAction() to the thread */
+    epicsUInt64     maxLatency;
+} dbCaWorker;
+
 typedef struct caLink
 {
     ELLNODE         node;
     int             refcount;
+    dbCaWorker      *worker;
+    epicsUInt64     queued;         /* when first added to workList */
     epicsMutexId    lock;
     struct link     *plink;
     char            *pvname;
@@ -96,4 +119,7 @@ typedef struct caLink
     unsigned long   nUpdate;
 }caLink;
 
+/* Print per-thread queue statistics for dbcar */
+void dbCaReportWorkers(int level);
+
 #endif /* INC_dbCaPvt_H */
@@ -154,9 +154,7 @@ done:
            nDisconnect, nNoWrite);
     dbFinishEntry(pdbentry);
 
-    if ( level > 2  && dbCaClientContext != 0 ) {
-        ca_context_status ( dbCaClientContext, level - 2 );
-    }
+    dbCaReportWorkers(level);
 
     return(0);
 }
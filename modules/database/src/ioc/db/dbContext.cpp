@@ -308,6 +308,8 @@ void dbContext::destroyAllIO (
     }
 
     if ( chan.dbContextPrivateListOfIO::pBlocker ) {
+        chan.dbContextPrivateListOfIO::pBlocker->channelDeleteException (
+            cbGuard, guard );
         chan.dbContextPrivateListOfIO::pBlocker->destructor ( cbGuard, guard );
         this->dbPutNotifyBlockerFreeList.release ( chan.dbContextPrivateListOfIO::pBlocker );
         chan.dbContextPrivateListOfIO::pBlocker = 0;
@@ -60,22 +60,59 @@ static void copyNoConvert(const void *pfrom,
 #define COPYNOCONVERT(N, FROM, TO, NREQ, NO_ELEM, OFFSET) \
     copyNoConvert(FROM, TO, (N)*(NREQ), (N)*(NO_ELEM), (N)*(OFFSET))
 
+/* Number of elements that can be converted from offset before wrapping
+ * around to the start of an array of no_elements.
+ */
+static long noWrap(long nRequest, long no_elements, long offset)
+{
+    if (offset < no_elements && offset + nRequest > no_elements)
+        return no_elements - offset;
+    return nRequest;
+}
+
+/* The parts of an array before and after the wrap are converted by
+ * separate simple loops, which the compiler can vectorize.
+ */
+#define CONVERT_LOOP(typeb, pdst, psrc, n) \
+    do { \
+        long i; \
+        for (i = 0; i < (n); i++) \
+            (pdst)[i] = (typeb) (psrc)[i]; \
+    } while (0)
+
+/* Convert doubles to floats as epicsConvertDoubleToFloat() does, but
+ * only call it for the values it has to clip.
+ */
+static void convertDoubleToFloat(epicsFloat32 *pdst,
+    const epicsFloat64 *psrc, long n)
+{
+    long i;
+
+    for (i = 0; i < n; i++) {
+        double value = psrc[i];
+        double abs = fabs(value);
+
+        if (abs < FLT_MAX && (abs > FLT_MIN || value == 0))
+            pdst[i] = (epicsFloat32) value;
+        else
+            pdst[i] = epicsConvertDoubleToFloat(value);
+    }
+}
+
 #define GET(typea, typeb) (const dbAddr *paddr, \
     void *pto, long nRequest, long no_elements, long offset) \
 { \
-    typea *psrc = (typea *) paddr->pfield; \
+    const typea *psrc = (const typea *) paddr->pfield; \
     typeb *pdst = (typeb *) pto; \
+    long n; \
     \
     if (nRequest==1 && offset==0) { \
         *pdst = (typeb) *psrc; \
         return 0; \
     } \
-    psrc += offset; \
-    while (nRequest--) { \
-        *pdst++ = (typeb) *psrc++; \
-        if (++offset == no_elements) \
-            psrc = (typea *) paddr->pfield; \
-    } \
+    n = noWrap(nRequest, no_elements, offset); \
+    CONVERT_LOOP(typeb, pdst, psrc + offset, n); \
+    CONVERT_LOOP(typeb, pdst + n, psrc, nRequest - n); \
     return 0; \
 }
 
@@ -98,17 +135,15 @@ static void copyNoConvert(const void *pfrom,
 { \
     const typea *psrc = (const typea *) pfrom; \
     typeb *pdst = (typeb *) paddr->pfield; \
+    long n; \
     \
     if (nRequest==1 && offset==0) { \
         *pdst = (typeb) *psrc; \
         return 0; \
     } \
-    pdst += offset; \
-    while (nRequest--) { \
-        *pdst++ = (typeb) *psrc++; \
-        if (++offset == no_elements) \
-            pdst = (typeb *) paddr->pfield; \
-    } \
+    n = noWrap(nRequest, no_elements, offset); \
+    CONVERT_LOOP(typeb, pdst + offset, psrc, n); \
+    CONVERT_LOOP(typeb, pdst, psrc + n, nRequest - n); \
     return 0; \
 }
 
@@ -810,20 +845,17 @@ static long getDoubleUInt64 GET(epicsFloat64, epicsUInt64)
 static long getDoubleFloat(const dbAddr *paddr,
     void *pto, long nRequest, long no_elements, long offset)
 {
-    epicsFloat64 *psrc = (epicsFloat64 *) paddr->pfield;
+    const epicsFloat64 *psrc = (const epicsFloat64 *) paddr->pfield;
     epicsFloat32 *pdst = (epicsFloat32 *) pto;
+    long n;
 
     if (nRequest==1 && offset==0) {
         *pdst = epicsConvertDoubleToFloat(*psrc);
         return 0;
     }
-    psrc += offset;
-    while (nRequest--) {
-        *pdst = epicsConvertDoubleToFloat(*psrc);
-        ++psrc; ++pdst;
-        if (++offset == no_elements)
-            psrc = (epicsFloat64 *) paddr->pfield;
-    }
+    n = noWrap(nRequest, no_elements, offset);
+    convertDoubleToFloat(pdst, psrc + offset, n);
+    convertDoubleToFloat(pdst + n, psrc, nRequest - n);
     return 0;
 }
 
@@ -1641,17 +1673,15 @@ static long putDoubleFloat(dbAddr *paddr,
 {
     const epicsFloat64 *psrc = (const epicsFloat64 *) pfrom;
     epicsFloat32 *pdst = (epicsFloat32 *) paddr->pfield;
+    long n;
 
     if (nRequest==1 && offset==0) {
         *pdst = epicsConvertDoubleToFloat(*psrc);
         return 0;
     }
-    pdst += offset;
-    while (nRequest--) {
-        *pdst++ = epicsConvertDoubleToFloat(*psrc++);
-        if (++offset == no_elements)
-            pdst = (epicsFloat32 *) paddr->pfield;
-    }
+    n = noWrap(nRequest, no_elements, offset);
+    convertDoubleToFloat(pdst + offset, psrc, n);
+    convertDoubleToFloat(pdst, psrc + n, nRequest - n);
     return 0;
 }
 
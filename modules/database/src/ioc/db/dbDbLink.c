@@ -104,11 +104,10 @@ long dbDbInitLink(struct link *plink, short dbfType)
     plink->type = DB_LINK;
     plink->value.pv_link.pvt = chan;
     ellAdd(&precord->bklnk, &plink->value.pv_link.backlinknode);
-    /* merging into the same lockset is deferred to the caller.
-     * cf. initPVLinks()
+    /* merging into the same lockset is deferred to
+     * dbLockComputeSets(), called by iocInit once all links are resolved.
      */
     dbLockSetMerge(NULL, plink->precord, precord);
-    assert(plink->precord->lset->plockSet == precord->lset->plockSet);
     return 0;
 }
 
@@ -161,6 +160,18 @@ static long dbDbGetElements(const struct link *plink, long *nelements)
     return 0;
 }
 
+/* Copy a scalar that needs no conversion, returns FALSE for other sizes */
+static int copySameType(void *pto, const void *pfrom, short size)
+{
+    switch (size) {
+    case 1: *(epicsUInt8 *) pto = *(const epicsUInt8 *) pfrom; return TRUE;
+    case 2: *(epicsUInt16 *) pto = *(const epicsUInt16 *) pfrom; return TRUE;
+    case 4: *(epicsUInt32 *) pto = *(const epicsUInt32 *) pfrom; return TRUE;
+    case 8: *(epicsUInt64 *) pto = *(const epicsUInt64 *) pfrom; return TRUE;
+    }
+    return FALSE;
+}
+
 static long dbDbGetValue(struct link *plink, short dbrType, void *pbuffer,
         long *pnRequest)
 {
@@ -180,8 +191,14 @@ static long dbDbGetValue(struct link *plink, short dbrType, void *pbuffer,
 
     if (ppv_link->getCvt && ppv_link->lastGetdbrType == dbrType)
     {
-        /* shortcut: scalar with known conversion, no filter */
-        status = ppv_link->getCvt(dbChannelField(chan), pbuffer, paddr);
+        /* shortcut: scalar with known conversion, no filter.
+         * Numeric fields read as their own type are copied directly.
+         */
+        if (dbrType == paddr->field_type && dbrType != DBR_STRING &&
+            copySameType(pbuffer, dbChannelField(chan), paddr->field_size))
+            status = 0;
+        else
+            status = ppv_link->getCvt(dbChannelField(chan), pbuffer, paddr);
     }
     else if (dbChannelFinalElements(chan) == 1 && (!pnRequest || *pnRequest == 1)
                 && dbChannelSpecial(chan) != SPC_DBADDR
@@ -225,7 +242,8 @@ static long dbDbGetValue(struct link *plink, short dbrType, void *pbuffer,
             return status;
     }
 
-    if (!status && precord != dbChannelRecord(chan))
+    if (!status && (ppv_link->pvlMask & pvlOptMsMode) &&
+        precord != dbChannelRecord(chan))
         recGblInheritSevr(plink->value.pv_link.pvlMask & pvlOptMsMode,
             plink->precord,
             dbChannelRecord(chan)->stat, dbChannelRecord(chan)->sevr);
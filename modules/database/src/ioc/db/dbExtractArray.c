@@ -26,6 +26,14 @@
 #include "dbAddr.h"
 #include "dbExtractArray.h"
 
+/* Element by element, lowest address first so it works in place */
+#define COPY_STRIDED(type, pdst, psrc, n, increment) { \
+        type *pd = (type *) (pdst); \
+        const type *ps = (const type *) (psrc); \
+        for (i = 0; i < (n); i++) \
+            pd[i] = ps[i * (increment)]; \
+    }
+
 void dbExtractArray(const void *pfrom, void *pto, short field_size,
     long nRequest, long no_elements, long offset, long increment)
 {
@@ -42,14 +50,41 @@ void dbExtractArray(const void *pfrom, void *pto, short field_size,
     if (increment == 1) {
         long nUpperPart =
             nRequest < no_elements - offset ? nRequest : no_elements - offset;
-        memcpy(pdst, psrc + (offset * field_size), field_size * nUpperPart);
+        memmove(pdst, psrc + (offset * field_size), field_size * nUpperPart);
         if (nRequest > nUpperPart)
-            memcpy(pdst + (field_size * nUpperPart), psrc,
+            memmove(pdst + (field_size * nUpperPart), psrc,
                 field_size * (nRequest - nUpperPart));
-    } else {
-        for (; nRequest > 0; nRequest--, pdst += field_size, offset += increment) {
-            offset %= no_elements;
-            memcpy(pdst, psrc + (offset * field_size), field_size);
+        return;
+    }
+
+    /* Copy runs of elements that don't wrap around the end */
+    while (nRequest > 0) {
+        long n = (no_elements - 1 - offset) / increment + 1;
+        long i;
+
+        if (n > nRequest)
+            n = nRequest;
+        psrc = (const char *) pfrom + offset * field_size;
+        switch (field_size) {
+        case 8:
+            COPY_STRIDED(epicsUInt64, pdst, psrc, n, increment);
+            break;
+        case 4:
+            COPY_STRIDED(epicsUInt32, pdst, psrc, n, increment);
+            break;
+        case 2:
+            COPY_STRIDED(epicsUInt16, pdst, psrc, n, increment);
+            break;
+        case 1:
+            COPY_STRIDED(epicsUInt8, pdst, psrc, n, increment);
+            break;
+        default:
+            for (i = 0; i < n; i++)
+                memmove(pdst + i * field_size,
+                    psrc + i * increment * field_size, field_size);
         }
+        pdst += n * field_size;
+        nRequest -= n;
+        offset = (offset + n * increment) % no_elements;
     }
 }
@@ -35,6 +35,9 @@ extern "C" {
  *
  * This function does not do any conversion on the array elements.
  *
+ * The target may be the same buffer as the source, to extract elements
+ * in place, as long as no wrap-around is needed.
+ *
  * Preconditions:
  *   nRequest >= 0, no_elements >= 0, increment > 0
  *   0 <= offset < no_elements
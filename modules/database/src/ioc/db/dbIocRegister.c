@@ -65,6 +65,40 @@ static void dbLoadRecordsCallFunc(const iocshArgBuf *args)
     iocshSetError(dbLoadRecords(args[0].sval,args[1].sval));
 }
 
+/* dbLoadRecordsWait */
+static const iocshFuncDef dbLoadRecordsWaitFuncDef = {
+    "dbLoadRecordsWait",
+    0,
+    NULL,
+    "Wait until all of the dbLoadRecords requests which were queued\n"
+    "while dbLoadRecordsParallel was set have been loaded.\n"
+    "This is done automatically by iocInit.\n",
+};
+static void dbLoadRecordsWaitCallFunc(const iocshArgBuf *args)
+{
+    iocshSetError(dbLoadRecordsWait());
+}
+
+/* dbLoadSnapshot */
+static const iocshArg dbLoadSnapshotArg0 = { "file name",iocshArgString};
+static const iocshArg * const dbLoadSnapshotArgs[1] = {&dbLoadSnapshotArg0};
+static const iocshFuncDef dbLoadSnapshotFuncDef = {
+    "dbLoadSnapshot",
+    1,
+    dbLoadSnapshotArgs,
+    "Load the records from the following dbLoadRecords commands together\n"
+    "at iocInit, using a binary snapshot file. If the snapshot was written\n"
+    "by the same dbLoadRecords commands and none of the files they read\n"
+    "have changed, the records are created from the snapshot without\n"
+    "parsing. Otherwise the files are loaded and a new snapshot written.\n"
+    "Must be used before the first dbLoadRecords.\n\n"
+    "Example: dbLoadSnapshot /var/tmp/myioc.dbsnap\n",
+};
+static void dbLoadSnapshotCallFunc(const iocshArgBuf *args)
+{
+    iocshSetError(dbLoadSnapshot(args[0].sval));
+}
+
 /* dbb */
 static const iocshArg dbbArg0 = { "record name",iocshArgString};
 static const iocshArg * const dbbArgs[1] = {&dbbArg0};
@@ -515,6 +549,8 @@ void dbIocRegister(void)
 
     iocshRegister(&dbLoadDatabaseFuncDef,dbLoadDatabaseCallFunc);
     iocshRegister(&dbLoadRecordsFuncDef,dbLoadRecordsCallFunc);
+    iocshRegister(&dbLoadRecordsWaitFuncDef,dbLoadRecordsWaitCallFunc);
+    iocshRegister(&dbLoadSnapshotFuncDef,dbLoadSnapshotCallFunc);
 
     iocshRegister(&dbaFuncDef,dbaCallFunc);
     iocshRegister(&dblFuncDef,dblCallFunc);
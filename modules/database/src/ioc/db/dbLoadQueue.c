@@ -0,0 +1,207 @@
+/*************************************************************************\
+* Copyright (c) 2009 UChicago Argonne LLC, as Operator of Argonne
+*     National Laboratory.
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * Parallel reading of database files before iocInit.
+ *
+ * The database parser is serially reusable, not reentrant, so records are
+ * still created one file at a time by the thread that called
+ * dbLoadRecords(). When dbLoadRecordsParallel is non-zero the slow part
+ * which doesn't touch pdbbase, reading each file and expanding its
+ * macros, is instead done by a pool of worker threads. The results are
+ * parsed strictly in the order that the requests were issued, so record
+ * creation, duplicate record and alias handling are unchanged.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "cantProceed.h"
+#include "ellLib.h"
+#include "epicsEvent.h"
+#include "epicsMutex.h"
+#include "epicsStdio.h"
+#include "epicsString.h"
+#include "epicsThread.h"
+#include "errlog.h"
+
+#include "dbAccessDefs.h"
+#include "dbStaticLib.h"
+#include "dbStaticPvt.h"
+#include "iocInit.h"
+#include "epicsExport.h"
+
+#include "dbLoadQueue.h"
+#include "dbSnapshot.h"
+
+/* Number of worker threads, zero disables parallel loading */
+int dbLoadRecordsParallel = 0;
+epicsExportAddress(int, dbLoadRecordsParallel);
+
+/* Limits the memory used by files that have been read but not parsed */
+#define MAX_QUEUED 256
+
+typedef struct loadRequest {
+    ELLNODE node;
+    char *file;
+    char *subs;
+    dbStagedInput *pstaged;
+    int staged;
+} loadRequest;
+
+static struct {
+    epicsMutexId lock;
+    epicsEventId stagedEvent;   /* a worker has finished a request */
+    ELLLIST requests;           /* in issue order, not yet parsed */
+    loadRequest *pnext;         /* the next request to be read */
+    int nWorkers;
+    int status;                 /* first failure since the last wait */
+} loadQueue;
+
+static epicsThreadOnceId loadQueueOnce = EPICS_THREAD_ONCE_INIT;
+
+static void loadQueueInit(void *unused)
+{
+    loadQueue.lock = epicsMutexMustCreate();
+    loadQueue.stagedEvent = epicsEventMustCreate(epicsEventEmpty);
+    ellInit(&loadQueue.requests);
+}
+
+static void loadWorker(void *unused)
+{
+    epicsMutexMustLock(loadQueue.lock);
+    while (loadQueue.pnext) {
+        loadRequest *preq = loadQueue.pnext;
+
+        loadQueue.pnext = (loadRequest *) ellNext(&preq->node);
+        epicsMutexUnlock(loadQueue.lock);
+
+        dbStageRead(preq->pstaged);
+
+        epicsMutexMustLock(loadQueue.lock);
+        preq->staged = 1;
+        epicsEventSignal(loadQueue.stagedEvent);
+    }
+    loadQueue.nWorkers--;
+    epicsMutexUnlock(loadQueue.lock);
+}
+
+/* Parse requests at the head of the queue. If all is false only those
+ * which have already been read are parsed, unless too many are queued.
+ */
+static void loadQueueDrain(int all)
+{
+    loadRequest *preq;
+
+    epicsMutexMustLock(loadQueue.lock);
+    while ((preq = (loadRequest *) ellFirst(&loadQueue.requests))) {
+        int status;
+
+        if (!preq->staged) {
+            if (!all && ellCount(&loadQueue.requests) <= MAX_QUEUED)
+                break;
+            epicsMutexUnlock(loadQueue.lock);
+            epicsEventMustWait(loadQueue.stagedEvent);
+            epicsMutexMustLock(loadQueue.lock);
+            continue;
+        }
+        ellDelete(&loadQueue.requests, &preq->node);
+        epicsMutexUnlock(loadQueue.lock);
+
+        status = dbReadDatabaseStaged(&pdbbase, preq->pstaged);
+        if (!status) {
+            if (dbLoadRecordsHook)
+                dbLoadRecordsHook(preq->file, preq->subs);
+        }
+        else {
+            errlogPrintf("dbLoadRecords: failed to load '%s'\n", preq->file);
+        }
+        dbStageFree(preq->pstaged);
+        free(preq->file);
+        free(preq->subs);
+        free(preq);
+
+        epicsMutexMustLock(loadQueue.lock);
+        if (status && !loadQueue.status)
+            loadQueue.status = status;
+    }
+    epicsMutexUnlock(loadQueue.lock);
+}
+
+int dbLoadQueueEnabled(void)
+{
+    return dbLoadRecordsParallel > 0 && pdbbase &&
+        getIocState() == iocVoid;
+}
+
+int dbLoadQueueAdd(const char *file, const char *subs)
+{
+    dbStagedInput *pstaged;
+    loadRequest *preq;
+    long status;
+
+    epicsThreadOnce(&loadQueueOnce, loadQueueInit, NULL);
+
+    status = dbStageDatabase(pdbbase, file, subs, &pstaged);
+    if (status) {
+        errlogPrintf("dbLoadRecords: failed to load '%s'\n", file);
+        return status;
+    }
+
+    preq = callocMustSucceed(1, sizeof(*preq), "dbLoadQueueAdd");
+    preq->file = epicsStrDup(file);
+    preq->subs = subs ? epicsStrDup(subs) : NULL;
+    preq->pstaged = pstaged;
+
+    epicsMutexMustLock(loadQueue.lock);
+    ellAdd(&loadQueue.requests, &preq->node);
+    if (!loadQueue.pnext)
+        loadQueue.pnext = preq;
+    if (loadQueue.nWorkers < dbLoadRecordsParallel) {
+        char name[20];
+
+        epicsSnprintf(name, sizeof(name), "dbLoad%d", loadQueue.nWorkers);
+        if (epicsThreadCreate(name, epicsThreadGetPrioritySelf(),
+                epicsThreadGetStackSize(epicsThreadStackMedium),
+                loadWorker, NULL))
+            loadQueue.nWorkers++;
+    }
+    if (loadQueue.nWorkers == 0) {
+        /* read it here if no worker could be started */
+        loadQueue.pnext = (loadRequest *) ellNext(&preq->node);
+        epicsMutexUnlock(loadQueue.lock);
+        dbStageRead(pstaged);
+        epicsMutexMustLock(loadQueue.lock);
+        preq->staged = 1;
+    }
+    epicsMutexUnlock(loadQueue.lock);
+
+    /* Parse what is ready while the workers read ahead */
+    loadQueueDrain(0);
+    return 0;
+}
+
+void dbLoadQueueFlush(void)
+{
+    epicsThreadOnce(&loadQueueOnce, loadQueueInit, NULL);
+    loadQueueDrain(1);
+}
+
+int dbLoadRecordsWait(void)
+{
+    int status = dbSnapshotFlush();
+
+    dbLoadQueueFlush();
+
+    epicsMutexMustLock(loadQueue.lock);
+    if (!status)
+        status = loadQueue.status;
+    loadQueue.status = 0;
+    epicsMutexUnlock(loadQueue.lock);
+    return status;
+}
@@ -0,0 +1,33 @@
+/*************************************************************************\
+* Copyright (c) 2009 UChicago Argonne LLC, as Operator of Argonne
+*     National Laboratory.
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/* dbLoadQueue.h - queue of dbLoadRecords() requests read in parallel */
+
+#ifndef INC_dbLoadQueue_H
+#define INC_dbLoadQueue_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Returns non-zero if dbLoadRecords() should queue the request */
+int dbLoadQueueEnabled(void);
+
+/* Queue a request. Fails immediately if the file can't be opened,
+ * otherwise returns 0 and reports any later failure when it is parsed.
+ */
+int dbLoadQueueAdd(const char *file, const char *subs);
+
+/* Parse all queued requests */
+void dbLoadQueueFlush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_dbLoadQueue_H */
@@ -56,6 +56,12 @@ static epicsMutexId lockSetsGuard;
 static size_t recomputeCnt;
 #endif
 
+/* Set from dbLockInitRecords() until dbLockComputeSets().
+ * While iocInit resolves links each record keeps its own lockSet, and
+ * dbLockSetMerge() only joins the union-find trees of the lockRecords.
+ */
+static int lockSetsPending;
+
 /*private routines */
 static void dbLockOnce(void* ignore)
 {
@@ -520,6 +526,8 @@ static int createLockRecord(void* junk, DBENTRY* pdbentry)
         cantProceed("no memory for spinlock in lockRecord");
 
     lrec->precord = prec;
+    lrec->parent = lrec;
+    lrec->size = 1;
 
     prec->lset = lrec;
 
@@ -532,8 +540,60 @@ void dbLockInitRecords(dbBase *pdbbase)
 {
     epicsThreadOnce(&dbLockOnceInit, &dbLockOnce, NULL);
 
-    /* create all lockRecords and lockSets */
+    /* create all lockRecords and lockSets.
+     * lockSets are joined by dbLockComputeSets()
+     */
     forEachRecord(NULL, pdbbase, &createLockRecord);
+    lockSetsPending = 1;
+}
+
+static lockRecord* findRoot(lockRecord *lr)
+{
+    lockRecord *root = lr;
+
+    while(root->parent!=root)
+        root = root->parent;
+
+    /* path compression */
+    while(lr->parent!=root) {
+        lockRecord *next = lr->parent;
+        lr->parent = root;
+        lr = next;
+    }
+    return root;
+}
+
+static int computeLockSet(void* junk, DBENTRY* pdbentry)
+{
+    dbCommon *prec = pdbentry->precnode->precord;
+    lockRecord *lr = prec->lset;
+    lockSet *A = findRoot(lr)->plockSet,
+            *B = lr->plockSet;
+
+    if(A==B)
+        return 0; /* the root keeps its own lockSet */
+
+    /* move from its own lockSet to that of the root */
+    ellDelete(&B->lockRecordList, &lr->node);
+    ellAdd(&A->lockRecordList, &lr->node);
+    dbLockIncRef(A);
+
+    epicsSpinLock(lr->spin);
+    lr->plockSet = A;
+    epicsSpinUnlock(lr->spin);
+
+    dbLockDecRef(B);
+    return 0;
+}
+
+void dbLockComputeSets(dbBase *pdbbase)
+{
+    if(!lockSetsPending)
+        return;
+
+    /* merge the lockSets of each tree of records joined by DB links */
+    forEachRecord(NULL, pdbbase, &computeLockSet);
+    lockSetsPending = 0;
 }
 
 static int freeLockRecord(void* junk, DBENTRY* pdbentry)
@@ -563,6 +623,7 @@ void dbLockCleanupRecords(dbBase *pdbbase)
     epicsThreadOnce(&dbLockOnceInit, &dbLockOnce, NULL);
 
     forEachRecord(NULL, pdbbase, &freeLockRecord);
+    lockSetsPending = 0;
     if(ellCount(&lockSetsActive)) {
         printf("Warning: dbLockCleanupRecords() leaking lockSets\n");
         dblsr(NULL,2);
@@ -581,8 +642,9 @@ void dbLockCleanupRecords(dbBase *pdbbase)
 }
 
 /* Called in two modes.
- * During dbLockInitRecords w/ locker==NULL, then no mutex are locked.
- * After dbLockInitRecords w/ locker!=NULL, then
+ * Between dbLockInitRecords and dbLockComputeSets w/ locker==NULL,
+ * then no mutex are locked, and only the union-find trees are joined.
+ * After dbLockComputeSets w/ locker!=NULL, then
  * the caller must lock both pfirst and psecond.
  *
  * Assumes that pfirst has been modified
@@ -591,13 +653,32 @@ void dbLockCleanupRecords(dbBase *pdbbase)
 void dbLockSetMerge(dbLocker *locker, dbCommon *pfirst, dbCommon *psecond)
 {
     ELLNODE *cur;
-    lockSet *A=pfirst->lset->plockSet,
-            *B=psecond->lset->plockSet;
+    lockSet *A, *B;
     int Nb;
 #ifdef LOCKSET_DEBUG
     const epicsThreadId myself = epicsThreadGetIdSelf();
 #endif
 
+    if(lockSetsPending) {
+        lockRecord *ra = findRoot(pfirst->lset),
+                   *rb = findRoot(psecond->lset);
+
+        assert(!locker);
+        if(ra==rb)
+            return;
+        /* union by size keeps the trees shallow */
+        if(ra->size < rb->size) {
+            lockRecord *tmp = ra;
+            ra = rb;
+            rb = tmp;
+        }
+        rb->parent = ra;
+        ra->size += rb->size;
+        return;
+    }
+
+    A=pfirst->lset->plockSet;
+    B=psecond->lset->plockSet;
     assert(A && B);
 
 #ifdef LOCKSET_DEBUG
@@ -618,6 +699,15 @@ void dbLockSetMerge(dbLocker *locker, dbCommon *pfirst, dbCommon *psecond)
     if(A==B)
         return; /* already in the same lockSet */
 
+    /* Move the records of the smaller set, so linking a record
+     * to a large lockSet doesn't visit every member of that set.
+     */
+    if(ellCount(&A->lockRecordList) < ellCount(&B->lockRecordList)) {
+        lockSet *tmp = A;
+        A = B;
+        B = tmp;
+    }
+
     Nb = ellCount(&B->lockRecordList);
     assert(Nb>0);
 
@@ -668,9 +758,95 @@ void dbLockSetMerge(dbLocker *locker, dbCommon *pfirst, dbCommon *psecond)
 
     dbLockDecRef(B); /* last ref we hold */
 
+    assert(A==pfirst->lset->plockSet);
     assert(A==psecond->lset->plockSet);
 }
 
+/* State of one side of the search in dbLockSetSplit() */
+typedef struct {
+    unsigned int side;  /* compflag value of records found by this side */
+    ELLLIST toInspect;  /* found, links not yet followed */
+    ELLLIST visited;    /* found, links followed */
+} lockSearch;
+
+/* Queue a record reached by a link.
+ * Returns non-zero if the other side of the search already found it.
+ */
+static int searchRecord(lockSearch *search, lockRecord *lr)
+{
+    if(lr->compflag)
+        return lr->compflag!=search->side;
+
+    ellAdd(&search->toInspect, &lr->compnode);
+    lr->compflag = search->side;
+    return 0;
+}
+
+/* Follow all links originating from and terminating at the next queued
+ * record.  Returns 1 if the other side of the search is reached,
+ * -1 if this side has found all records connected to its start,
+ * or 0 to continue.
+ */
+static int searchStep(lockSearch *search)
+{
+    ELLNODE *cur = ellGet(&search->toInspect);
+    lockRecord *lr;
+    dbCommon *prec;
+    dbRecordType *rtype;
+    size_t i;
+    ELLNODE *bcur;
+
+    if(!cur)
+        return -1;
+
+    ellAdd(&search->visited, cur);
+    lr = CONTAINER(cur, lockRecord, compnode);
+    prec = lr->precord;
+    rtype = prec->rdes;
+
+    /* Visit all the links originating from prec */
+    for(i=0; i<rtype->no_links; i++) {
+        dbFldDes *pdesc = rtype->papFldDes[rtype->link_ind[i]];
+        DBLINK *plink = (DBLINK*)((char*)prec + pdesc->offset);
+        dbChannel *chan;
+        lockRecord *target;
+
+        if(plink->type!=DB_LINK)
+            continue;
+
+        chan = plink->value.pv_link.pvt;
+        target = dbChannelRecord(chan)->lset;
+        assert(target);
+
+        if(searchRecord(search, target))
+            return 1;
+    }
+
+    /* Visit all links terminating at prec */
+    for(bcur=ellFirst(&prec->bklnk); bcur; bcur=ellNext(bcur))
+    {
+        struct pv_link *plink1 = CONTAINER(bcur, struct pv_link, backlinknode);
+        union value *plink2 = CONTAINER(plink1, union value, pv_link);
+        DBLINK *plink = CONTAINER(plink2, DBLINK, value);
+
+        /* plink->type==DB_LINK is implied.  Only DB_LINKs are tracked from BKLNK */
+
+        if(searchRecord(search, plink->precord->lset))
+            return 1;
+    }
+    return 0;
+}
+
+static void searchReset(ELLLIST *list)
+{
+    ELLNODE *cur;
+    while((cur=ellGet(list))!=NULL)
+    {
+        lockRecord *lr=CONTAINER(cur,lockRecord,compnode);
+        lr->compflag = 0;
+    }
+}
+
 /* recompute assuming a link from pfirst to psecond
  * may have been removed.
  * pfirst and psecond must currently be in the same lockset,
@@ -681,7 +857,9 @@ void dbLockSetMerge(dbLocker *locker, dbCommon *pfirst, dbCommon *psecond)
 void dbLockSetSplit(dbLocker *locker, dbCommon *pfirst, dbCommon *psecond)
 {
     lockSet *ls = pfirst->lset->plockSet;
-    ELLLIST toInspect, newLS;
+    lockSearch search[2];
+    ELLLIST *newLS = NULL;
+    int s, found = 0;
 #ifdef LOCKSET_DEBUG
     const epicsThreadId myself = epicsThreadGetIdSelf();
 #endif
@@ -712,94 +890,50 @@ void dbLockSetSplit(dbLocker *locker, dbCommon *pfirst, dbCommon *psecond)
      */
     assert(epicsAtomicGetIntT(&ls->refcount)>=ellCount(&ls->lockRecordList)+1);
 
-    ellInit(&toInspect);
-    ellInit(&newLS);
-
-    /* strategy is to start with psecond and do
-     * a breadth first traversal until all records are
-     * visited.  If we encounter pfirst, then there
-     * is no need to create a new lockset so we abort
-     * early.
+    /* strategy is to do two breadth first traversals, one starting
+     * with psecond and the other with pfirst, taking one step from
+     * each in turn.  If the two meet there is no need to create a new
+     * lockset, so we abort early.  If one side runs out of records
+     * first, then it has found all of a new lockset.  Either way the
+     * work done is bounded by the smaller part, not by the size of
+     * the original lockset.
      */
-    ellAdd(&toInspect, &psecond->lset->compnode);
-    psecond->lset->compflag = 1;
+    for(s=0; s<2; s++) {
+        search[s].side = s+1;
+        ellInit(&search[s].toInspect);
+        ellInit(&search[s].visited);
+    }
+    searchRecord(&search[0], psecond->lset);
+    searchRecord(&search[1], pfirst->lset);
+
+    while(!found) {
+        for(s=0; s<2; s++) {
+            found = searchStep(&search[s]);
+            if(found==1)
+                goto nosplit;
+            if(found) {
+                newLS = &search[s].visited;
+                break;
+            }
+        }
+    }
 
     {
         lockSet *splitset;
         ELLNODE *cur;
-        while((cur=ellGet(&toInspect))!=NULL)
-        {
-            lockRecord *lr=CONTAINER(cur,lockRecord,compnode);
-            dbCommon *prec=lr->precord;
-            dbRecordType *rtype = prec->rdes;
-            size_t i;
-            ELLNODE *bcur;
-
-            ellAdd(&newLS, cur);
-            prec->lset->compflag = 2;
-
-            /* Visit all the links originating from prec */
-            for(i=0; i<rtype->no_links; i++) {
-                dbFldDes *pdesc = rtype->papFldDes[rtype->link_ind[i]];
-                DBLINK *plink = (DBLINK*)((char*)prec + pdesc->offset);
-                dbChannel *chan;
-                lockRecord *lr;
-
-                if(plink->type!=DB_LINK)
-                    continue;
-
-                chan = plink->value.pv_link.pvt;
-                lr = dbChannelRecord(chan)->lset;
-                assert(lr);
-
-                if(lr->precord==pfirst) {
-                    /* so pfirst is still reachable from psecond,
-                     * no new lock set should be created.
-                     */
-                    goto nosplit;
-                }
-
-                /* have we already visited this record? */
-                if(lr->compflag)
-                    continue;
-
-                ellAdd(&toInspect, &lr->compnode);
-                lr->compflag = 1;
-            }
-
-            /* Visit all links terminating at prec */
-            for(bcur=ellFirst(&prec->bklnk); bcur; bcur=ellNext(bcur))
-            {
-                struct pv_link *plink1 = CONTAINER(bcur, struct pv_link, backlinknode);
-                union value *plink2 = CONTAINER(plink1, union value, pv_link);
-                DBLINK *plink = CONTAINER(plink2, DBLINK, value);
-                lockRecord *lr = plink->precord->lset;
-
-                /* plink->type==DB_LINK is implied.  Only DB_LINKs are tracked from BKLNK */
 
-                if(lr->precord==pfirst) {
-                    goto nosplit;
-                }
-
-                if(lr->compflag)
-                    continue;
-
-                ellAdd(&toInspect, &lr->compnode);
-                lr->compflag = 1;
-            }
-        }
-        /* All links involving psecond were traversed without finding
-         * pfirst.  So we must create a new lockset.
-         * newLS contains the nodes which will
+        /* All links involving the records of one side were traversed
+         * without finding the other side.  So we must create a new
+         * lockset.  newLS contains the nodes which will
          * make up this new lockset.
          */
-        /* newLS will have at least psecond in it */
-        assert(ellCount(&newLS) > 0);
-        /* If we didn't find pfirst, then it must be in the
+        /* newLS will have at least psecond or pfirst in it */
+        assert(ellCount(newLS) > 0);
+        /* the other side must remain in the
          * original lockset, and not the new one
          */
-        assert(ellCount(&newLS) < ellCount(&ls->lockRecordList));
-        assert(ellCount(&newLS) < ls->refcount);
+        assert(ellCount(newLS) < ellCount(&ls->lockRecordList));
+        assert(ellCount(newLS) < ls->refcount);
 
         splitset = makeSet(); /* reference for locker->locked */
 
@@ -817,7 +951,7 @@ void dbLockSetSplit(dbLocker *locker, dbCommon *pfirst, dbCommon *psecond)
         assert(ls->ownercount==1);
 #endif
 
-        while((cur=ellGet(&newLS))!=NULL)
+        while((cur=ellGet(newLS))!=NULL)
         {
             lockRecord *lr=CONTAINER(cur,lockRecord,compnode);
 
@@ -847,33 +981,21 @@ void dbLockSetSplit(dbLocker *locker, dbCommon *pfirst, dbCommon *psecond)
 
         assert(splitset->refcount>=ellCount(&splitset->lockRecordList)+1);
 
-        assert(psecond->lset->plockSet==splitset);
+        assert(pfirst->lset->plockSet!=psecond->lset->plockSet);
 
-        /* must have refs from pfirst lockRecord,
+        /* must have refs from the remaining lockRecords,
          * and the locked list.
          */
         assert(epicsAtomicGetIntT(&ls->refcount)>=2);
-
-        return;
     }
 
 nosplit:
-    {
-        /* reset compflag for all nodes visited
-         * during the aborted search
-         */
-        ELLNODE *cur;
-        while((cur=ellGet(&toInspect))!=NULL)
-        {
-            lockRecord *lr=CONTAINER(cur,lockRecord,compnode);
-            lr->compflag = 0;
-        }
-        while((cur=ellGet(&newLS))!=NULL)
-        {
-            lockRecord *lr=CONTAINER(cur,lockRecord,compnode);
-            lr->compflag = 0;
-        }
-        return;
+    /* reset compflag for all nodes visited
+     * during the search
+     */
+    for(s=0; s<2; s++) {
+        searchReset(&search[s].toInspect);
+        searchReset(&search[s].visited);
     }
 }
 
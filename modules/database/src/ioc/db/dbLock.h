@@ -42,6 +42,8 @@ DBCORE_API unsigned long dbLockGetLockId(
     struct dbCommon *precord);
 
 DBCORE_API void dbLockInitRecords(struct dbBase *pdbbase);
+/* Called by iocInit once all links have been resolved */
+DBCORE_API void dbLockComputeSets(struct dbBase *pdbbase);
 DBCORE_API void dbLockCleanupRecords(struct dbBase *pdbbase);
 
 
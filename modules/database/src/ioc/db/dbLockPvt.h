@@ -65,6 +65,12 @@ typedef struct lockRecord {
      */
     ELLNODE     compnode;
     unsigned int compflag;
+
+    /* union-find forest used to compute the lockSets during iocInit.
+     * Only valid until dbLockComputeSets() returns.
+     */
+    struct lockRecord *parent;
+    size_t      size;
 } lockRecord;
 
 typedef struct {
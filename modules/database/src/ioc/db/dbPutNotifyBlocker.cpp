@@ -73,6 +73,30 @@ void dbPutNotifyBlocker::cancel (
     this->block.signal ();
 }
 
+// Cancels a pending put notify, and tells its initiator that the
+// channel was destroyed, as the network client does.
+void dbPutNotifyBlocker::channelDeleteException (
+    CallbackGuard &, epicsGuard < epicsMutex > & guard )
+{
+    guard.assertIdenticalMutex ( this->mutex );
+    if ( this->pNotify ) {
+        {
+            epicsGuardRelease < epicsMutex > unguard ( guard );
+            dbNotifyCancel ( &this->pn );
+        }
+        // it may have completed while the lock was released
+        cacWriteNotify * const pNtfy = this->pNotify;
+        this->pNotify = 0;
+        this->block.signal ();
+        if ( pNtfy ) {
+            pNtfy->exception ( guard, ECA_CHANDESTROY,
+                dbChannelName ( this->pn.chan ),
+                static_cast < unsigned > ( this->dbrType ),
+                static_cast < unsigned > ( this->nRequest ) );
+        }
+    }
+}
+
 void dbPutNotifyBlocker::expandValueBuf (
     epicsGuard < epicsMutex > & guard, unsigned long newSize )
 {
@@ -28,6 +28,8 @@ public:
             cacWriteNotify &, struct dbChannel *,
             unsigned type, unsigned long count, const void * pValue );
     void cancel ( CallbackGuard &, epicsGuard < epicsMutex > & );
+    void channelDeleteException (
+        CallbackGuard &, epicsGuard < epicsMutex > & );
     void show ( epicsGuard < epicsMutex > &, unsigned level ) const;
     void show ( unsigned level ) const;
     void * operator new ( size_t size,
@@ -0,0 +1,794 @@
+/*************************************************************************\
+* Copyright (c) 2009 UChicago Argonne LLC, as Operator of Argonne
+*     National Laboratory.
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/*
+ * Binary snapshot of the records loaded by dbLoadRecords().
+ *
+ * After dbLoadSnapshot() the dbLoadRecords() requests are only recorded,
+ * and are loaded together by iocInit, dbLoadRecordsWait() or the next
+ * dbLoadDatabase(). If the snapshot file was written by an earlier boot
+ * which made the same requests with the same database definitions, none
+ * of the files that were read then have changed, and no file has appeared
+ * where the include path was searched without success, the records are
+ * created directly from the snapshot without parsing or macro expansion.
+ * Otherwise the requests are loaded as usual and a new snapshot written.
+ *
+ * A snapshot holds the non-default field values of each record as they
+ * are stored in the record, so it is only usable with the same record
+ * layout and byte order. A hash of the menu, record type and device
+ * definitions is part of the key.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "cantProceed.h"
+#include "dbDefs.h"
+#include "ellLib.h"
+#include "epicsStdio.h"
+#include "epicsString.h"
+#include "epicsTypes.h"
+#include "errlog.h"
+
+#include "dbAccessDefs.h"
+#include "dbBase.h"
+#include "dbStaticLib.h"
+#include "dbStaticPvt.h"
+#include "iocInit.h"
+#include "link.h"
+
+#include "dbLoadQueue.h"
+#include "dbSnapshot.h"
+
+static const char snapMagic[8] = {'E', 'P', 'I', 'C', 'S', 'd', 'b', 'S'};
+#define SNAP_VERSION 2
+#define SNAP_BYTE_ORDER 0x01020304u
+
+typedef struct snapRequest {
+    ELLNODE node;
+    char *file;
+    char *subs;
+    char *path;
+} snapRequest;
+
+typedef struct snapFile {
+    ELLNODE node;
+    char *name;
+    int found;
+} snapFile;
+
+static struct {
+    char *file;                 /* NULL unless dbLoadSnapshot() was called */
+    ELLLIST requests;           /* deferred dbLoadRecords() requests */
+    ELLLIST files;              /* files looked for while parsing them */
+} snapshot;
+
+typedef struct snapReader {
+    const char *pos;
+    const char *end;
+    int bad;
+} snapReader;
+
+enum snapPass {
+    snapCheck,                  /* only check the snapshot is well formed */
+    snapCreate,                 /* create records and most aliases */
+    snapAliases                 /* create aliases of later records */
+};
+
+
+/* Snapshot key */
+
+static void hashFile(FILE *fp, epicsUInt32 *psize, epicsUInt32 *phash)
+{
+    char buffer[8192];
+    size_t n, i;
+    epicsUInt32 size = 0;
+    epicsUInt32 hash0 = 0;
+    epicsUInt32 hash1 = 2166136261u;
+
+    while ((n = fread(buffer, 1, sizeof(buffer), fp)) > 0) {
+        size += n;
+        hash0 = epicsMemHash(buffer, n, hash0);
+        for (i = 0; i < n; i++) {
+            /* FNV-1a */
+            hash1 ^= (unsigned char) buffer[i];
+            hash1 *= 16777619u;
+        }
+    }
+    *psize = size;
+    phash[0] = hash0;
+    phash[1] = hash1;
+}
+
+static unsigned hashInt(int value, unsigned hash)
+{
+    return epicsMemHash((const char *) &value, sizeof(value), hash);
+}
+
+/* Changes if the menus, record types or device supports change */
+static epicsUInt32 definitionHash(DBBASE *pdbbase)
+{
+    ELLNODE *cur, *dev;
+    unsigned hash = 0;
+    int i;
+
+    for (cur = ellFirst(&pdbbase->menuList); cur; cur = ellNext(cur)) {
+        dbMenu *pmenu = CONTAINER(cur, dbMenu, node);
+
+        hash = epicsStrHash(pmenu->name, hash);
+        for (i = 0; i < pmenu->nChoice; i++)
+            hash = epicsStrHash(pmenu->papChoiceValue[i], hash);
+    }
+    for (cur = ellFirst(&pdbbase->recordTypeList); cur; cur = ellNext(cur)) {
+        dbRecordType *rtype = CONTAINER(cur, dbRecordType, node);
+
+        hash = epicsStrHash(rtype->name, hash);
+        hash = hashInt(rtype->rec_size, hash);
+        for (i = 0; i < rtype->no_fields; i++) {
+            dbFldDes *pflddes = rtype->papFldDes[i];
+
+            if (!pflddes)
+                continue;
+            hash = epicsStrHash(pflddes->name, hash);
+            hash = hashInt(pflddes->field_type, hash);
+            hash = hashInt(pflddes->size, hash);
+            hash = hashInt(pflddes->offset, hash);
+        }
+        for (dev = ellFirst(&rtype->devList); dev; dev = ellNext(dev)) {
+            devSup *pdevSup = CONTAINER(dev, devSup, node);
+
+            hash = epicsStrHash(pdevSup->choice, hash);
+        }
+    }
+    return hash;
+}
+
+/* Files which weren't found are remembered too, since one added there
+ * later would be read instead of a file further down the include path.
+ */
+static void snapshotOpenFile(const char *filename, int found)
+{
+    snapFile *pfile;
+
+    for (pfile = (snapFile *) ellFirst(&snapshot.files); pfile;
+         pfile = (snapFile *) ellNext(&pfile->node)) {
+        if (strcmp(pfile->name, filename) == 0) {
+            pfile->found |= found;
+            return;
+        }
+    }
+    pfile = callocMustSucceed(1, sizeof(*pfile), "dbLoadSnapshot");
+    pfile->name = epicsStrDup(filename);
+    pfile->found = found;
+    ellAdd(&snapshot.files, &pfile->node);
+}
+
+
+/* Writing */
+
+static void putU16(FILE *fp, epicsUInt16 value)
+{
+    fwrite(&value, sizeof(value), 1, fp);
+}
+
+static void putU32(FILE *fp, epicsUInt32 value)
+{
+    fwrite(&value, sizeof(value), 1, fp);
+}
+
+/* Length includes the nil, zero for NULL */
+static void putString(FILE *fp, const char *str)
+{
+    epicsUInt32 len = str ? (epicsUInt32) strlen(str) + 1 : 0;
+
+    putU32(fp, len);
+    if (len)
+        fwrite(str, 1, len, fp);
+}
+
+static void putRecord(FILE *fp, DBENTRY *pdbentry, dbRecordType *rtype,
+    dbRecordNode *precnode)
+{
+    dbInfoNode *pinfo;
+    int i;
+
+    putU16(fp, (epicsUInt16) precnode->flags);
+    putString(fp, precnode->recordname);
+    if (precnode->flags & DBRN_FLAGS_ISALIAS) {
+        putString(fp, precnode->aliasedRecnode->recordname);
+        return;
+    }
+
+    pdbentry->precordType = rtype;
+    pdbentry->precnode = precnode;
+    /* Field 0 is NAME, which dbCreateRecord() sets */
+    for (i = 1; i < rtype->no_fields; i++) {
+        dbFldDes *pflddes = rtype->papFldDes[i];
+        char *pfield;
+
+        if (!pflddes)
+            continue;
+        pfield = (char *) precnode->precord + pflddes->offset;
+
+        switch (pflddes->field_type) {
+        case DBF_NOACCESS:
+            continue;
+
+        case DBF_INLINK:
+        case DBF_OUTLINK:
+        case DBF_FWDLINK: {
+                const char *text = ((DBLINK *) pfield)->text;
+                const char *initial = pflddes->initial;
+
+                /* Links are still text, see dbPutString() */
+                if (text ? initial && strcmp(text, initial) == 0 : !initial)
+                    continue;
+                putU16(fp, (epicsUInt16) i);
+                putString(fp, text);
+            }
+            break;
+
+        default:
+            pdbentry->pflddes = pflddes;
+            pdbentry->pfield = pfield;
+            pdbentry->indfield = i;
+            if (dbIsDefaultValue(pdbentry))
+                continue;
+            putU16(fp, (epicsUInt16) i);
+            putU32(fp, pflddes->size);
+            fwrite(pfield, 1, pflddes->size, fp);
+        }
+    }
+    putU16(fp, 0);
+
+    for (pinfo = (dbInfoNode *) ellFirst(&precnode->infoList); pinfo;
+         pinfo = (dbInfoNode *) ellNext(&pinfo->node)) {
+        if (!pinfo->string)
+            continue;
+        putString(fp, pinfo->name);
+        putString(fp, pinfo->string);
+    }
+    putString(fp, NULL);
+}
+
+static int writeSnapshot(const char *filename)
+{
+    char *tmpname;
+    FILE *fp;
+    DBENTRY dbentry;
+    ELLNODE *cur, *rec;
+    snapRequest *preq;
+    snapFile *pfile;
+    int status = 0;
+
+    tmpname = mallocMustSucceed(strlen(filename) + 5, "dbLoadSnapshot");
+    strcpy(tmpname, filename);
+    strcat(tmpname, ".tmp");
+
+    fp = fopen(tmpname, "wb");
+    if (!fp) {
+        errlogPrintf("dbLoadSnapshot: Can't create '%s'\n", tmpname);
+        free(tmpname);
+        return -1;
+    }
+
+    fwrite(snapMagic, sizeof(snapMagic), 1, fp);
+    putU32(fp, SNAP_VERSION);
+    putU32(fp, SNAP_BYTE_ORDER);
+    putU32(fp, definitionHash(pdbbase));
+
+    putU32(fp, ellCount(&snapshot.requests));
+    for (preq = (snapRequest *) ellFirst(&snapshot.requests); preq;
+         preq = (snapRequest *) ellNext(&preq->node)) {
+        putString(fp, preq->file);
+        putString(fp, preq->subs);
+        putString(fp, preq->path);
+    }
+
+    putU32(fp, ellCount(&snapshot.files));
+    for (pfile = (snapFile *) ellFirst(&snapshot.files); pfile;
+         pfile = (snapFile *) ellNext(&pfile->node)) {
+        FILE *fpin;
+        epicsUInt32 size, hash[2];
+
+        putString(fp, pfile->name);
+        putU32(fp, pfile->found);
+        if (!pfile->found)
+            continue;
+        fpin = fopen(pfile->name, "rb");
+        if (!fpin) {
+            errlogPrintf("dbLoadSnapshot: Can't reopen '%s'\n", pfile->name);
+            status = -1;
+            break;
+        }
+        hashFile(fpin, &size, hash);
+        fclose(fpin);
+        putU32(fp, size);
+        putU32(fp, hash[0]);
+        putU32(fp, hash[1]);
+    }
+
+    dbInitEntry(pdbbase, &dbentry);
+    putU32(fp, ellCount(&pdbbase->recordTypeList));
+    for (cur = ellFirst(&pdbbase->recordTypeList); cur; cur = ellNext(cur)) {
+        dbRecordType *rtype = CONTAINER(cur, dbRecordType, node);
+
+        putU32(fp, ellCount(&rtype->recList));
+        for (rec = ellFirst(&rtype->recList); rec; rec = ellNext(rec))
+            putRecord(fp, &dbentry, rtype, CONTAINER(rec, dbRecordNode, node));
+    }
+    dbFinishEntry(&dbentry);
+
+    if (ferror(fp))
+        status = -1;
+    if (fclose(fp))
+        status = -1;
+
+    if (!status) {
+        remove(filename);
+        if (rename(tmpname, filename))
+            status = -1;
+    }
+    if (status) {
+        errlogPrintf("dbLoadSnapshot: Failed to write '%s'\n", filename);
+        remove(tmpname);
+    }
+    free(tmpname);
+    return status;
+}
+
+
+/* Reading */
+
+static char *readFile(const char *filename, size_t *psize)
+{
+    FILE *fp = fopen(filename, "rb");
+    char *buffer;
+    long size;
+
+    if (!fp)
+        return NULL;
+    if (fseek(fp, 0, SEEK_END) || (size = ftell(fp)) < 0 ||
+        fseek(fp, 0, SEEK_SET)) {
+        fclose(fp);
+        return NULL;
+    }
+    buffer = mallocMustSucceed(size ? size : 1, "dbLoadSnapshot");
+    if (fread(buffer, 1, size, fp) != (size_t) size) {
+        free(buffer);
+        fclose(fp);
+        return NULL;
+    }
+    fclose(fp);
+    *psize = size;
+    return buffer;
+}
+
+static const void *getBytes(snapReader *prd, size_t len)
+{
+    const char *p = prd->pos;
+
+    if (prd->bad || (size_t) (prd->end - p) < len) {
+        prd->bad = 1;
+        return NULL;
+    }
+    prd->pos += len;
+    return p;
+}
+
+static epicsUInt16 getU16(snapReader *prd)
+{
+    const void *p = getBytes(prd, sizeof(epicsUInt16));
+    epicsUInt16 value = 0;
+
+    if (p)
+        memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static epicsUInt32 getU32(snapReader *prd)
+{
+    const void *p = getBytes(prd, sizeof(epicsUInt32));
+    epicsUInt32 value = 0;
+
+    if (p)
+        memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+/* Strings are used in place, NULL on error */
+static const char *getString(snapReader *prd)
+{
+    epicsUInt32 len = getU32(prd);
+    const char *str;
+
+    if (!len)
+        return NULL;
+    str = getBytes(prd, len);
+    if (str && str[len - 1] != '\0') {
+        prd->bad = 1;
+        return NULL;
+    }
+    return str;
+}
+
+static int sameString(const char *a, const char *b)
+{
+    return a ? b && strcmp(a, b) == 0 : !b;
+}
+
+/* Returns non-zero if the snapshot matches the deferred requests */
+static int checkKey(snapReader *prd)
+{
+    const void *magic = getBytes(prd, sizeof(snapMagic));
+    snapRequest *preq;
+    epicsUInt32 nFiles;
+
+    if (!magic || memcmp(magic, snapMagic, sizeof(snapMagic)) != 0 ||
+        getU32(prd) != SNAP_VERSION ||
+        getU32(prd) != SNAP_BYTE_ORDER ||
+        getU32(prd) != definitionHash(pdbbase) ||
+        getU32(prd) != (epicsUInt32) ellCount(&snapshot.requests))
+        return 0;
+
+    for (preq = (snapRequest *) ellFirst(&snapshot.requests); preq;
+         preq = (snapRequest *) ellNext(&preq->node)) {
+        const char *file = getString(prd);
+        const char *subs = getString(prd);
+        const char *path = getString(prd);
+
+        if (prd->bad || !sameString(file, preq->file) ||
+            !sameString(subs, preq->subs) || !sameString(path, preq->path))
+            return 0;
+    }
+
+    nFiles = getU32(prd);
+    while (nFiles-- && !prd->bad) {
+        const char *name = getString(prd);
+        epicsUInt32 found = getU32(prd);
+        epicsUInt32 size, hash0, hash1;
+        epicsUInt32 nowSize, nowHash[2];
+        FILE *fp;
+
+        if (prd->bad || !name)
+            return 0;
+        if (!found) {
+            /* It would now be read instead of a later file */
+            if ((fp = fopen(name, "rb"))) {
+                fclose(fp);
+                return 0;
+            }
+            continue;
+        }
+        size = getU32(prd);
+        hash0 = getU32(prd);
+        hash1 = getU32(prd);
+        if (prd->bad || !(fp = fopen(name, "rb")))
+            return 0;
+        hashFile(fp, &nowSize, nowHash);
+        fclose(fp);
+        if (nowSize != size || nowHash[0] != hash0 || nowHash[1] != hash1)
+            return 0;
+    }
+    return !prd->bad;
+}
+
+static long getRecord(snapReader *prd, DBENTRY *pdbentry,
+    dbRecordType *rtype, enum snapPass pass, unsigned *pnRecords)
+{
+    epicsUInt16 flags = getU16(prd);
+    const char *name = getString(prd);
+    char *precord = NULL;
+    long status = 0;
+
+    if (!name) {
+        prd->bad = 1;
+        return 0;
+    }
+
+    if (flags & DBRN_FLAGS_ISALIAS) {
+        const char *target = getString(prd);
+
+        if (!target) {
+            prd->bad = 1;
+            return 0;
+        }
+        if (pass == snapCheck)
+            return 0;
+        if (pass == snapAliases && !dbFindRecord(pdbentry, name))
+            return 0;
+        status = dbFindRecord(pdbentry, target);
+        if (status && pass == snapCreate)
+            return 0; /* target is later in the list */
+        if (!status)
+            status = dbCreateAlias(pdbentry, name);
+        if (status)
+            errlogPrintf("dbLoadSnapshot: Can't create alias \"%s\" for \"%s\"\n",
+                name, target);
+        return status;
+    }
+
+    if (pass == snapCreate) {
+        pdbentry->precordType = rtype;
+        status = dbCreateRecord(pdbentry, name);
+        if (status) {
+            errlogPrintf("dbLoadSnapshot: Can't create record \"%s\"\n", name);
+        }
+        else {
+            precord = pdbentry->precnode->precord;
+            if (flags & DBRN_FLAGS_VISIBLE)
+                dbVisibleRecord(pdbentry);
+            ++*pnRecords;
+        }
+    }
+
+    for (;;) {
+        epicsUInt16 ind = getU16(prd);
+        dbFldDes *pflddes;
+
+        if (prd->bad || ind == 0)
+            break;
+        if (ind >= rtype->no_fields || !(pflddes = rtype->papFldDes[ind]) ||
+            pflddes->field_type == DBF_NOACCESS) {
+            prd->bad = 1;
+            break;
+        }
+
+        switch (pflddes->field_type) {
+        case DBF_INLINK:
+        case DBF_OUTLINK:
+        case DBF_FWDLINK: {
+                const char *text = getString(prd);
+
+                if (precord) {
+                    DBLINK *plink = (DBLINK *) (precord + pflddes->offset);
+
+                    free(plink->text);
+                    plink->text = text ? epicsStrDup(text) : NULL;
+                }
+            }
+            break;
+
+        default: {
+                epicsUInt32 len = getU32(prd);
+                const void *value = getBytes(prd, len);
+
+                if (len != (epicsUInt32) pflddes->size) {
+                    prd->bad = 1;
+                    break;
+                }
+                if (precord && value)
+                    memcpy(precord + pflddes->offset, value, len);
+            }
+        }
+    }
+
+    for (;;) {
+        const char *infoName = getString(prd);
+        const char *infoString;
+
+        if (!infoName)
+            break;
+        infoString = getString(prd);
+        if (precord && infoString)
+            dbPutInfo(pdbentry, infoName, infoString);
+    }
+    return status;
+}
+
+static long getRecords(snapReader *prd, enum snapPass pass,
+    unsigned *pnRecords)
+{
+    DBENTRY dbentry;
+    ELLNODE *cur;
+    long status = 0;
+
+    if (getU32(prd) != (epicsUInt32) ellCount(&pdbbase->recordTypeList)) {
+        prd->bad = 1;
+        return 0;
+    }
+
+    dbInitEntry(pdbbase, &dbentry);
+    for (cur = ellFirst(&pdbbase->recordTypeList); cur && !prd->bad;
+         cur = ellNext(cur)) {
+        dbRecordType *rtype = CONTAINER(cur, dbRecordType, node);
+        epicsUInt32 n = getU32(prd);
+
+        while (n-- && !prd->bad) {
+            long recStatus = getRecord(prd, &dbentry, rtype, pass, pnRecords);
+
+            if (recStatus && !status)
+                status = recStatus;
+        }
+    }
+    dbFinishEntry(&dbentry);
+    return status;
+}
+
+static int cmpRecordNode(const ELLNODE *lhs, const ELLNODE *rhs)
+{
+    dbRecordNode *LHS = (dbRecordNode *) lhs,
+                 *RHS = (dbRecordNode *) rhs;
+
+    return strcmp(LHS->recordname, RHS->recordname);
+}
+
+/* Returns -1 if the snapshot can't be used, otherwise the load status */
+static long loadSnapshot(const char *buffer, size_t size)
+{
+    snapReader rd, records;
+    unsigned nRecords = 0;
+    long status;
+    snapRequest *preq;
+
+    rd.pos = buffer;
+    rd.end = buffer + size;
+    rd.bad = 0;
+    if (!checkKey(&rd))
+        return -1;
+
+    records = rd;
+    getRecords(&records, snapCheck, &nRecords);
+    if (records.bad || records.pos != records.end) {
+        errlogPrintf("dbLoadSnapshot: '%s' is corrupt\n", snapshot.file);
+        return -1;
+    }
+
+    records = rd;
+    status = getRecords(&records, snapCreate, &nRecords);
+    records = rd;
+    if (!status)
+        status = getRecords(&records, snapAliases, &nRecords);
+
+    if (dbRecordsAbcSorted) {
+        ELLNODE *cur;
+
+        for (cur = ellFirst(&pdbbase->recordTypeList); cur; cur = ellNext(cur)) {
+            dbRecordType *rtype = CONTAINER(cur, dbRecordType, node);
+
+            ellSortStable(&rtype->recList, &cmpRecordNode);
+        }
+    }
+
+    if (status) {
+        errlogPrintf("dbLoadSnapshot: Failed to load '%s'\n", snapshot.file);
+        return status;
+    }
+
+    if (dbLoadRecordsHook) {
+        for (preq = (snapRequest *) ellFirst(&snapshot.requests); preq;
+             preq = (snapRequest *) ellNext(&preq->node))
+            dbLoadRecordsHook(preq->file, preq->subs);
+    }
+    printf("dbLoadSnapshot: Loaded %u records from '%s'\n",
+        nRecords, snapshot.file);
+    return 0;
+}
+
+static long loadRequests(void)
+{
+    snapRequest *preq;
+    long status = 0;
+
+    dbOpenFileHook = snapshotOpenFile;
+    for (preq = (snapRequest *) ellFirst(&snapshot.requests); preq;
+         preq = (snapRequest *) ellNext(&preq->node)) {
+        long reqStatus = dbReadDatabase(&pdbbase, preq->file, preq->path,
+            preq->subs);
+
+        if (!reqStatus) {
+            if (dbLoadRecordsHook)
+                dbLoadRecordsHook(preq->file, preq->subs);
+        }
+        else {
+            errlogPrintf("dbLoadRecords: failed to load '%s'\n", preq->file);
+            if (!status)
+                status = reqStatus;
+        }
+    }
+    dbOpenFileHook = NULL;
+    return status;
+}
+
+static void snapshotFree(void)
+{
+    snapRequest *preq;
+    snapFile *pfile;
+
+    while ((preq = (snapRequest *) ellGet(&snapshot.requests))) {
+        free(preq->file);
+        free(preq->subs);
+        free(preq->path);
+        free(preq);
+    }
+    while ((pfile = (snapFile *) ellGet(&snapshot.files))) {
+        free(pfile->name);
+        free(pfile);
+    }
+    free(snapshot.file);
+    snapshot.file = NULL;
+}
+
+
+int dbSnapshotEnabled(void)
+{
+    return snapshot.file && pdbbase && getIocState() == iocVoid;
+}
+
+int dbSnapshotAdd(const char *file, const char *subs)
+{
+    snapRequest *preq = callocMustSucceed(1, sizeof(*preq), "dbSnapshotAdd");
+    const char *path = getenv("EPICS_DB_INCLUDE_PATH");
+
+    preq->file = epicsStrDup(file);
+    preq->subs = subs ? epicsStrDup(subs) : NULL;
+    preq->path = epicsStrDup(path ? path : ".");
+    ellAdd(&snapshot.requests, &preq->node);
+    return 0;
+}
+
+int dbSnapshotFlush(void)
+{
+    char *buffer;
+    size_t size;
+    long status = -1;
+
+    if (!snapshot.file || ellCount(&snapshot.requests) == 0)
+        return 0;
+
+    buffer = readFile(snapshot.file, &size);
+    if (buffer) {
+        status = loadSnapshot(buffer, size);
+        free(buffer);
+    }
+    if (status == -1) {
+        status = loadRequests();
+        if (!status && !writeSnapshot(snapshot.file))
+            printf("dbLoadSnapshot: Wrote '%s'\n", snapshot.file);
+    }
+
+    snapshotFree();
+    return status;
+}
+
+int dbLoadSnapshot(const char *file)
+{
+    ELLNODE *cur;
+
+    if (!file) {
+        printf("Usage: dbLoadSnapshot \"file\"\n");
+        return -1;
+    }
+    if (!pdbbase) {
+        errlogPrintf("dbLoadSnapshot: No database definitions loaded\n");
+        return -1;
+    }
+    if (getIocState() != iocVoid) {
+        errlogPrintf("dbLoadSnapshot: Can't be used after iocInit\n");
+        return -1;
+    }
+    if (snapshot.file) {
+        errlogPrintf("dbLoadSnapshot: Already using '%s'\n", snapshot.file);
+        return -1;
+    }
+
+    /* The snapshot replaces all of the records in pdbbase */
+    dbLoadQueueFlush();
+    for (cur = ellFirst(&pdbbase->recordTypeList); cur; cur = ellNext(cur)) {
+        dbRecordType *rtype = CONTAINER(cur, dbRecordType, node);
+
+        if (ellCount(&rtype->recList)) {
+            errlogPrintf("dbLoadSnapshot: Must be used before dbLoadRecords\n");
+            return -1;
+        }
+    }
+
+    snapshot.file = epicsStrDup(file);
+    return 0;
+}
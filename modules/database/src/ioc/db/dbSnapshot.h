@@ -0,0 +1,33 @@
+/*************************************************************************\
+* Copyright (c) 2009 UChicago Argonne LLC, as Operator of Argonne
+*     National Laboratory.
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/* dbSnapshot.h - binary snapshot of the records loaded by dbLoadRecords() */
+
+#ifndef INC_dbSnapshot_H
+#define INC_dbSnapshot_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Returns non-zero if dbLoadRecords() should defer the request */
+int dbSnapshotEnabled(void);
+
+/* Record a request, to be loaded by dbSnapshotFlush() */
+int dbSnapshotAdd(const char *file, const char *subs);
+
+/* Load the deferred requests, from the snapshot if it is up to date,
+ * otherwise by parsing the files and then writing a new snapshot.
+ */
+int dbSnapshotFlush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_dbSnapshot_H */
@@ -11,6 +11,7 @@
 /* database access test subroutines */
 
 #include <stddef.h>
+#include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 
@@ -33,6 +34,7 @@
 #include "dbFldTypes.h"
 #include "dbLock.h"
 #include "dbStaticLib.h"
+#include "dbStaticPvt.h"
 #include "dbTest.h"
 #include "devSup.h"
 #include "drvSup.h"
@@ -283,11 +285,20 @@ long dbli(const char *pattern)
     return 0;
 }
 
+static void dbgrepPrefix(PVDENTRY *ppvd, void *arg)
+{
+    const char *pname = ppvd->precnode->recordname;
+
+    if (epicsStrGlobMatch(pname, (const char *) arg))
+        puts(pname);
+}
+
 long dbgrep(const char *pmask)
 {
     DBENTRY dbentry;
     DBENTRY *pdbentry = &dbentry;
     long status;
+    size_t len;
 
     if (!pmask || !*pmask) {
         printf("Usage: dbgrep \"pattern\"\n");
@@ -299,6 +310,16 @@ long dbgrep(const char *pmask)
         return 0;
     }
 
+    /* Only names with the literal prefix of the pattern need checking */
+    len = strcspn(pmask, "*?[\\");
+    if (len > 0) {
+        char *prefix = epicsStrnDup(pmask, len);
+
+        dbPvdForEachPrefix(pdbbase, prefix, dbgrepPrefix, (void *) pmask);
+        free(prefix);
+        return 0;
+    }
+
     dbInitEntry(pdbbase, pdbentry);
     status = dbFirstRecordType(pdbentry);
     while (!status) {
@@ -0,0 +1,459 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/* dbArenaLib.c */
+
+/*
+ * Storage for the records, record nodes and info items of a database.
+ *
+ * Objects of one size come from a pool. Each record type has its own pool,
+ * so records of one type are laid out next to each other in large chunks,
+ * instead of being scattered over the heap by one calloc() each. Freed
+ * objects are kept on a list for reuse by the same pool.
+ *
+ * Alias names and info item strings are packed into blocks, in slots that
+ * are a multiple of STR_GRAIN bytes. Each string is preceded by the size
+ * of its slot, so a string that was shortened in place is still freed to
+ * the right list. Freed slots are kept on a list for each slot size and
+ * reused for strings that need the same size, so replacing info strings
+ * after loading doesn't keep growing the blocks. Strings too long to share
+ * a block are allocated from the heap and freed individually.
+ *
+ * All memory is returned to the heap when the database is freed.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "dbDefs.h"
+#include "ellLib.h"
+#include "epicsMutex.h"
+#include "epicsTypes.h"
+
+#include "dbBase.h"
+#include "dbStaticLib.h"
+#include "dbStaticPvt.h"
+
+/* Alignment of every object, enough for any field type */
+#define ALIGN 16
+#define ROUNDUP(n) (((n) + ALIGN - 1) & ~(size_t) (ALIGN - 1))
+
+#define MIN_SLOTS 8             /* objects in the first chunk of a pool */
+#define MAX_CHUNK (1 << 20)     /* chunks stop growing at this size */
+#define STRING_BLOCK (1 << 16)
+#define STR_LONG (STRING_BLOCK / 4) /* longer strings come from the heap */
+#define STR_GRAIN 8                 /* must hold a pointer */
+#define STR_HEADER sizeof(epicsUInt16) /* slot size / STR_GRAIN, 0 if long */
+#define STR_SIZE(len) \
+    (((len) + STR_HEADER + STR_GRAIN - 1) & ~(size_t) (STR_GRAIN - 1))
+#define STR_CLASSES (STR_SIZE(STR_LONG) / STR_GRAIN + 1)
+
+typedef struct dbArenaChunk {
+    struct dbArenaChunk *next;
+    size_t size;                /* bytes, including this header */
+} dbArenaChunk;
+
+#define CHUNK_HEADER ROUNDUP(sizeof(dbArenaChunk))
+
+typedef struct dbArenaPool {
+    ELLNODE node;
+    dbRecordType *precordType;  /* NULL unless this holds records */
+    const char *name;
+    size_t slotSize;
+    size_t chunkSlots;          /* size of the next chunk */
+    dbArenaChunk *chunks;
+    char *next;                 /* unused space in the newest chunk */
+    char *end;
+    void *freeList;             /* freed slots, linked through the slot */
+    void *prototype;            /* see dbArenaSetPrototype() */
+    size_t reserved;            /* bytes in chunks */
+    size_t inUse;               /* slots */
+    size_t freed;               /* slots on freeList */
+} dbArenaPool;
+
+typedef struct dbArena {
+    epicsMutexId lock;
+    ELLLIST recordPools;
+    dbArenaPool nodePool;       /* dbRecordNode */
+    dbArenaPool infoPool;       /* dbInfoNode */
+    dbArenaChunk *blocks;       /* strings */
+    char *next;
+    char *end;
+    char **freeStrings;         /* per slot size, allocated when needed */
+    ELLLIST longStrings;
+    size_t strReserved;
+    size_t strUsed;
+    size_t strFreed;
+} dbArena;
+
+static void poolInit(dbArenaPool *ppool, const char *name, size_t size)
+{
+    ppool->name = name;
+    ppool->slotSize = ROUNDUP(size);
+    ppool->chunkSlots = MIN_SLOTS;
+}
+
+static dbArena * dbArenaGet(dbBase *pdbbase)
+{
+    dbArena *parena = pdbbase->parena;
+
+    if (!parena) {
+        parena = dbCalloc(1, sizeof(dbArena));
+        parena->lock = epicsMutexMustCreate();
+        ellInit(&parena->recordPools);
+        ellInit(&parena->longStrings);
+        poolInit(&parena->nodePool, "record nodes", sizeof(dbRecordNode));
+        poolInit(&parena->infoPool, "info items", sizeof(dbInfoNode));
+        pdbbase->parena = parena;
+    }
+    return parena;
+}
+
+static dbArenaChunk * chunkAlloc(dbArenaChunk **pchunks, size_t size)
+{
+    dbArenaChunk *pchunk = dbCalloc(1, size);
+
+    pchunk->size = size;
+    pchunk->next = *pchunks;
+    *pchunks = pchunk;
+    return pchunk;
+}
+
+static void chunkFree(dbArenaChunk *pchunk)
+{
+    while (pchunk) {
+        dbArenaChunk *pnext = pchunk->next;
+
+        free(pchunk);
+        pchunk = pnext;
+    }
+}
+
+/* Caller must hold the lock */
+static void * poolAlloc(dbArenaPool *ppool)
+{
+    char *pslot;
+
+    if (ppool->freeList) {
+        pslot = ppool->freeList;
+        ppool->freeList = *(void **) pslot;
+        ppool->freed--;
+        memset(pslot, 0, ppool->slotSize);
+    }
+    else {
+        if (ppool->next == ppool->end) {
+            size_t size = CHUNK_HEADER + ppool->chunkSlots * ppool->slotSize;
+            dbArenaChunk *pchunk = chunkAlloc(&ppool->chunks, size);
+
+            ppool->next = (char *) pchunk + CHUNK_HEADER;
+            ppool->end = ppool->next + ppool->chunkSlots * ppool->slotSize;
+            ppool->reserved += size;
+            if (ppool->chunkSlots * ppool->slotSize < MAX_CHUNK)
+                ppool->chunkSlots *= 2;
+        }
+        pslot = ppool->next;
+        ppool->next += ppool->slotSize;
+    }
+    ppool->inUse++;
+    return pslot;
+}
+
+/* Caller must hold the lock */
+static void poolFree(dbArenaPool *ppool, void *pslot)
+{
+    *(void **) pslot = ppool->freeList;
+    ppool->freeList = pslot;
+    ppool->freed++;
+    ppool->inUse--;
+}
+
+void * dbArenaRecordAlloc(dbBase *pdbbase, dbRecordType *precordType,
+    size_t size)
+{
+    dbArena *parena = dbArenaGet(pdbbase);
+    dbArenaPool *ppool;
+    void *precord;
+
+    epicsMutexMustLock(parena->lock);
+    ppool = precordType->parena;
+    if (!ppool) {
+        ppool = dbCalloc(1, sizeof(dbArenaPool));
+        poolInit(ppool, precordType->name, size);
+        ppool->precordType = precordType;
+        ellAdd(&parena->recordPools, &ppool->node);
+        precordType->parena = ppool;
+    }
+    precord = poolAlloc(ppool);
+    epicsMutexUnlock(parena->lock);
+    return precord;
+}
+
+void * dbArenaGetPrototype(dbRecordType *precordType)
+{
+    dbArenaPool *ppool = precordType->parena;
+
+    return ppool ? ppool->prototype : NULL;
+}
+
+void * dbArenaSetPrototype(dbRecordType *precordType, const void *precord)
+{
+    dbArenaPool *ppool = precordType->parena;
+
+    if (!ppool || ppool->prototype) return NULL;
+    ppool->prototype = dbMalloc(ppool->slotSize);
+    memcpy(ppool->prototype, precord, ppool->slotSize);
+    return ppool->prototype;
+}
+
+void dbArenaRecordFree(dbBase *pdbbase, dbRecordType *precordType,
+    void *precord)
+{
+    dbArena *parena = pdbbase->parena;
+
+    epicsMutexMustLock(parena->lock);
+    poolFree(precordType->parena, precord);
+    epicsMutexUnlock(parena->lock);
+}
+
+dbRecordNode * dbArenaNodeAlloc(dbBase *pdbbase)
+{
+    dbArena *parena = dbArenaGet(pdbbase);
+    dbRecordNode *precnode;
+
+    epicsMutexMustLock(parena->lock);
+    precnode = poolAlloc(&parena->nodePool);
+    epicsMutexUnlock(parena->lock);
+    return precnode;
+}
+
+void dbArenaNodeFree(dbBase *pdbbase, dbRecordNode *precnode)
+{
+    dbArena *parena = pdbbase->parena;
+
+    epicsMutexMustLock(parena->lock);
+    poolFree(&parena->nodePool, precnode);
+    epicsMutexUnlock(parena->lock);
+}
+
+dbInfoNode * dbArenaInfoAlloc(dbBase *pdbbase)
+{
+    dbArena *parena = dbArenaGet(pdbbase);
+    dbInfoNode *pinfo;
+
+    epicsMutexMustLock(parena->lock);
+    pinfo = poolAlloc(&parena->infoPool);
+    epicsMutexUnlock(parena->lock);
+    return pinfo;
+}
+
+void dbArenaInfoFree(dbBase *pdbbase, dbInfoNode *pinfo)
+{
+    dbArena *parena = pdbbase->parena;
+
+    epicsMutexMustLock(parena->lock);
+    poolFree(&parena->infoPool, pinfo);
+    epicsMutexUnlock(parena->lock);
+}
+
+typedef struct dbArenaLongStr {
+    ELLNODE node;
+    size_t size;                /* bytes, including the header */
+} dbArenaLongStr;
+
+#define LONG_HEADER (sizeof(dbArenaLongStr) + STR_HEADER)
+
+/* Returns NULL if out of memory */
+char * dbArenaStrDup(dbBase *pdbbase, const char *str)
+{
+    dbArena *parena = dbArenaGet(pdbbase);
+    size_t len = strlen(str) + 1;
+    epicsUInt16 cls;
+    size_t size;
+    char *pslot;
+
+    if (len > STR_LONG) {
+        dbArenaLongStr *plong = malloc(LONG_HEADER + len);
+
+        if (!plong)
+            return NULL;
+        plong->size = LONG_HEADER + len;
+        pslot = (char *) plong + sizeof(dbArenaLongStr);
+        cls = 0;
+        memcpy(pslot, &cls, STR_HEADER);
+        memcpy(pslot + STR_HEADER, str, len);
+        epicsMutexMustLock(parena->lock);
+        ellAdd(&parena->longStrings, &plong->node);
+        parena->strReserved += plong->size;
+        parena->strUsed += plong->size;
+        epicsMutexUnlock(parena->lock);
+        return pslot + STR_HEADER;
+    }
+
+    size = STR_SIZE(len);
+    cls = (epicsUInt16) (size / STR_GRAIN);
+    epicsMutexMustLock(parena->lock);
+    if (parena->freeStrings && parena->freeStrings[cls]) {
+        pslot = parena->freeStrings[cls];
+        memcpy(&parena->freeStrings[cls], pslot, sizeof(char *));
+        parena->strFreed -= size;
+    }
+    else {
+        if ((size_t) (parena->end - parena->next) < size) {
+            /* the rest of the current block is lost */
+            dbArenaChunk *pchunk = malloc(STRING_BLOCK);
+
+            if (!pchunk) {
+                epicsMutexUnlock(parena->lock);
+                return NULL;
+            }
+            pchunk->size = STRING_BLOCK;
+            pchunk->next = parena->blocks;
+            parena->blocks = pchunk;
+            parena->strReserved += STRING_BLOCK;
+            parena->next = (char *) pchunk + CHUNK_HEADER;
+            parena->end = (char *) pchunk + STRING_BLOCK;
+        }
+        pslot = parena->next;
+        parena->next += size;
+    }
+    parena->strUsed += size;
+    memcpy(pslot, &cls, STR_HEADER);
+    memcpy(pslot + STR_HEADER, str, len);
+    epicsMutexUnlock(parena->lock);
+    return pslot + STR_HEADER;
+}
+
+void dbArenaStrFree(dbBase *pdbbase, char *str)
+{
+    dbArena *parena = pdbbase->parena;
+    char *pslot;
+    epicsUInt16 cls;
+    size_t size;
+
+    if (!str) return;
+    pslot = str - STR_HEADER;
+    memcpy(&cls, pslot, STR_HEADER);
+
+    if (!cls) {
+        dbArenaLongStr *plong =
+            (dbArenaLongStr *) (pslot - sizeof(dbArenaLongStr));
+
+        epicsMutexMustLock(parena->lock);
+        ellDelete(&parena->longStrings, &plong->node);
+        parena->strReserved -= plong->size;
+        parena->strUsed -= plong->size;
+        epicsMutexUnlock(parena->lock);
+        free(plong);
+        return;
+    }
+
+    size = (size_t) cls * STR_GRAIN;
+    epicsMutexMustLock(parena->lock);
+    if (!parena->freeStrings)
+        parena->freeStrings = dbCalloc(STR_CLASSES, sizeof(char *));
+    memcpy(pslot, &parena->freeStrings[cls], sizeof(char *));
+    parena->freeStrings[cls] = pslot;
+    parena->strUsed -= size;
+    parena->strFreed += size;
+    epicsMutexUnlock(parena->lock);
+}
+
+void dbArenaFreeMem(dbBase *pdbbase)
+{
+    dbArena *parena = pdbbase->parena;
+    dbArenaPool *ppool;
+
+    if (!parena) return;
+    pdbbase->parena = NULL;
+
+    while ((ppool = (dbArenaPool *) ellGet(&parena->recordPools))) {
+        if (ppool->precordType)
+            ppool->precordType->parena = NULL;
+        chunkFree(ppool->chunks);
+        free(ppool->prototype);
+        free(ppool);
+    }
+    chunkFree(parena->nodePool.chunks);
+    chunkFree(parena->infoPool.chunks);
+    chunkFree(parena->blocks);
+    ellFree(&parena->longStrings);
+    free(parena->freeStrings);
+    epicsMutexDestroy(parena->lock);
+    free(parena);
+}
+
+static double percent(size_t part, size_t whole)
+{
+    return whole ? 100.0 * part / whole : 0.0;
+}
+
+static void poolReport(const dbArenaPool *ppool, size_t *preserved,
+    size_t *pused)
+{
+    size_t used = ppool->inUse * ppool->slotSize;
+
+    printf("%-20s %9lu %9lu %12lu %12lu %6.1f%%\n", ppool->name,
+        (unsigned long) ppool->inUse, (unsigned long) ppool->slotSize,
+        (unsigned long) ppool->reserved, (unsigned long) used,
+        percent(ppool->reserved - used, ppool->reserved));
+    *preserved += ppool->reserved;
+    *pused += used;
+}
+
+void dbMemReport(dbBase *pdbbase, int level)
+{
+    dbArena *parena;
+    dbArenaPool *ppool;
+    size_t reserved = 0, used = 0;
+
+    if (!pdbbase) {
+        fprintf(stderr,"pdbbase not specified\n");
+        return;
+    }
+    parena = pdbbase->parena;
+    if (!parena) {
+        printf("No records loaded\n");
+        return;
+    }
+
+    epicsMutexMustLock(parena->lock);
+    printf("%-20s %9s %9s %12s %12s %7s\n", "Storage", "Objects",
+        "Bytes", "Reserved", "In use", "Unused");
+    for (ppool = (dbArenaPool *) ellFirst(&parena->recordPools); ppool;
+         ppool = (dbArenaPool *) ellNext(&ppool->node)) {
+        if (ppool->inUse || level > 0)
+            poolReport(ppool, &reserved, &used);
+        else {
+            reserved += ppool->reserved;
+        }
+    }
+    poolReport(&parena->nodePool, &reserved, &used);
+    poolReport(&parena->infoPool, &reserved, &used);
+    printf("%-20s %9s %9s %12lu %12lu %6.1f%%\n", "strings", "", "",
+        (unsigned long) parena->strReserved, (unsigned long) parena->strUsed,
+        percent(parena->strReserved - parena->strUsed, parena->strReserved));
+    reserved += parena->strReserved;
+    used += parena->strUsed;
+    printf("%-20s %9s %9s %12lu %12lu %6.1f%%\n", "Total", "", "",
+        (unsigned long) reserved, (unsigned long) used,
+        percent(reserved - used, reserved));
+
+    if (level > 0) {
+        size_t freedSlots = 0, freedBytes = 0;
+
+        for (ppool = (dbArenaPool *) ellFirst(&parena->recordPools); ppool;
+             ppool = (dbArenaPool *) ellNext(&ppool->node)) {
+            freedSlots += ppool->freed;
+            freedBytes += ppool->freed * ppool->slotSize;
+        }
+        printf("%lu deleted records (%lu bytes) and %lu bytes of deleted "
+            "strings waiting for reuse\n", (unsigned long) freedSlots,
+            (unsigned long) freedBytes, (unsigned long) parena->strFreed);
+    }
+    epicsMutexUnlock(parena->lock);
+}
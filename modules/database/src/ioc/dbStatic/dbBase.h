@@ -163,8 +163,11 @@ typedef struct dbRecordType {
     /*The following are only available on run time system*/
     rset            *prset;
     int             rec_size;       /*record size in bytes          */
+    struct dbArenaPool *parena;     /*record storage                */
 }dbRecordType;
 
+struct dbArena;         /* Contents private to dbArenaLib code */
+struct dbArenaPool;     /* Contents private to dbArenaLib code */
 struct dbPvd;           /* Contents private to dbPvdLib code */
 struct gphPvt;          /* Contents private to gpHashLib code */
 
@@ -181,6 +184,7 @@ typedef struct dbBase {
     ELLLIST         guiGroupList;
     void            *pathPvt;
     struct dbPvd    *ppvd;
+    struct dbArena  *parena;
     struct gphPvt   *pgpHash;
     short           ignoreMissingMenus;
     short           loadCdefs;
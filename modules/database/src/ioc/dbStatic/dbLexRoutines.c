@@ -18,11 +18,13 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "cantProceed.h"
 #include "dbDefs.h"
 #include "dbmf.h"
 #include "ellLib.h"
 #include "epicsPrint.h"
 #include "epicsString.h"
+#include "epicsTime.h"
 #include "errMdef.h"
 #include "freeList.h"
 #include "gpHash.h"
@@ -45,6 +47,7 @@ static long pvt_yy_parse(void);
 
 /*global declarations*/
 char *makeDbdDepends=0;
+DB_OPEN_FILE_HOOK dbOpenFileHook=0;
 
 int dbRecordsOnceOnly=0;
 epicsExportAddress(int,dbRecordsOnceOnly);
@@ -106,8 +109,57 @@ typedef struct inputFile{
     const char  *path;
     const char  *filename;
     FILE        *fp;
+    char        *text;
+    size_t      size;
+    size_t      next;
+    dbStagedInput *pstaged;
+    const macTemplate *ptemplate;
+    int         nextLine;
     int         line_num;
 }inputFile;
+
+/* Counters for each file loaded, shown by dbLoadStats() */
+typedef struct loadStats {
+    ELLNODE     node;
+    char        *filename;
+    unsigned long loads;
+    unsigned long records;
+    size_t      bytes;
+    double      seconds;
+}loadStats;
+static ELLLIST loadStatsList = ELLLIST_INIT;
+static loadStats *ploadStatsNow = NULL;
+
+/* Templates read while caching is enabled, so a file that gets loaded
+ * many times with different substitutions is only read once.
+ */
+typedef struct templateCacheEntry {
+    ELLNODE     node;
+    char        *filename;
+    char        *searchPath;
+    char        *path;
+    macTemplate *ptemplate;
+}templateCacheEntry;
+static ELLLIST templateCache = ELLLIST_INIT;
+static int templateCaching = 0;
+
+/* A file that has been read and macro expanded ahead of the parser.
+ * The text is stored as a sequence of the lines that db_yyinput would
+ * have read with fgets, each one preceded by a flag byte which is set
+ * if the line had undefined macros.
+ */
+struct dbStagedInput {
+    char        *filename;
+    char        *path;
+    char        *includePath;
+    char        *substitutions;
+    FILE        *fp;
+    char        *text;
+    size_t      size;
+    size_t      capacity;
+    size_t      next;
+    long        status;
+};
 static ELLLIST inputFileList = ELLLIST_INIT;
 
 static inputFile *pinputFileNow = NULL;
@@ -172,6 +224,8 @@ const char *dbOpenFile(DBBASE *pdbbase,const char *filename,FILE **fp)
         *fp = fopen(filename, "r");
         if (*fp && makeDbdDepends)
             fprintf(stdout, "%s:%s \n", makeDbdDepends, filename);
+        if (dbOpenFileHook)
+            dbOpenFileHook(filename, *fp != NULL);
         return 0;
     }
     pdbPathNode = (dbPathNode *)ellFirst(ppathList);
@@ -184,6 +238,8 @@ const char *dbOpenFile(DBBASE *pdbbase,const char *filename,FILE **fp)
         *fp = fopen(fullfilename, "r");
         if (*fp && makeDbdDepends)
             fprintf(stdout, "%s:%s \n", makeDbdDepends, fullfilename);
+        if (dbOpenFileHook)
+            dbOpenFileHook(fullfilename, *fp != NULL);
         free((void *)fullfilename);
         if (*fp) return pdbPathNode->directory;
         pdbPathNode = (dbPathNode *)ellNext(&pdbPathNode->node);
@@ -197,10 +253,11 @@ static void freeInputFileList(void)
     inputFile *pinputFileNow;
 
     while((pinputFileNow=(inputFile *)ellFirst(&inputFileList))) {
-        if(fclose(pinputFileNow->fp))
+        if(pinputFileNow->fp && fclose(pinputFileNow->fp))
             errPrintf(0,__FILE__, __LINE__,
                         "Closing file %s",pinputFileNow->filename);
         free((void *)pinputFileNow->filename);
+        free(pinputFileNow->text);
         ellDelete(&inputFileList,(ELLNODE *)pinputFileNow);
         free((void *)pinputFileNow);
     }
@@ -215,9 +272,151 @@ int cmp_dbRecordNode(const ELLNODE *lhs, const ELLNODE *rhs)
     return strcmp(LHS->recordname, RHS->recordname);
 }
 
+void dbTemplateCache(int enable)
+{
+    templateCacheEntry *pentry;
+
+    templateCaching = enable;
+    if (enable)
+        return;
+    while ((pentry = (templateCacheEntry *)ellGet(&templateCache))) {
+        macTemplateFree(pentry->ptemplate);
+        free(pentry->filename);
+        free(pentry->searchPath);
+        free(pentry->path);
+        free(pentry);
+    }
+}
+
+/* Find or read a template; dbPath() must already have been set */
+static templateCacheEntry *templateFind(const char *filename,
+    const char *searchPath)
+{
+    templateCacheEntry *pentry;
+    const char *path;
+    FILE *fp = NULL;
+
+    for (pentry = (templateCacheEntry *)ellFirst(&templateCache); pentry;
+         pentry = (templateCacheEntry *)ellNext(&pentry->node)) {
+        if (strcmp(pentry->filename, filename) == 0 &&
+            strcmp(pentry->searchPath, searchPath) == 0)
+            return pentry;
+    }
+
+    path = dbOpenFile(pdbbase, filename, &fp);
+    if (!fp)
+        return NULL;
+    pentry = dbCalloc(1, sizeof(templateCacheEntry));
+    pentry->ptemplate = macTemplateRead(fp, MY_BUFFER_SIZE);
+    fclose(fp);
+    if (!pentry->ptemplate) {
+        free(pentry);
+        return NULL;
+    }
+    pentry->filename = epicsStrDup(filename);
+    pentry->searchPath = epicsStrDup(searchPath);
+    if (path)
+        pentry->path = epicsStrDup(path);
+    ellAdd(&templateCache, &pentry->node);
+    return pentry;
+}
+
+/* Read the whole of a file into memory and close it. The lexer then
+ * takes its lines from the copy, which is much cheaper than calling
+ * fgets() for each one.
+ */
+static void inputFileRead(inputFile *pinputFile, FILE *fp)
+{
+    size_t capacity = 0x4000;
+    size_t n;
+
+    pinputFile->text = dbMalloc(capacity);
+    pinputFile->size = 0;
+    while ((n = fread(pinputFile->text + pinputFile->size, 1,
+                      capacity - pinputFile->size, fp)) > 0) {
+        pinputFile->size += n;
+        if (pinputFile->size == capacity) {
+            char *text = realloc(pinputFile->text, capacity *= 2);
+
+            if (!text)
+                cantProceed("inputFileRead: out of memory\n");
+            pinputFile->text = text;
+        }
+    }
+    if (ferror(fp))
+        errPrintf(0, __FILE__, __LINE__,
+            "Reading file %s", pinputFile->filename);
+    if (fclose(fp))
+        errPrintf(0, __FILE__, __LINE__,
+            "Closing file %s", pinputFile->filename);
+    pinputFile->next = 0;
+}
+
+/* Returns the next line of a file read by inputFileRead(), as fgets
+ * would have with a buffer of MY_BUFFER_SIZE
+ */
+static char *inputFileGets(inputFile *pinputFile, char *buf)
+{
+    const char *line = pinputFile->text + pinputFile->next;
+    size_t len = pinputFile->size - pinputFile->next;
+    const char *nl;
+
+    if (len == 0) return NULL;
+    if (len > MY_BUFFER_SIZE - 1)
+        len = MY_BUFFER_SIZE - 1;
+    nl = memchr(line, '\n', len);
+    if (nl)
+        len = nl - line + 1;
+    memcpy(buf, line, len);
+    buf[len] = '\0';
+    pinputFile->next += len;
+    return buf;
+}
+
+static loadStats *loadStatsFind(const char *filename)
+{
+    loadStats *pstats;
+
+    if (!filename)
+        filename = "standard input";
+    for (pstats = (loadStats *)ellLast(&loadStatsList); pstats;
+         pstats = (loadStats *)ellPrevious(&pstats->node)) {
+        if (strcmp(pstats->filename, filename) == 0)
+            return pstats;
+    }
+    pstats = dbCalloc(1, sizeof(loadStats));
+    pstats->filename = epicsStrDup(filename);
+    ellAdd(&loadStatsList, &pstats->node);
+    return pstats;
+}
+
+void dbLoadStats(void)
+{
+    loadStats *pstats;
+    unsigned long loads = 0, records = 0;
+    size_t bytes = 0;
+    double seconds = 0.0;
+
+    printf("%8s %10s %8s %9s  %s\n", "loads", "bytes", "records", "seconds",
+        "file");
+    for (pstats = (loadStats *)ellFirst(&loadStatsList); pstats;
+         pstats = (loadStats *)ellNext(&pstats->node)) {
+        printf("%8lu %10lu %8lu %9.3f  %s\n", pstats->loads,
+            (unsigned long)pstats->bytes, pstats->records,
+            pstats->seconds, pstats->filename);
+        loads += pstats->loads;
+        records += pstats->records;
+        bytes += pstats->bytes;
+        seconds += pstats->seconds;
+    }
+    printf("%8lu %10lu %8lu %9.3f  %s\n", loads, (unsigned long)bytes,
+        records, seconds, "total");
+}
+
 static long dbReadCOM(DBBASE **ppdbbase,const char *filename, FILE *fp,
-        const char *path,const char *substitutions)
+        const char *path,const char *substitutions,dbStagedInput *pstaged)
 {
+    epicsUInt64 start = epicsMonotonicGet();
     long        status;
     inputFile   *pinputFile = NULL;
     char        *penv;
@@ -234,16 +433,11 @@ static long dbReadCOM(DBBASE **ppdbbase,const char *filename, FILE *fp,
 
     if(*ppdbbase == 0) *ppdbbase = dbAllocBase();
     pdbbase = *ppdbbase;
-    if(path && strlen(path)>0) {
-        dbPath(pdbbase,path);
-    } else {
+    if(!path || strlen(path)==0) {
         penv = getenv("EPICS_DB_INCLUDE_PATH");
-        if(penv) {
-            dbPath(pdbbase,penv);
-        } else {
-            dbPath(pdbbase,".");
-        }
+        path = penv ? penv : ".";
     }
+    dbPath(pdbbase,path);
     my_buffer = dbCalloc(MY_BUFFER_SIZE,sizeof(char));
     freeListInitPvt(&freeListPvt,sizeof(tempListNode),100);
     if(substitutions) {
@@ -267,7 +461,24 @@ static long dbReadCOM(DBBASE **ppdbbase,const char *filename, FILE *fp,
     if (filename) {
         pinputFile->filename = macEnvExpand(filename);
     }
-    if (!fp) {
+    if (pstaged) {
+        pinputFile->filename = epicsStrDup(pstaged->filename);
+        pinputFile->path = pstaged->path;
+        pinputFile->pstaged = pstaged;
+    } else if (!fp && templateCaching && pinputFile->filename) {
+        templateCacheEntry *pentry = templateFind(pinputFile->filename, path);
+
+        if (!pentry) {
+            errPrintf(0, __FILE__, __LINE__,
+                "dbRead opening file %s\n",pinputFile->filename);
+            free((char*)pinputFile->filename);
+            free(pinputFile);
+            status = -1;
+            goto cleanup;
+        }
+        pinputFile->path = pentry->path;
+        pinputFile->ptemplate = pentry->ptemplate;
+    } else if (!fp) {
         FILE *fp1 = 0;
 
         if (pinputFile->filename)
@@ -280,7 +491,7 @@ static long dbReadCOM(DBBASE **ppdbbase,const char *filename, FILE *fp,
             status = -1;
             goto cleanup;
         }
-        pinputFile->fp = fp1;
+        inputFileRead(pinputFile, fp1);
     } else {
         pinputFile->fp = fp;
         fp = NULL;
@@ -290,6 +501,8 @@ static long dbReadCOM(DBBASE **ppdbbase,const char *filename, FILE *fp,
     my_buffer[0] = '\0';
     my_buffer_ptr = my_buffer;
     ellAdd(&inputFileList,&pinputFile->node);
+    ploadStatsNow = loadStatsFind(pinputFile->filename);
+    ploadStatsNow->loads++;
     status = pvt_yy_parse();
 
     if (ellCount(&tempList) && !yyAbort)
@@ -341,16 +554,155 @@ cleanup:
     freeInputFileList();
     if(fp)
         fclose(fp);
+    if(ploadStatsNow) {
+        ploadStatsNow->seconds += (epicsMonotonicGet() - start) * 1e-9;
+        ploadStatsNow = NULL;
+    }
     return(status);
 }
 
 long dbReadDatabase(DBBASE **ppdbbase,const char *filename,
         const char *path,const char *substitutions)
-{return (dbReadCOM(ppdbbase,filename,0,path,substitutions));}
+{return (dbReadCOM(ppdbbase,filename,0,path,substitutions,0));}
 
 long dbReadDatabaseFP(DBBASE **ppdbbase,FILE *fp,
         const char *path,const char *substitutions)
-{return (dbReadCOM(ppdbbase,0,fp,path,substitutions));}
+{return (dbReadCOM(ppdbbase,0,fp,path,substitutions,0));}
+
+long dbStageDatabase(DBBASE *pdbbase,const char *filename,
+        const char *substitutions,dbStagedInput **ppstaged)
+{
+    dbStagedInput *pstaged;
+    const char  *path;
+    char        *penv;
+
+    *ppstaged = NULL;
+    if (!pdbbase || !filename) return -1;
+    if (getIocState() != iocVoid) return -2;
+
+    pstaged = dbCalloc(1,sizeof(dbStagedInput));
+    penv = getenv("EPICS_DB_INCLUDE_PATH");
+    pstaged->includePath = epicsStrDup(penv ? penv : ".");
+    pstaged->filename = macEnvExpand(filename);
+    if (substitutions)
+        pstaged->substitutions = epicsStrDup(substitutions);
+
+    /* The file is found using the same search path as dbReadDatabase
+     * but is opened here so that the path list is only ever used by
+     * the thread that owns pdbbase.
+     */
+    dbPath(pdbbase,pstaged->includePath);
+    path = pstaged->filename ?
+        dbOpenFile(pdbbase,pstaged->filename,&pstaged->fp) : NULL;
+    if (path)
+        pstaged->path = epicsStrDup(path);
+    dbFreePath(pdbbase);
+    if (!pstaged->fp) {
+        errPrintf(0, __FILE__, __LINE__,
+            "dbRead opening file %s\n",pstaged->filename);
+        dbStageFree(pstaged);
+        return -1;
+    }
+    *ppstaged = pstaged;
+    return 0;
+}
+
+static void dbStageAppend(dbStagedInput *pstaged,int undefined,
+        const char *line)
+{
+    size_t  len = strlen(line) + 1;
+
+    if (pstaged->size + len + 1 > pstaged->capacity) {
+        size_t  capacity = pstaged->capacity ? pstaged->capacity : 0x4000;
+        char    *text;
+
+        while (pstaged->size + len + 1 > capacity)
+            capacity *= 2;
+        text = realloc(pstaged->text,capacity);
+        if (!text)
+            cantProceed("dbStageAppend: out of memory\n");
+        pstaged->text = text;
+        pstaged->capacity = capacity;
+    }
+    pstaged->text[pstaged->size++] = undefined ? 1 : 0;
+    memcpy(&pstaged->text[pstaged->size],line,len);
+    pstaged->size += len;
+}
+
+void dbStageRead(dbStagedInput *pstaged)
+{
+    MAC_HANDLE  *handle = NULL;
+    char        **macPairs;
+    char        *inBuf = dbCalloc(MY_BUFFER_SIZE,sizeof(char));
+    char        *outBuf = NULL;
+
+    if (pstaged->substitutions) {
+        if (macCreateHandle(&handle,NULL)) {
+            epicsPrintf("macCreateHandle error\n");
+            pstaged->status = -1;
+            goto cleanup;
+        }
+        macParseDefns(handle,pstaged->substitutions,&macPairs);
+        if (macPairs == NULL) {
+            macDeleteHandle(handle);
+            handle = NULL;
+        } else {
+            macInstallMacros(handle,macPairs);
+            free((void *)macPairs);
+            macSuppressWarning(handle,dbQuietMacroWarnings);
+            outBuf = dbCalloc(MY_BUFFER_SIZE,sizeof(char));
+        }
+    }
+    while (fgets(inBuf,MY_BUFFER_SIZE,pstaged->fp)) {
+        if (handle && strchr(inBuf,'$')) {
+            int exp = macExpandString(handle,inBuf,outBuf,MY_BUFFER_SIZE);
+
+            dbStageAppend(pstaged,exp < 0,outBuf);
+        } else {
+            dbStageAppend(pstaged,0,inBuf);
+        }
+    }
+cleanup:
+    if (fclose(pstaged->fp))
+        errPrintf(0,__FILE__, __LINE__,
+                        "Closing file %s",pstaged->filename);
+    pstaged->fp = NULL;
+    if (handle) macDeleteHandle(handle);
+    free(outBuf);
+    free(inBuf);
+}
+
+/* Returns the next line of a staged file, as fgets would have */
+static char *dbStageGets(dbStagedInput *pstaged,char *buf,int *pundefined)
+{
+    size_t  len;
+
+    if (pstaged->next >= pstaged->size) return NULL;
+    *pundefined = pstaged->text[pstaged->next++];
+    len = strlen(&pstaged->text[pstaged->next]) + 1;
+    memcpy(buf,&pstaged->text[pstaged->next],len);
+    pstaged->next += len;
+    return buf;
+}
+
+long dbReadDatabaseStaged(DBBASE **ppdbbase,dbStagedInput *pstaged)
+{
+    if (pstaged->status) return pstaged->status;
+    return dbReadCOM(ppdbbase,0,0,pstaged->includePath,
+        pstaged->substitutions,pstaged);
+}
+
+void dbStageFree(dbStagedInput *pstaged)
+{
+    if (!pstaged) return;
+    if (pstaged->fp) fclose(pstaged->fp);
+    free(pstaged->filename);
+    free(pstaged->path);
+    free(pstaged->includePath);
+    free(pstaged->substitutions);
+    free(pstaged->text);
+    free(pstaged);
+}
 
 static int db_yyinput(char *buf, int max_size)
 {
@@ -360,25 +712,59 @@ static int db_yyinput(char *buf, int max_size)
     if(yyAbort) return(0);
     if(*my_buffer_ptr==0) {
         while(TRUE) { /*until we get some input*/
-            if(macHandle) {
-                fgetsRtn = fgets(mac_input_buffer,MY_BUFFER_SIZE,
+            if(pinputFileNow->pstaged) {
+                int undefined = 0;
+
+                /* already macro expanded */
+                fgetsRtn = dbStageGets(pinputFileNow->pstaged,my_buffer,
+                    &undefined);
+                if (fgetsRtn && undefined) {
+                    fprintf(stderr, "Warning: '%s' line %d has undefined macros\n",
+                        pinputFileNow->filename, pinputFileNow->line_num+1);
+                }
+            } else if(pinputFileNow->ptemplate) {
+                const macTemplate *ptemplate = pinputFileNow->ptemplate;
+                int line = pinputFileNow->nextLine++;
+
+                fgetsRtn = NULL;
+                if (line < macTemplateLines(ptemplate)) {
+                    fgetsRtn = my_buffer;
+                    if (macHandle) {
+                        long exp = macTemplateExpandLine(macHandle,ptemplate,
+                            line,my_buffer,MY_BUFFER_SIZE);
+                        if (exp < 0) {
+                            fprintf(stderr, "Warning: '%s' line %d has undefined macros\n",
+                                pinputFileNow->filename, pinputFileNow->line_num+1);
+                        }
+                    } else {
+                        strcpy(my_buffer,macTemplateLine(ptemplate,line));
+                    }
+                }
+            } else {
+                if(pinputFileNow->fp)
+                    fgetsRtn = fgets(my_buffer,MY_BUFFER_SIZE,
                         pinputFileNow->fp);
-                if(fgetsRtn) {
-                    int exp = macExpandString(macHandle,mac_input_buffer,
+                else
+                    fgetsRtn = inputFileGets(pinputFileNow,my_buffer);
+                /* a line without a '$' can't have any macros in it */
+                if(fgetsRtn && macHandle && strchr(my_buffer,'$')) {
+                    int exp;
+
+                    strcpy(mac_input_buffer,my_buffer);
+                    exp = macExpandString(macHandle,mac_input_buffer,
                         my_buffer,MY_BUFFER_SIZE);
                     if (exp < 0) {
                         fprintf(stderr, "Warning: '%s' line %d has undefined macros\n",
                             pinputFileNow->filename, pinputFileNow->line_num+1);
                     }
                 }
-            } else {
-                fgetsRtn = fgets(my_buffer,MY_BUFFER_SIZE,pinputFileNow->fp);
             }
             if(fgetsRtn) break;
-            if(fclose(pinputFileNow->fp))
+            if(pinputFileNow->fp && fclose(pinputFileNow->fp))
                 errPrintf(0,__FILE__, __LINE__,
                         "Closing file %s",pinputFileNow->filename);
             free((void *)pinputFileNow->filename);
+            free(pinputFileNow->text);
             ellDelete(&inputFileList,(ELLNODE *)pinputFileNow);
             free((void *)pinputFileNow);
             pinputFileNow = (inputFile *)ellLast(&inputFileList);
@@ -386,6 +772,7 @@ static int db_yyinput(char *buf, int max_size)
         }
         if(dbStaticDebug) fprintf(stderr,"%s",my_buffer);
         pinputFileNow->line_num++;
+        if(ploadStatsNow) ploadStatsNow->bytes += strlen(my_buffer);
         my_buffer_ptr = &my_buffer[0];
     }
     l = strlen(my_buffer_ptr);
@@ -439,7 +826,7 @@ static void dbIncludeNew(char *filename)
         free((void *)pinputFile);
         return;
     }
-    pinputFile->fp = fp;
+    inputFileRead(pinputFile, fp);
     ellAdd(&inputFileList,&pinputFile->node);
     pinputFileNow = pinputFile;
 }
@@ -1153,11 +1540,134 @@ static void dbRecordHead(char *recordType, char *name, int visible)
                      name, recordType);
         yyerrorAbort(NULL);
     }
+    else if (ploadStatsNow) {
+        ploadStatsNow->records++;
+    }
 
     if (visible)
         dbVisibleRecord(pdbentry);
 }
 
+/* Memos of field lookups and converted field values.
+ * The instances of a template set the same fields of the same record types
+ * to the same values over and over, so each field name is only searched
+ * for once per record type, and each numeric or menu value only converted
+ * once per field. Both are direct mapped, a collision just replaces the
+ * older entry. They hold pointers into a dbBase, so dbFreeBase() must
+ * clear them.
+ */
+#define MEMO_SIZE 1024
+#define MEMO_NAME 16
+#define MEMO_VALUE 24
+
+typedef struct fieldMemo {
+    dbRecordType    *precordType;
+    short           indfield;
+    char            name[MEMO_NAME];
+}fieldMemo;
+
+typedef struct valueMemo {
+    dbFldDes        *pflddes;
+    int             strict;         /* dbConvertStrict when converted */
+    char            string[MEMO_VALUE];
+    union {
+        epicsUInt64     u64;
+        epicsFloat64    f64;
+        char            bytes[8];
+    } value;
+}valueMemo;
+
+static fieldMemo *pfieldMemo = NULL;
+static valueMemo *pvalueMemo = NULL;
+
+void dbLoadMemoClear(void)
+{
+    free(pfieldMemo);
+    free(pvalueMemo);
+    pfieldMemo = NULL;
+    pvalueMemo = NULL;
+}
+
+static long memoFindField(DBENTRY *pdbentry, const char *name)
+{
+    dbRecordType *precordType = pdbentry->precordType;
+    fieldMemo *pmemo;
+    long status;
+
+    if (strlen(name) >= MEMO_NAME)
+        return dbFindField(pdbentry, name);
+    if (!pfieldMemo)
+        pfieldMemo = dbCalloc(MEMO_SIZE, sizeof(fieldMemo));
+    pmemo = &pfieldMemo[epicsStrHash(name, (unsigned int) (size_t) precordType)
+        & (MEMO_SIZE - 1)];
+    if (pmemo->precordType == precordType && strcmp(pmemo->name, name) == 0) {
+        pdbentry->indfield = pmemo->indfield;
+        pdbentry->pflddes = precordType->papFldDes[pmemo->indfield];
+        return dbGetFieldAddress(pdbentry);
+    }
+
+    status = dbFindField(pdbentry, name);
+    /* record attributes are not in papFldDes */
+    if (!status &&
+        pdbentry->pflddes == precordType->papFldDes[pdbentry->indfield]) {
+        pmemo->precordType = precordType;
+        pmemo->indfield = pdbentry->indfield;
+        strcpy(pmemo->name, name);
+    }
+    return status;
+}
+
+/* Only fields which dbPutStringNum() converts have memoized values. VAL is
+ * left out since dbPutString() also clears UDF when it is set.
+ */
+static valueMemo * memoValueSlot(DBENTRY *pdbentry, const char *value)
+{
+    dbFldDes *pflddes = pdbentry->pflddes;
+
+    if (!pdbentry->pfield || pflddes->size > 8 ||
+        strlen(value) >= MEMO_VALUE || strcmp(pflddes->name, "VAL") == 0)
+        return NULL;
+    switch (pflddes->field_type) {
+    case DBF_CHAR: case DBF_UCHAR:
+    case DBF_SHORT: case DBF_USHORT:
+    case DBF_LONG: case DBF_ULONG:
+    case DBF_INT64: case DBF_UINT64:
+    case DBF_FLOAT: case DBF_DOUBLE:
+    case DBF_ENUM: case DBF_MENU: case DBF_DEVICE:
+        break;
+    default:
+        return NULL;
+    }
+    if (!pvalueMemo)
+        pvalueMemo = dbCalloc(MEMO_SIZE, sizeof(valueMemo));
+    return &pvalueMemo[epicsStrHash(value, (unsigned int) (size_t) pflddes)
+        & (MEMO_SIZE - 1)];
+}
+
+static long memoPutString(DBENTRY *pdbentry, const char *value)
+{
+    valueMemo *pmemo = memoValueSlot(pdbentry, value);
+    long status;
+
+    if (!pmemo)
+        return dbPutString(pdbentry, value);
+    if (pmemo->pflddes == pdbentry->pflddes &&
+        pmemo->strict == dbConvertStrict &&
+        strcmp(pmemo->string, value) == 0) {
+        memcpy(pdbentry->pfield, pmemo->value.bytes, pdbentry->pflddes->size);
+        return 0;
+    }
+
+    status = dbPutString(pdbentry, value);
+    if (!status) {
+        pmemo->pflddes = pdbentry->pflddes;
+        pmemo->strict = dbConvertStrict;
+        strcpy(pmemo->string, value);
+        memcpy(pmemo->value.bytes, pdbentry->pfield, pdbentry->pflddes->size);
+    }
+    return status;
+}
+
 static void dbRecordField(char *name,char *value)
 {
     DBENTRY *pdbentry;
@@ -1167,7 +1677,7 @@ static void dbRecordField(char *name,char *value)
     if (duplicate) return;
     ptempListNode = (tempListNode *)ellFirst(&tempList);
     pdbentry = ptempListNode->item;
-    status = dbFindField(pdbentry,name);
+    status = memoFindField(pdbentry,name);
     if (status) {
         epicsPrintf("Record \"%s\" does not have a field \"%s\"\n",
             dbGetRecordName(pdbentry), name);
@@ -1188,7 +1698,7 @@ static void dbRecordField(char *name,char *value)
         dbTranslateEscape(value, value);    /* in-place; safe & legal */
     }
 
-    status = dbPutString(pdbentry,value);
+    status = memoPutString(pdbentry,value);
     if (status) {
         char msg[128];
 
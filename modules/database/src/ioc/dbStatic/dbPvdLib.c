@@ -10,13 +10,29 @@
 
 /* dbPvdLib.c */
 
+/*
+ * The process variable directory is an open addressing hash table with
+ * linear probing, which doubles in size when it becomes 3/4 full.
+ *
+ * Lookups take no lock. Changes are serialized by a mutex, and a new
+ * entry is only made visible after it has been written. A table which
+ * has been replaced by a larger one is never changed again and is kept
+ * until the directory is freed, so readers which are still using it are
+ * safe. Deleted entries are kept until then too, for the same reason.
+ * Deleting a record is still not safe while another thread may be using
+ * its record node, as before.
+ *
+ * A list of the entries sorted by name is built when needed for prefix
+ * searches, and discarded whenever the directory changes.
+ */
+
 #include <stddef.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 
 #include "dbDefs.h"
-#include "ellLib.h"
+#include "epicsAtomic.h"
 #include "epicsMutex.h"
 #include "epicsStdio.h"
 #include "epicsString.h"
@@ -25,22 +41,30 @@
 #include "dbStaticLib.h"
 #include "dbStaticPvt.h"
 
-typedef struct {
-    ELLLIST      list;
-    epicsMutexId lock;
-} dbPvdBucket;
-
-typedef struct dbPvd {
+typedef struct dbPvdTable {
+    struct dbPvdTable *retired; /* previous table, freed with the dbPvd */
     unsigned int size;
     unsigned int mask;
-    dbPvdBucket **buckets;
+    PVDENTRY *slots[1];         /* actually size */
+} dbPvdTable;
+
+typedef struct dbPvd {
+    dbPvdTable *table;          /* read without locking */
+    epicsMutexId lock;          /* serializes changes */
+    unsigned int count;         /* entries */
+    unsigned int used;          /* entries and deleted slots */
+    PVDENTRY **sorted;          /* by name, NULL if out of date */
+    PVDENTRY *retired;          /* deleted entries, freed with the dbPvd */
 } dbPvd;
 
+/* Marks a deleted slot, which lookups must probe past */
+static PVDENTRY deletedEntry;
+#define DELETED (&deletedEntry)
+
 unsigned int dbPvdHashTableSize = 0;
 
 #define MIN_SIZE 256
 #define DEFAULT_SIZE 512
-#define MAX_SIZE 65536
 
 
 int dbPvdTableSize(int size)
@@ -53,13 +77,20 @@ int dbPvdTableSize(int size)
     if (size < MIN_SIZE)
         size = MIN_SIZE;
 
-    if (size > MAX_SIZE)
-        size = MAX_SIZE;
-
     dbPvdHashTableSize = size;
     return 0;
 }
 
+static dbPvdTable * dbPvdTableAlloc(unsigned int size)
+{
+    dbPvdTable *ptable = dbCalloc(1,
+        offsetof(dbPvdTable, slots) + size * sizeof(PVDENTRY *));
+
+    ptable->size = size;
+    ptable->mask = size - 1;
+    return ptable;
+}
+
 void dbPvdInitPvt(dbBase *pdbbase)
 {
     dbPvd *ppvd;
@@ -70,10 +101,9 @@ void dbPvdInitPvt(dbBase *pdbbase)
         dbPvdHashTableSize = DEFAULT_SIZE;
     }
 
-    ppvd = (dbPvd *)dbMalloc(sizeof(dbPvd));
-    ppvd->size    = dbPvdHashTableSize;
-    ppvd->mask    = dbPvdHashTableSize - 1;
-    ppvd->buckets = dbCalloc(ppvd->size, sizeof(dbPvdBucket *));
+    ppvd = dbCalloc(1, sizeof(dbPvd));
+    ppvd->table = dbPvdTableAlloc(dbPvdHashTableSize);
+    ppvd->lock = epicsMutexMustCreate();
 
     pdbbase->ppvd = ppvd;
     return;
@@ -82,119 +112,229 @@ void dbPvdInitPvt(dbBase *pdbbase)
 PVDENTRY *dbPvdFind(dbBase *pdbbase, const char *name, size_t lenName)
 {
     dbPvd *ppvd = pdbbase->ppvd;
-    dbPvdBucket *pbucket;
+    unsigned int hash = epicsMemHash(name, lenName, 0);
+    dbPvdTable *ptable = ppvd->table;
+    unsigned int i;
     PVDENTRY *ppvdNode;
 
-    pbucket = ppvd->buckets[epicsMemHash(name, lenName, 0) & ppvd->mask];
-    if (pbucket == NULL) return NULL;
+    /* pairs with the write barrier in dbPvdAdd() */
+    epicsAtomicReadMemoryBarrier();
 
-    epicsMutexMustLock(pbucket->lock);
-    ppvdNode = (PVDENTRY *) ellFirst(&pbucket->list);
-    while (ppvdNode) {
-        const char *recordname = ppvdNode->precnode->recordname;
+    for (i = hash & ptable->mask; (ppvdNode = ptable->slots[i]) != NULL;
+         i = (i + 1) & ptable->mask) {
+        const char *recordname;
 
+        if (ppvdNode == DELETED || ppvdNode->hash != hash)
+            continue;
+        recordname = ppvdNode->precnode->recordname;
         if (strncmp(name, recordname, lenName) == 0 &&
-            strlen(recordname) == lenName)
-            break;
-        ppvdNode = (PVDENTRY *) ellNext((ELLNODE *)ppvdNode);
+            recordname[lenName] == '\0')
+            return ppvdNode;
     }
-    epicsMutexUnlock(pbucket->lock);
-    return ppvdNode;
+    return NULL;
+}
+
+/* Returns the slot for a new entry, the table must not be full */
+static unsigned int dbPvdFreeSlot(dbPvdTable *ptable, unsigned int hash)
+{
+    unsigned int i = hash & ptable->mask;
+
+    while (ptable->slots[i] && ptable->slots[i] != DELETED)
+        i = (i + 1) & ptable->mask;
+    return i;
 }
-
+
+/* Caller must hold the lock */
+static void dbPvdGrow(dbPvd *ppvd)
+{
+    dbPvdTable *pold = ppvd->table;
+    dbPvdTable *pnew;
+    unsigned int size = pold->size;
+    unsigned int h;
+
+    /* deleted slots are dropped, so this may not need to grow */
+    while (ppvd->count * 2 >= size)
+        size *= 2;
+
+    pnew = dbPvdTableAlloc(size);
+    for (h = 0; h < pold->size; h++) {
+        PVDENTRY *ppvdNode = pold->slots[h];
+
+        if (ppvdNode && ppvdNode != DELETED)
+            pnew->slots[dbPvdFreeSlot(pnew, ppvdNode->hash)] = ppvdNode;
+    }
+    pnew->retired = pold;
+    ppvd->used = ppvd->count;
+
+    epicsAtomicWriteMemoryBarrier();
+    ppvd->table = pnew;
+}
+
 PVDENTRY *dbPvdAdd(dbBase *pdbbase, dbRecordType *precordType,
     dbRecordNode *precnode)
 {
     dbPvd *ppvd = pdbbase->ppvd;
-    dbPvdBucket *pbucket;
+    dbPvdTable *ptable;
     PVDENTRY *ppvdNode;
     char *name = precnode->recordname;
-    unsigned int h;
-
-    h = epicsStrHash(name, 0) & ppvd->mask;
-    pbucket = ppvd->buckets[h];
-    if (pbucket == NULL) {
-        pbucket = dbCalloc(1, sizeof(dbPvdBucket));
-        ellInit(&pbucket->list);
-        pbucket->lock = epicsMutexCreate();
-        ppvd->buckets[h] = pbucket;
-    }
-
-    epicsMutexMustLock(pbucket->lock);
-    ppvdNode = (PVDENTRY *) ellFirst(&pbucket->list);
-    while (ppvdNode) {
-        if (strcmp(name, ppvdNode->precnode->recordname) == 0) {
-            epicsMutexUnlock(pbucket->lock);
+    unsigned int hash = epicsStrHash(name, 0);
+    unsigned int i;
+
+    epicsMutexMustLock(ppvd->lock);
+    ptable = ppvd->table;
+    for (i = hash & ptable->mask; (ppvdNode = ptable->slots[i]) != NULL;
+         i = (i + 1) & ptable->mask) {
+        if (ppvdNode != DELETED && ppvdNode->hash == hash &&
+            strcmp(name, ppvdNode->precnode->recordname) == 0) {
+            epicsMutexUnlock(ppvd->lock);
             return NULL;
         }
-        ppvdNode = (PVDENTRY *) ellNext((ELLNODE *)ppvdNode);
     }
+
     ppvdNode = dbCalloc(1, sizeof(PVDENTRY));
     ppvdNode->precordType = precordType;
     ppvdNode->precnode = precnode;
-    ellAdd(&pbucket->list, (ELLNODE *)ppvdNode);
-    epicsMutexUnlock(pbucket->lock);
+    ppvdNode->hash = hash;
+
+    if ((ppvd->used + 1) * 4 > ptable->size * 3) {
+        dbPvdGrow(ppvd);
+        ptable = ppvd->table;
+    }
+    i = dbPvdFreeSlot(ptable, hash);
+    if (!ptable->slots[i])
+        ppvd->used++;
+    epicsAtomicWriteMemoryBarrier();
+    ptable->slots[i] = ppvdNode;
+    ppvd->count++;
+
+    free(ppvd->sorted);
+    ppvd->sorted = NULL;
+    epicsMutexUnlock(ppvd->lock);
     return ppvdNode;
 }
 
 void dbPvdDelete(dbBase *pdbbase, dbRecordNode *precnode)
 {
     dbPvd *ppvd = pdbbase->ppvd;
-    dbPvdBucket *pbucket;
+    dbPvdTable *ptable;
     PVDENTRY *ppvdNode;
     char *name = precnode->recordname;
-
-    pbucket = ppvd->buckets[epicsStrHash(name, 0) & ppvd->mask];
-    if (pbucket == NULL) return;
-
-    epicsMutexMustLock(pbucket->lock);
-    ppvdNode = (PVDENTRY *) ellFirst(&pbucket->list);
-    while (ppvdNode) {
-        if (ppvdNode->precnode &&
+    unsigned int hash = epicsStrHash(name, 0);
+    unsigned int i;
+
+    epicsMutexMustLock(ppvd->lock);
+    ptable = ppvd->table;
+    for (i = hash & ptable->mask; (ppvdNode = ptable->slots[i]) != NULL;
+         i = (i + 1) & ptable->mask) {
+        if (ppvdNode != DELETED && ppvdNode->hash == hash &&
+            ppvdNode->precnode &&
             ppvdNode->precnode->recordname &&
             strcmp(name, ppvdNode->precnode->recordname) == 0) {
-            ellDelete(&pbucket->list, (ELLNODE *)ppvdNode);
-            free(ppvdNode);
+            ptable->slots[i] = DELETED;
+            ppvd->count--;
+            /* a lookup may still be looking at it */
+            ppvdNode->retired = ppvd->retired;
+            ppvd->retired = ppvdNode;
+            free(ppvd->sorted);
+            ppvd->sorted = NULL;
             break;
         }
-        ppvdNode = (PVDENTRY *) ellNext((ELLNODE *)ppvdNode);
     }
-    epicsMutexUnlock(pbucket->lock);
+    epicsMutexUnlock(ppvd->lock);
     return;
 }
 
 void dbPvdFreeMem(dbBase *pdbbase)
 {
     dbPvd *ppvd = pdbbase->ppvd;
+    dbPvdTable *ptable;
     unsigned int h;
 
     if (ppvd == NULL) return;
     pdbbase->ppvd = NULL;
 
-    for (h = 0; h < ppvd->size; h++) {
-        dbPvdBucket *pbucket = ppvd->buckets[h];
-        PVDENTRY *ppvdNode;
+    ptable = ppvd->table;
+    for (h = 0; h < ptable->size; h++) {
+        PVDENTRY *ppvdNode = ptable->slots[h];
 
-        if (pbucket == NULL) continue;
-        epicsMutexMustLock(pbucket->lock);
-        ppvd->buckets[h] = NULL;
-        while ((ppvdNode = (PVDENTRY *) ellFirst(&pbucket->list))) {
-            ellDelete(&pbucket->list, (ELLNODE *)ppvdNode);
+        if (ppvdNode && ppvdNode != DELETED)
             free(ppvdNode);
-        }
-        epicsMutexUnlock(pbucket->lock);
-        epicsMutexDestroy(pbucket->lock);
-        free(pbucket);
     }
-    free(ppvd->buckets);
+    while (ptable) {
+        dbPvdTable *pretired = ptable->retired;
+
+        free(ptable);
+        ptable = pretired;
+    }
+    while (ppvd->retired) {
+        PVDENTRY *pretired = ppvd->retired->retired;
+
+        free(ppvd->retired);
+        ppvd->retired = pretired;
+    }
+    free(ppvd->sorted);
+    epicsMutexDestroy(ppvd->lock);
     free(ppvd);
 }
 
+static int dbPvdCompare(const void *lhs, const void *rhs)
+{
+    const PVDENTRY *LHS = *(const PVDENTRY * const *) lhs;
+    const PVDENTRY *RHS = *(const PVDENTRY * const *) rhs;
+
+    return strcmp(LHS->precnode->recordname, RHS->precnode->recordname);
+}
+
+void dbPvdForEachPrefix(dbBase *pdbbase, const char *prefix,
+    dbPvdFunc func, void *arg)
+{
+    dbPvd *ppvd = pdbbase->ppvd;
+    size_t len = strlen(prefix);
+    unsigned int lo, hi;
+
+    if (ppvd == NULL) return;
+
+    epicsMutexMustLock(ppvd->lock);
+    if (!ppvd->sorted && ppvd->count) {
+        dbPvdTable *ptable = ppvd->table;
+        unsigned int h, n = 0;
+
+        ppvd->sorted = dbMalloc(ppvd->count * sizeof(PVDENTRY *));
+        for (h = 0; h < ptable->size; h++) {
+            PVDENTRY *ppvdNode = ptable->slots[h];
+
+            if (ppvdNode && ppvdNode != DELETED)
+                ppvd->sorted[n++] = ppvdNode;
+        }
+        qsort(ppvd->sorted, n, sizeof(PVDENTRY *), dbPvdCompare);
+    }
+
+    /* find the first name not less than the prefix */
+    lo = 0;
+    hi = ppvd->count;
+    while (lo < hi) {
+        unsigned int mid = lo + (hi - lo) / 2;
+
+        if (strcmp(ppvd->sorted[mid]->precnode->recordname, prefix) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    for (; lo < ppvd->count; lo++) {
+        PVDENTRY *ppvdNode = ppvd->sorted[lo];
+
+        if (strncmp(ppvdNode->precnode->recordname, prefix, len) != 0)
+            break;
+        func(ppvdNode, arg);
+    }
+    epicsMutexUnlock(ppvd->lock);
+}
+
 void dbPvdDump(dbBase *pdbbase, int verbose)
 {
-    unsigned int empty = 0;
     dbPvd *ppvd;
-    unsigned int h;
+    dbPvdTable *ptable;
+    unsigned int h, deleted = 0, longest = 0, total = 0;
 
     if (!pdbbase) {
         fprintf(stderr,"pdbbase not specified\n");
@@ -203,27 +343,30 @@ void dbPvdDump(dbBase *pdbbase, int verbose)
     ppvd = pdbbase->ppvd;
     if (ppvd == NULL) return;
 
-    printf("Process Variable Directory has %u buckets", ppvd->size);
+    epicsMutexMustLock(ppvd->lock);
+    ptable = ppvd->table;
+    printf("Process Variable Directory has %u slots, %u entries",
+        ptable->size, ppvd->count);
 
-    for (h = 0; h < ppvd->size; h++) {
-        dbPvdBucket *pbucket = ppvd->buckets[h];
-        PVDENTRY *ppvdNode;
-        int i = 1;
+    for (h = 0; h < ptable->size; h++) {
+        PVDENTRY *ppvdNode = ptable->slots[h];
+        unsigned int probes;
 
-        if (pbucket == NULL) {
-            empty++;
+        if (ppvdNode == NULL) continue;
+        if (ppvdNode == DELETED) {
+            deleted++;
             continue;
         }
-        epicsMutexMustLock(pbucket->lock);
-        ppvdNode = (PVDENTRY *) ellFirst(&pbucket->list);
-        printf("\n [%4u] %4d  ", h, ellCount(&pbucket->list));
-        while (ppvdNode && verbose) {
-            if (!(++i % 4))
-                printf("\n         ");
-            printf("  %s", ppvdNode->precnode->recordname);
-            ppvdNode = (PVDENTRY *) ellNext((ELLNODE*)ppvdNode);
-        }
-        epicsMutexUnlock(pbucket->lock);
+        /* number of slots a lookup of this name examines */
+        probes = ((h - ppvdNode->hash) & ptable->mask) + 1;
+        total += probes;
+        if (probes > longest)
+            longest = probes;
+        if (verbose)
+            printf("\n [%6u] %3u  %s", h, probes,
+                ppvdNode->precnode->recordname);
     }
-    printf("\n%u buckets empty.\n", empty);
+    printf("\n%u slots deleted, %.2f average and %u longest probes.\n",
+        deleted, ppvd->count ? (double) total / ppvd->count : 0.0, longest);
+    epicsMutexUnlock(ppvd->lock);
 }
@@ -173,8 +173,8 @@ static const iocshFuncDef dbPvdDumpFuncDef = {
     "dbPvdDump",
     2,
     dbPvdDumpArgs,
-    "Dump the various buckets of the process variable directory.\n"
-    "If verbose is greater than 0, also print the process variables in each bucket.\n"
+    "Show the size and probe lengths of the process variable directory.\n"
+    "If verbose is greater than 0, also print the process variable in each slot.\n"
     "Example: dbPvdDump pdbbase 1\n",
 };
 static void dbPvdDumpCallFunc(const iocshArgBuf *args)
@@ -182,6 +182,41 @@ static void dbPvdDumpCallFunc(const iocshArgBuf *args)
     dbPvdDump(*iocshPpdbbase,args[1].ival);
 }
 
+/* dbMemReport */
+static const iocshArg dbMemReportArg1 = { "level",iocshArgInt};
+static const iocshArg * const dbMemReportArgs[] = {
+    &argPdbbase,&dbMemReportArg1};
+static const iocshFuncDef dbMemReportFuncDef = {
+    "dbMemReport",
+    2,
+    dbMemReportArgs,
+    "Show the memory holding records, record nodes, info items and aliases.\n"
+    "For each record type this prints the number of records, the bytes per\n"
+    "record, and how much of the space reserved for them is unused.\n"
+    "If level is greater than 0, also show record types whose records have all\n"
+    "been deleted, and the space left by deleted records and strings.\n"
+    "Example: dbMemReport pdbbase 1\n",
+};
+static void dbMemReportCallFunc(const iocshArgBuf *args)
+{
+    dbMemReport(*iocshPpdbbase,args[1].ival);
+}
+
+/* dbLoadStats */
+static const iocshFuncDef dbLoadStatsFuncDef = {
+    "dbLoadStats",
+    0,
+    NULL,
+    "Show how long loading each .db and .dbd file has taken so far.\n"
+    "For each file this prints the number of times it was loaded, the number\n"
+    "of characters and records read from it and any files it includes, and\n"
+    "the time taken.\n",
+};
+static void dbLoadStatsCallFunc(const iocshArgBuf *args)
+{
+    dbLoadStats();
+}
+
 /* dbPvdTableSize */
 static const iocshArg dbPvdTableSizeArg0 = { "size",iocshArgInt};
 static const iocshArg * const dbPvdTableSizeArgs[1] =
@@ -190,9 +225,9 @@ static const iocshFuncDef dbPvdTableSizeFuncDef = {
     "dbPvdTableSize",
     1,
     dbPvdTableSizeArgs,
-    "Change the number of buckets in the process variable directory.\n\n"
-    "The process variable directory size should be set before loading the database.\n"
-    "The size of the process variable directory can automatically grow.\n"
+    "Change the initial size of the process variable directory.\n\n"
+    "The process variable directory grows automatically as records are loaded,\n"
+    "setting a larger size before loading the database avoids resizing it.\n"
     "The size must be a power of 2.\n\n"
     "Example: dbPvdTableSize 1024\n",
 };
@@ -232,6 +267,8 @@ void dbStaticIocRegister(void)
     iocshRegister(&dbDumpVariableFuncDef, dbDumpVariableCallFunc);
     iocshRegister(&dbDumpBreaktableFuncDef, dbDumpBreaktableCallFunc);
     iocshRegister(&dbPvdDumpFuncDef, dbPvdDumpCallFunc);
+    iocshRegister(&dbMemReportFuncDef, dbMemReportCallFunc);
+    iocshRegister(&dbLoadStatsFuncDef, dbLoadStatsCallFunc);
     iocshRegister(&dbPvdTableSizeFuncDef,dbPvdTableSizeCallFunc);
     iocshRegister(&dbReportDeviceConfigFuncDef, dbReportDeviceConfigCallFunc);
 }
@@ -459,6 +459,8 @@ void dbFreeBase(dbBase *pdbbase)
         status = dbNextRecordType(&dbentry);
     }
     dbFinishEntry(&dbentry);
+    dbArenaFreeMem(pdbbase);
+    dbLoadMemoClear();
     pdbRecordType = (dbRecordType *)ellFirst(&pdbbase->recordTypeList);
     while(pdbRecordType) {
         for(i=0; i<pdbRecordType->no_fields; i++) {
@@ -1435,7 +1437,7 @@ long dbCreateRecord(DBENTRY *pdbentry,const char *precordName)
     pdbentry->precordType = precordType;
     preclist = &precordType->recList;
     /* create a recNode */
-    pNewRecNode = dbCalloc(1,sizeof(dbRecordNode));
+    pNewRecNode = dbArenaNodeAlloc(pdbentry->pdbbase);
     /* create a new record of this record type */
     pdbentry->precnode = pNewRecNode;
     if((status = dbAllocRecord(pdbentry,precordName))) return(status);
@@ -1496,13 +1498,13 @@ long dbDeleteRecord(DBENTRY *pdbentry)
         dbDeleteInfo(pdbentry);
     }
     if (precnode->flags & DBRN_FLAGS_ISALIAS) {
-        free(precnode->recordname);
+        dbArenaStrFree(pdbbase, precnode->recordname);
         precordType->no_aliases--;
     } else {
         status = dbFreeRecord(pdbentry);
         if (status) return status;
     }
-    free(precnode);
+    dbArenaNodeFree(pdbbase, precnode);
     pdbentry->precnode = NULL;
     return 0;
 }
@@ -1668,8 +1670,12 @@ long dbCreateAlias(DBENTRY *pdbentry, const char *alias)
         return S_dbLib_recExists;
     dbFinishEntry(&tempEntry);
 
-    pnewnode = dbCalloc(1, sizeof(dbRecordNode));
-    pnewnode->recordname = epicsStrDup(alias);
+    pnewnode = dbArenaNodeAlloc(pdbentry->pdbbase);
+    pnewnode->recordname = dbArenaStrDup(pdbentry->pdbbase, alias);
+    if (!pnewnode->recordname) {
+        dbArenaNodeFree(pdbentry->pdbbase, pnewnode);
+        return S_dbLib_outMem;
+    }
     pnewnode->precord = precnode->precord;
     pnewnode->aliasedRecnode = precnode;
     pnewnode->flags = DBRN_FLAGS_ISALIAS;
@@ -2936,9 +2942,9 @@ long dbDeleteInfo(DBENTRY *pdbentry)
     if (!precnode) return (S_dbLib_recNotFound);
     if (!pinfo) return (S_dbLib_infoNotFound);
     ellDelete(&precnode->infoList,&pinfo->node);
-    free(pinfo->name);
-    free(pinfo->string);
-    free(pinfo);
+    dbArenaStrFree(pdbentry->pdbbase, pinfo->name);
+    dbArenaStrFree(pdbentry->pdbbase, pinfo->string);
+    dbArenaInfoFree(pdbentry->pdbbase, pinfo);
     pdbentry->pinfonode = NULL;
     return (0);
 }
@@ -2960,12 +2966,16 @@ const char * dbGetInfoString(DBENTRY *pdbentry)
 long dbPutInfoString(DBENTRY *pdbentry,const char *string)
 {
     dbInfoNode *pinfo = pdbentry->pinfonode;
-    char *newstring;
+    char *old;
     if (!pinfo) return (S_dbLib_infoNotFound);
-    newstring = realloc(pinfo->string,1+strlen(string));
-    if (!newstring) return (S_dbLib_outMem);
-    strcpy(newstring, string);
-    pinfo->string = newstring;
+    /* string may be the old value, so copy it before freeing that */
+    old = pinfo->string;
+    pinfo->string = dbArenaStrDup(pdbentry->pdbbase, string);
+    if (!pinfo->string) {
+        pinfo->string = old;
+        return (S_dbLib_outMem);
+    }
+    dbArenaStrFree(pdbentry->pdbbase, old);
     return (0);
 }
 
@@ -3001,21 +3011,15 @@ long dbPutInfo(DBENTRY *pdbentry,const char *name,const char *string)
     if (pinfo) return (dbPutInfoString(pdbentry, string));
 
     /*Create new info node*/
-    pinfo = calloc(1,sizeof(dbInfoNode));
-    if (!pinfo) return (S_dbLib_outMem);
-    pinfo->name = calloc(1,1+strlen(name));
-    if (!pinfo->name) {
-        free(pinfo);
-        return (S_dbLib_outMem);
-    }
-    strcpy(pinfo->name, name);
-    pinfo->string = calloc(1,1+strlen(string));
-    if (!pinfo->string) {
-        free(pinfo->name);
-        free(pinfo);
+    pinfo = dbArenaInfoAlloc(pdbentry->pdbbase);
+    pinfo->name = dbArenaStrDup(pdbentry->pdbbase, name);
+    pinfo->string = dbArenaStrDup(pdbentry->pdbbase, string);
+    if (!pinfo->name || !pinfo->string) {
+        dbArenaStrFree(pdbentry->pdbbase, pinfo->name);
+        dbArenaStrFree(pdbentry->pdbbase, pinfo->string);
+        dbArenaInfoFree(pdbentry->pdbbase, pinfo);
         return (S_dbLib_outMem);
     }
-    strcpy(pinfo->string, string);
     ellAdd(&precnode->infoList,&pinfo->node);
     pdbentry->pinfonode = pinfo;
     return (0);
@@ -46,6 +46,37 @@ void dbPutStringSuggest(DBENTRY *pdbentry, const char *pstring);
 DBCORE_API
 const char *dbOpenFile(DBBASE *pdbbase,const char *filename,FILE **fp);
 
+/* Called with the name of every file that dbOpenFile() tries to open,
+ * and whether it was found.
+ */
+typedef void (*DB_OPEN_FILE_HOOK)(const char *filename, int found);
+DBCORE_API extern DB_OPEN_FILE_HOOK dbOpenFileHook;
+
+DBCORE_API extern int dbRecordsAbcSorted;
+
+/* Reading a database file ahead of the parser.
+ * dbStageDatabase() resolves and opens the file and must be called by the
+ * thread which owns pdbbase. dbStageRead() reads and macro expands the
+ * file, and may be called by any thread. dbReadDatabaseStaged() parses
+ * the result into pdbbase just as dbReadDatabase() would have.
+ */
+typedef struct dbStagedInput dbStagedInput;
+DBCORE_API long dbStageDatabase(DBBASE *pdbbase,const char *filename,
+    const char *substitutions,dbStagedInput **ppstaged);
+DBCORE_API void dbStageRead(dbStagedInput *pstaged);
+DBCORE_API long dbReadDatabaseStaged(DBBASE **ppdbbase,
+    dbStagedInput *pstaged);
+DBCORE_API void dbStageFree(dbStagedInput *pstaged);
+
+/* While template caching is enabled, dbReadDatabase() reads and scans
+ * each named file only once and expands the stored lines on later loads.
+ * Disabling it frees the cache.
+ */
+DBCORE_API void dbTemplateCache(int enable);
+
+/* Forget the field lookups memoized while loading records */
+void dbLoadMemoClear(void);
+
 struct jlink;
 
 typedef struct dbLinkInfo {
@@ -102,18 +133,46 @@ typedef struct dbGuiGroup {
 
 /*The following are in dbPvdLib.c*/
 /*directory*/
-typedef struct{
-    ELLNODE         node;
+typedef struct pvdEntry{
     dbRecordType    *precordType;
     dbRecordNode    *precnode;
+    unsigned int    hash;           /* epicsStrHash() of the name */
+    struct pvdEntry *retired;       /* next deleted entry */
 }PVDENTRY;
 DBCORE_API int dbPvdTableSize(int size);
 extern int dbStaticDebug;
 void dbPvdInitPvt(DBBASE *pdbbase);
-PVDENTRY *dbPvdFind(DBBASE *pdbbase,const char *name,size_t lenname);
-PVDENTRY *dbPvdAdd(DBBASE *pdbbase,dbRecordType *precordType,dbRecordNode *precnode);
-void dbPvdDelete(DBBASE *pdbbase,dbRecordNode *precnode);
+/* dbPvdFind() takes no lock and may be called at any time */
+DBCORE_API PVDENTRY *dbPvdFind(DBBASE *pdbbase,const char *name,size_t lenname);
+DBCORE_API PVDENTRY *dbPvdAdd(DBBASE *pdbbase,dbRecordType *precordType,dbRecordNode *precnode);
+DBCORE_API void dbPvdDelete(DBBASE *pdbbase,dbRecordNode *precnode);
 void dbPvdFreeMem(DBBASE *pdbbase);
+/* Call func for each entry whose name starts with prefix, in name order.
+ * The directory is locked, so func must not add or delete records.
+ */
+typedef void (*dbPvdFunc)(PVDENTRY *ppvd, void *arg);
+DBCORE_API void dbPvdForEachPrefix(DBBASE *pdbbase, const char *prefix,
+    dbPvdFunc func, void *arg);
+
+/*The following are in dbArenaLib.c*/
+/* Records, record nodes and info items are carved from large chunks, and
+ * alias names and info strings are packed into blocks. Each must be freed
+ * by the matching routine below, never by free().
+ */
+void *dbArenaRecordAlloc(DBBASE *pdbbase,dbRecordType *precordType,size_t size);
+void dbArenaRecordFree(DBBASE *pdbbase,dbRecordType *precordType,void *precord);
+/* A copy of a freshly initialized record, which dbAllocRecord() uses to
+ * initialize the next records of the same type.
+ */
+void *dbArenaGetPrototype(dbRecordType *precordType);
+void *dbArenaSetPrototype(dbRecordType *precordType,const void *precord);
+dbRecordNode *dbArenaNodeAlloc(DBBASE *pdbbase);
+void dbArenaNodeFree(DBBASE *pdbbase,dbRecordNode *precnode);
+dbInfoNode *dbArenaInfoAlloc(DBBASE *pdbbase);
+void dbArenaInfoFree(DBBASE *pdbbase,dbInfoNode *pinfo);
+char *dbArenaStrDup(DBBASE *pdbbase,const char *str);
+void dbArenaStrFree(DBBASE *pdbbase,char *str);
+void dbArenaFreeMem(DBBASE *pdbbase);
 
 #ifdef __cplusplus
 }
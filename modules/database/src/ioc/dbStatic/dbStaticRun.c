@@ -74,8 +74,11 @@ long dbAllocRecord(DBENTRY *pdbentry,const char *precordName)
     dbFldDes        *pflddes;
     int             i;
     dbCommonPvt     *ppvt;
+    dbCommonPvt     *pprototype;
     dbCommon        *precord;
     char            *pfield;
+    size_t          size;
+    int             initOk = TRUE;
 
     if(!pdbRecordType) return(S_dbLib_recordTypeNotFound);
     if(!precnode) return(S_dbLib_recNotFound);
@@ -90,7 +93,10 @@ long dbAllocRecord(DBENTRY *pdbentry,const char *precordName)
                     precordName, pdbRecordType->name, pdbRecordType->rec_size);
         return(S_dbLib_noRecSup);
     }
-    ppvt = dbCalloc(1, offsetof(dbCommonPvt, common) + pdbRecordType->rec_size);
+    size = offsetof(dbCommonPvt, common) + pdbRecordType->rec_size;
+    ppvt = dbArenaRecordAlloc(pdbentry->pdbbase, pdbRecordType, size);
+    pprototype = dbArenaGetPrototype(pdbRecordType);
+    if(pprototype) memcpy(ppvt, pprototype, size);
     precord = &ppvt->common;
     ppvt->recnode = precnode;
     precord->rdes = pdbRecordType;
@@ -107,6 +113,20 @@ long dbAllocRecord(DBENTRY *pdbentry,const char *precordName)
         return(S_dbLib_nameLength);
     }
     strcpy(precord->name, precordName);
+    if(pprototype) {
+        /* Every field has its initial value, except for link strings */
+        for(i=0; i<pdbRecordType->no_links; i++) {
+            pflddes = pdbRecordType->papFldDes[pdbRecordType->link_ind[i]];
+            if(pflddes->initial) {
+                DBLINK *plink = (DBLINK *)((char *)precord + pflddes->offset);
+
+                plink->text =
+                        dbCalloc(strlen(pflddes->initial)+1,sizeof(char));
+                strcpy(plink->text,pflddes->initial);
+            }
+        }
+        return(0);
+    }
     for(i=1; i<pdbRecordType->no_fields; i++) {
 
         pflddes = pdbRecordType->papFldDes[i];
@@ -121,6 +141,7 @@ long dbAllocRecord(DBENTRY *pdbentry,const char *precordName)
                 if(strlen(pflddes->initial) >= pflddes->size) {
                     epicsPrintf("initial size > size for %s.%s\n",
                                 pdbRecordType->name,pflddes->name);
+                    initOk = FALSE;
                 } else {
                     strcpy(pfield,pflddes->initial);
                 }
@@ -142,9 +163,11 @@ long dbAllocRecord(DBENTRY *pdbentry,const char *precordName)
                 long status;
 
                 status = dbPutStringNum(pdbentry,pflddes->initial);
-                if(status)
+                if(status) {
                     epicsPrintf("Error initializing %s.%s initial %s\n",
                                 pdbRecordType->name,pflddes->name,pflddes->initial);
+                    initOk = FALSE;
+                }
             }
             break;
         case DBF_DEVICE:
@@ -167,6 +190,19 @@ long dbAllocRecord(DBENTRY *pdbentry,const char *precordName)
             break;
         default:
             epicsPrintf("dbAllocRecord: Illegal field type\n");
+            initOk = FALSE;
+        }
+    }
+    /* Converting the initial values of every field again for each record
+     * is slow, so later records of this type start as a copy of this one.
+     */
+    if(initOk && (pprototype = dbArenaSetPrototype(pdbRecordType, ppvt))) {
+        pprototype->recnode = NULL;
+        memset(pprototype->common.name, 0, sizeof(precord->name));
+        for(i=0; i<pdbRecordType->no_links; i++) {
+            pflddes = pdbRecordType->papFldDes[pdbRecordType->link_ind[i]];
+            ((DBLINK *)((char *)&pprototype->common + pflddes->offset))->text =
+                NULL;
         }
     }
     return(0);
@@ -180,7 +216,8 @@ long dbFreeRecord(DBENTRY *pdbentry)
     if(!pdbRecordType) return(S_dbLib_recordTypeNotFound);
     if(!precnode) return(S_dbLib_recNotFound);
     if(!precnode->precord) return(S_dbLib_recNotFound);
-    free(dbRec2Pvt(precnode->precord));
+    dbArenaRecordFree(pdbentry->pdbbase, pdbRecordType,
+        dbRec2Pvt(precnode->precord));
     precnode->precord = NULL;
     return(0);
 }
@@ -19,6 +19,7 @@
 
 #include "epicsExport.h"
 #include "dbAccess.h"
+#include "dbStaticPvt.h"
 #include "dbLoadTemplate.h"
 
 static int line_num;
@@ -376,7 +377,10 @@ int dbLoadTemplate(const char *sub_file, const char *cmd_collect)
         yyrestart(fp);
     }
 
+    /* Each template is read once, however many instances it has */
+    dbTemplateCache(1);
     yyparse();
+    dbTemplateCache(0);
 
     for (i = 0; i < var_count; i++) {
         dbmfFree(vars[i]);
@@ -12,6 +12,7 @@
 
 #include <string>
 #include <list>
+#include <map>
 
 #include <stdlib.h>
 #include <stddef.h>
@@ -63,6 +64,8 @@ static void inputDestruct(inputData * const pvt);
 static void inputAddPath(inputData * const pvt, const char * const pval);
 static void inputBegin(inputData * const pvt, const char * const fileName);
 static char *inputNextLine(inputData * const pvt);
+static long inputExpandLine(inputData * const pvt, MAC_HANDLE * const macPvt,
+    char *buffer, long capacity);
 static void inputNewIncludeFile(inputData * const pvt, const char * const name);
 static void inputErrPrint(const inputData * const pvt);
 
@@ -354,7 +357,7 @@ static void makeSubstitutions(inputData * const inputPvt,
 endcmd:
         if (expand && !opt_D) {
             STEP("Expanding to output stream");
-            n = macExpandString(macPvt, input, buffer, MAX_BUFFER_SIZE - 1);
+            n = inputExpandLine(inputPvt, macPvt, buffer, MAX_BUFFER_SIZE - 1);
             fputs(buffer, stdout);
             if (opt_V == 1 && n < 0) {
                 fprintf(stderr, "msi: Error - undefined macros present\n");
@@ -367,13 +370,21 @@ endcmd:
 
 typedef struct inputFile {
     std::string filename;
-    FILE        *fp;
+    const macTemplate *tmpl;
     int         lineNum;
 } inputFile;
 
+/* Every file is read and scanned for macro references only once, no
+ * matter how many substitution sets or include statements use it */
+typedef struct inputTemplate {
+    std::string filename;
+    macTemplate *tmpl;
+} inputTemplate;
+
 struct inputData {
     std::list<inputFile> inputFileList;
     std::list<std::string> pathList;
+    std::map<std::string, inputTemplate> templates;
     char        inputBuffer[MAX_BUFFER_SIZE];
     inputData() { memset(inputBuffer, 0, sizeof(inputBuffer) * sizeof(inputBuffer[0])); };
 };
@@ -389,7 +400,12 @@ static void inputConstruct(inputData **ppvt)
 
 static void inputDestruct(inputData * const pinputData)
 {
+    std::map<std::string, inputTemplate>::iterator it;
+
     inputCloseAllFiles(pinputData);
+    for (it = pinputData->templates.begin();
+         it != pinputData->templates.end(); ++it)
+        macTemplateFree(it->second.tmpl);
     delete(pinputData);
 }
 
@@ -446,11 +462,12 @@ static char *inputNextLine(inputData * const pinputData)
     ENTER;
     while (!inFileList.empty()) {
         inputFile& inFile = inFileList.front();
-        char *pline = fgets(pinputData->inputBuffer, MAX_BUFFER_SIZE, inFile.fp);
+        const char *pline = macTemplateLine(inFile.tmpl, inFile.lineNum);
         if (pline) {
             ++inFile.lineNum;
-            EXITS(pline);
-            return pline;
+            strcpy(pinputData->inputBuffer, pline);
+            EXITS(pinputData->inputBuffer);
+            return pinputData->inputBuffer;
         }
         inputCloseFile(pinputData);
     }
@@ -458,6 +475,16 @@ static char *inputNextLine(inputData * const pinputData)
     return 0;
 }
 
+/* Expand the line last returned by inputNextLine() */
+static long inputExpandLine(inputData * const pinputData,
+    MAC_HANDLE * const macPvt, char *buffer, long capacity)
+{
+    const inputFile& inFile = pinputData->inputFileList.front();
+
+    return macTemplateExpandLine(macPvt, inFile.tmpl, inFile.lineNum - 1,
+        buffer, capacity);
+}
+
 static void inputNewIncludeFile(inputData * const pinputData,
                                 const char * const name)
 {
@@ -499,9 +526,15 @@ static void inputOpenFile(inputData *pinputData, const char * const filename)
     std::list<std::string>::iterator pathIt = pathList.end();
     std::string fullname;
     FILE        *fp = 0;
+    std::string key = filename ? filename : "";
+    std::map<std::string, inputTemplate>::iterator cached =
+        pinputData->templates.find(key);
 
     ENTER;
-    if (!filename) {
+    if (cached != pinputData->templates.end()) {
+        STEPS("Reusing", cached->second.filename.c_str());
+    }
+    else if (!filename) {
         STEP("Using stdin");
         fp = stdin;
     }
@@ -521,25 +554,39 @@ static void inputOpenFile(inputData *pinputData, const char * const filename)
         }
     }
 
-    if (!fp) {
-        fprintf(stderr, "msi: Can't open file '%s'\n", filename);
-        inputErrPrint(pinputData);
-        abortExit(1);
-    }
+    if (cached == pinputData->templates.end()) {
+        if (!fp) {
+            fprintf(stderr, "msi: Can't open file '%s'\n", filename);
+            inputErrPrint(pinputData);
+            abortExit(1);
+        }
 
-    STEP("File opened");
-    inputFile inFile = inputFile();
+        STEP("File opened");
+        inputTemplate tmpl;
 
-    if (pathIt != pathList.end()) {
-        inFile.filename = fullname;
-    }
-    else if (filename) {
-        inFile.filename = filename;
-    }
-    else {
-        inFile.filename = "stdin";
+        if (pathIt != pathList.end()) {
+            tmpl.filename = fullname;
+        }
+        else if (filename) {
+            tmpl.filename = filename;
+        }
+        else {
+            tmpl.filename = "stdin";
+        }
+        tmpl.tmpl = macTemplateRead(fp, MAX_BUFFER_SIZE);
+        if (fp != stdin && fclose(fp))
+            fprintf(stderr, "msi: Can't close input file '%s'\n", tmpl.filename.c_str());
+        if (!tmpl.tmpl) {
+            fprintf(stderr, "msi: Can't read file '%s'\n", tmpl.filename.c_str());
+            inputErrPrint(pinputData);
+            abortExit(1);
+        }
+        cached = pinputData->templates.insert(std::make_pair(key, tmpl)).first;
     }
 
+    inputFile inFile = inputFile();
+    inFile.filename = cached->second.filename;
+
     if (opt_D) {
         int hash = epicsStrHash(inFile.filename.c_str(), 12345);
         int i = 0;
@@ -565,7 +612,7 @@ static void inputOpenFile(inputData *pinputData, const char * const filename)
         }
     }
 
-    inFile.fp = fp;
+    inFile.tmpl = cached->second.tmpl;
     pinputData->inputFileList.push_front(inFile);
     EXIT;
 }
@@ -575,9 +622,6 @@ static void inputCloseFile(inputData *pinputData)
     std::list<inputFile>& inFileList = pinputData->inputFileList;
     ENTER;
     if(!inFileList.empty()) {
-        inputFile& inFile = inFileList.front();
-        if (fclose(inFile.fp))
-            fprintf(stderr, "msi: Can't close input file '%s'\n", inFile.filename.c_str());
         inFileList.erase(inFileList.begin());
     }
     EXIT;
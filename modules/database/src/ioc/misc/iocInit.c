@@ -30,7 +30,9 @@
 #include "epicsGeneralTime.h"
 #include "epicsPrint.h"
 #include "epicsSignal.h"
+#include "epicsString.h"
 #include "epicsThread.h"
+#include "epicsThreadPool.h"
 #include "errMdef.h"
 #include "iocsh.h"
 #include "taskwd.h"
@@ -98,11 +100,50 @@ static void iterateRecords(recIterFunc func, void *user);
 int dbThreadRealtimeLock = 1;
 epicsExportAddress(int, dbThreadRealtimeLock);
 
+/*
+ * Number of threads used to run init_record() for the record types
+ * named with iocInitParallel().  0 initializes every record serially.
+ */
+int iocInitThreads = 0;
+epicsExportAddress(int, iocInitThreads);
+
+typedef struct parallelType {
+    ELLNODE node;
+    char *name;
+} parallelType;
+
+static ELLLIST parallelTypes = ELLLIST_INIT;
+
 enum iocStateEnum getIocState(void)
 {
     return iocState;
 }
 
+int iocInitParallel(const char *recordTypeName)
+{
+    parallelType *ptype;
+
+    if (!recordTypeName || !*recordTypeName) {
+        for (ptype = (parallelType *)ellFirst(&parallelTypes); ptype;
+             ptype = (parallelType *)ellNext(&ptype->node))
+            printf("%s\n", ptype->name);
+        return 0;
+    }
+    if (iocState != iocVoid) {
+        errlogPrintf("iocInitParallel: Must be called before iocInit\n");
+        return -1;
+    }
+    for (ptype = (parallelType *)ellFirst(&parallelTypes); ptype;
+         ptype = (parallelType *)ellNext(&ptype->node)) {
+        if (!strcmp(ptype->name, recordTypeName))
+            return 0;
+    }
+    ptype = dbCalloc(1, sizeof(parallelType));
+    ptype->name = epicsStrDup(recordTypeName);
+    ellAdd(&parallelTypes, &ptype->node);
+    return 0;
+}
+
 /*
  *  Initialize EPICS on the IOC.
  */
@@ -118,6 +159,10 @@ static int iocBuild_1(void)
         return -1;
     }
     errlogInit(0);
+    if (dbLoadRecordsWait()) {
+        errlogPrintf("iocBuild: Aborting, failed to load the database\n");
+        return -1;
+    }
     initHookAnnounce(initHookAtIocBuild);
 
     if (!epicsThreadIsOkToBlock()) {
@@ -468,6 +513,21 @@ static void finishDevSup(void)
     }
 }
 
+static void iterateRecordList(dbRecordType *pdbRecordType,
+    dbRecordNode *pdbRecordNode, int count, recIterFunc func, void *user)
+{
+    for (; pdbRecordNode && count--;
+         pdbRecordNode = (dbRecordNode *)ellNext(&pdbRecordNode->node)) {
+        dbCommon *precord = pdbRecordNode->precord;
+
+        if (!precord->name[0] ||
+            pdbRecordNode->flags & DBRN_FLAGS_ISALIAS)
+            continue;
+
+        func(pdbRecordType, precord, user);
+    }
+}
+
 static void iterateRecords(recIterFunc func, void *user)
 {
     dbRecordType *pdbRecordType;
@@ -475,23 +535,130 @@ static void iterateRecords(recIterFunc func, void *user)
     for (pdbRecordType = (dbRecordType *)ellFirst(&pdbbase->recordTypeList);
          pdbRecordType;
          pdbRecordType = (dbRecordType *)ellNext(&pdbRecordType->node)) {
-        dbRecordNode *pdbRecordNode;
+        iterateRecordList(pdbRecordType,
+            (dbRecordNode *)ellFirst(&pdbRecordType->recList),
+            ellCount(&pdbRecordType->recList), func, user);
+    }
+    return;
+}
+
+/*
+ * Parallel record initialization.
+ *
+ * The records of a type named with iocInitParallel() are split into
+ * batches which run as jobs on a thread pool.  Record types are still
+ * initialized one after another and in the usual order, so only
+ * records of the same type are ever initialized at the same time.
+ */
+#define INIT_BATCH_MIN 64
 
-        for (pdbRecordNode = (dbRecordNode *)ellFirst(&pdbRecordType->recList);
-             pdbRecordNode;
-             pdbRecordNode = (dbRecordNode *)ellNext(&pdbRecordNode->node)) {
-            dbCommon *precord = pdbRecordNode->precord;
+typedef struct initBatch {
+    dbRecordType *pdbRecordType;
+    dbRecordNode *first;
+    int count;
+    recIterFunc func;
+} initBatch;
 
-            if (!precord->name[0] ||
-                pdbRecordNode->flags & DBRN_FLAGS_ISALIAS)
-                continue;
+static void initBatchJob(void *arg, epicsJobMode mode)
+{
+    initBatch *pbatch = arg;
 
-            func(pdbRecordType, precord, user);
-        }
+    if (mode != epicsJobModeRun)
+        return;
+    iterateRecordList(pbatch->pdbRecordType, pbatch->first, pbatch->count,
+        pbatch->func, NULL);
+}
+
+static int isParallelType(dbRecordType *pdbRecordType)
+{
+    parallelType *ptype;
+
+    for (ptype = (parallelType *)ellFirst(&parallelTypes); ptype;
+         ptype = (parallelType *)ellNext(&ptype->node)) {
+        if (!strcmp(ptype->name, pdbRecordType->name))
+            return 1;
     }
-    return;
+    return 0;
 }
-
+
+static void initTypeParallel(epicsThreadPool *pool,
+    dbRecordType *pdbRecordType, recIterFunc func)
+{
+    int count = ellCount(&pdbRecordType->recList);
+    int size = count / (iocInitThreads * 4) + 1;
+    dbRecordNode *pdbRecordNode =
+        (dbRecordNode *)ellFirst(&pdbRecordType->recList);
+    initBatch *batches;
+    epicsJob **jobs;
+    int nbatch, i;
+
+    if (size < INIT_BATCH_MIN)
+        size = INIT_BATCH_MIN;
+    nbatch = (count + size - 1) / size;
+    batches = dbCalloc(nbatch, sizeof(initBatch));
+    jobs = dbCalloc(nbatch, sizeof(epicsJob *));
+
+    for (i = 0; i < nbatch; i++) {
+        int n = count < size ? count : size;
+        initBatch *pbatch = &batches[i];
+
+        pbatch->pdbRecordType = pdbRecordType;
+        pbatch->first = pdbRecordNode;
+        pbatch->count = n;
+        pbatch->func = func;
+        count -= n;
+        while (n--)
+            pdbRecordNode = (dbRecordNode *)ellNext(&pdbRecordNode->node);
+
+        jobs[i] = epicsJobCreate(pool, initBatchJob, pbatch);
+        if (!jobs[i] || epicsJobQueue(jobs[i]))
+            initBatchJob(pbatch, epicsJobModeRun);  /* Do it ourselves */
+    }
+    epicsThreadPoolWait(pool, -1);
+
+    for (i = 0; i < nbatch; i++) {
+        if (jobs[i])
+            epicsJobDestroy(jobs[i]);
+    }
+    free(jobs);
+    free(batches);
+}
+
+static void initRecords(epicsThreadPool *pool, recIterFunc func)
+{
+    dbRecordType *pdbRecordType;
+
+    for (pdbRecordType = (dbRecordType *)ellFirst(&pdbbase->recordTypeList);
+         pdbRecordType;
+         pdbRecordType = (dbRecordType *)ellNext(&pdbRecordType->node)) {
+        int count = ellCount(&pdbRecordType->recList);
+
+        if (pool && count > INIT_BATCH_MIN && isParallelType(pdbRecordType))
+            initTypeParallel(pool, pdbRecordType, func);
+        else
+            iterateRecordList(pdbRecordType,
+                (dbRecordNode *)ellFirst(&pdbRecordType->recList),
+                count, func, NULL);
+    }
+}
+
+static epicsThreadPool* initPoolCreate(void)
+{
+    epicsThreadPoolConfig config;
+    epicsThreadPool *pool;
+
+    if (iocInitThreads <= 0 || ellCount(&parallelTypes) == 0)
+        return NULL;
+
+    epicsThreadPoolConfigDefaults(&config);
+    config.initialThreads = config.maxThreads = iocInitThreads;
+    pool = epicsThreadPoolCreate(&config);
+    if (!pool)
+        errlogPrintf("iocInit: Can't create thread pool, "
+            "initializing records serially\n");
+    return pool;
+}
+
 static void doInitRecord0(dbRecordType *pdbRecordType, dbCommon *precord,
     void *user)
 {
@@ -559,10 +726,15 @@ static void doInitRecord1(dbRecordType *pdbRecordType, dbCommon *precord,
 
 static void initDatabase(void)
 {
+    epicsThreadPool *pool = initPoolCreate();
+
     dbChannelInit();
-    iterateRecords(doInitRecord0, NULL);
+    initRecords(pool, doInitRecord0);
     iterateRecords(doResolveLinks, NULL);
-    iterateRecords(doInitRecord1, NULL);
+    dbLockComputeSets(pdbbase);
+    initRecords(pool, doInitRecord1);
+    if (pool)
+        epicsThreadPoolDestroy(pool);
 
     epicsAtExit(exitDatabase, NULL);
     return;
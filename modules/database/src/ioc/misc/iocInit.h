@@ -30,6 +30,14 @@ DBCORE_API int iocRun(void);
 DBCORE_API int iocPause(void);
 DBCORE_API int iocShutdown(void);
 
+/* Allow iocInit to run init_record() for several records of the named type
+ * at once, using iocInitThreads threads.  Only for record types whose record
+ * and device support are known to be thread-safe during initialization.
+ * A NULL or empty name lists the types given so far.
+ */
+DBCORE_API int iocInitParallel(const char *recordTypeName);
+DBCORE_API extern int iocInitThreads;
+
 #ifdef __cplusplus
 }
 #endif
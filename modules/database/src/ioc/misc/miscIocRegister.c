@@ -53,6 +53,19 @@ static void iocPauseCallFunc(const iocshArgBuf *args)
     iocshSetError(iocPause());
 }
 
+/* iocInitParallel */
+static const iocshArg iocInitParallelArg0 = { "recordType",iocshArgString};
+static const iocshArg * const iocInitParallelArgs[] = {&iocInitParallelArg0};
+static const iocshFuncDef iocInitParallelFuncDef = {"iocInitParallel",1,iocInitParallelArgs,
+             "Let iocInit initialize records of this type from several threads.\n"
+             "Only for record types whose record and device support are thread-safe.\n"
+             "The number of threads is set by the variable iocInitThreads.\n"
+             "With no argument, lists the record types given so far.\n"};
+static void iocInitParallelCallFunc(const iocshArgBuf *args)
+{
+    iocshSetError(iocInitParallel(args[0].sval));
+}
+
 /* coreRelease */
 static const iocshFuncDef coreReleaseFuncDef = {"coreRelease",0,NULL,
              "Print release information for iocCore.\n"};
@@ -68,6 +81,7 @@ void miscIocRegister(void)
     iocshRegister(&iocBuildFuncDef,iocBuildCallFunc);
     iocshRegister(&iocRunFuncDef,iocRunCallFunc);
     iocshRegister(&iocPauseFuncDef,iocPauseCallFunc);
+    iocshRegister(&iocInitParallelFuncDef,iocInitParallelCallFunc);
     iocshRegister(&coreReleaseFuncDef, coreReleaseCallFunc);
 }
 
@@ -49,6 +49,16 @@ static long init_record(dbCommon *pcommon)
 
 static long read_histogram(histogramRecord *prec)
 {
-    dbGetLink(&prec->svl, DBR_DOUBLE, &prec->sgnl, 0, 0);
+    if (prec->sptr) {
+        long nRequest = prec->snel;
+
+        if (dbGetLink(&prec->svl, DBR_DOUBLE, prec->sptr, 0, &nRequest) ||
+            nRequest <= 0)
+            return 2; /*nothing to add*/
+        prec->snrd = nRequest;
+        prec->sgnl = prec->sptr[nRequest - 1];
+    }
+    else
+        dbGetLink(&prec->svl, DBR_DOUBLE, &prec->sgnl, 0, 0);
     return 0; /*add count*/
 }
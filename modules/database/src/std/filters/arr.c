@@ -94,7 +94,6 @@ static long wrapArrayIndices(long *start, const long increment, long *end,
 static db_field_log* filter(void* pvt, dbChannel *chan, db_field_log *pfl)
 {
     myStruct *my = (myStruct*) pvt;
-    int must_lock;
     long start = my->start;
     long end = my->end;
     long nTarget;
@@ -109,29 +108,42 @@ static db_field_log* filter(void* pvt, dbChannel *chan, db_field_log *pfl)
         break;
 
     case dbfl_type_ref:
-        must_lock = !pfl->dtor;
-        if (must_lock) {
-            dbScanLock(dbChannelRecord(chan));
-            dbChannelGetArrayInfo(chan, &pSource, &nSource, &offset);
+        if (pfl->dtor) {
+            /* the field log owns a copy, extract in place */
+            nTarget = wrapArrayIndices(&start, my->incr, &end, nSource);
+            if (nTarget > 0)
+                dbExtractArray(pSource, pSource, pfl->field_size,
+                    nTarget, nSource, start, my->incr);
+            pfl->no_elements = nTarget;
+            break;
         }
+        dbScanLock(dbChannelRecord(chan));
+        dbChannelGetArrayInfo(chan, &pSource, &nSource, &offset);
         nTarget = wrapArrayIndices(&start, my->incr, &end, nSource);
+        if (nTarget == nSource && offset == 0 &&
+            nSource == pfl->no_elements) {
+            /* the whole array, leave it in the record */
+            dbScanUnlock(dbChannelRecord(chan));
+            break;
+        }
         if (nTarget > 0) {
             /* copy the data */
-            pTarget = freeListCalloc(my->arrayFreeList);
-            if (!pTarget) break;
+            pTarget = freeListMalloc(my->arrayFreeList);
+            if (!pTarget) {
+                dbScanUnlock(dbChannelRecord(chan));
+                break;
+            }
             /* must do the wrap-around with the original no_elements */
             offset = (offset + start) % pfl->no_elements;
             dbExtractArray(pSource, pTarget, pfl->field_size,
                 nTarget, pfl->no_elements, offset, my->incr);
-            if (pfl->dtor) pfl->dtor(pfl);
             pfl->u.r.field = pTarget;
             pfl->dtor = freeArray;
             pfl->u.r.pvt = my->arrayFreeList;
         }
         /* adjust no_elements (even if zero elements remain) */
         pfl->no_elements = nTarget;
-        if (must_lock)
-            dbScanUnlock(dbChannelRecord(chan));
+        dbScanUnlock(dbChannelRecord(chan));
         break;
     }
     return pfl;
@@ -73,13 +73,19 @@ static db_field_log* filter(void* pvt, dbChannel *chan, db_field_log *pfl) {
      * are just passed on
      */
     if (pfl->type == dbfl_type_val) {
-        DBADDR localAddr = chan->addr; /* Structure copy */
-        localAddr.field_type = pfl->field_type;
-        localAddr.field_size = pfl->field_size;
-        localAddr.no_elements = pfl->no_elements;
-        localAddr.pfield = (char *) &pfl->u.v.field;
-        status = dbFastGetConvertRoutine[pfl->field_type][DBR_DOUBLE]
-                 (localAddr.pfield, (void*) &val, &localAddr);
+        if (pfl->field_type == DBF_DOUBLE) {
+            /* No conversion needed */
+            val = pfl->u.v.field.dbf_double;
+            status = 0;
+        } else {
+            DBADDR localAddr = chan->addr; /* Structure copy */
+            localAddr.field_type = pfl->field_type;
+            localAddr.field_size = pfl->field_size;
+            localAddr.no_elements = pfl->no_elements;
+            localAddr.pfield = (char *) &pfl->u.v.field;
+            status = dbFastGetConvertRoutine[pfl->field_type][DBR_DOUBLE]
+                     (localAddr.pfield, (void*) &val, &localAddr);
+        }
         if (!status) {
             send = pfl->mask & ~(DBE_VALUE|DBE_LOG);
             recGblCheckDeadband(&my->last, val, my->hyst, &send, pfl->mask & (DBE_VALUE|DBE_LOG));
@@ -12,31 +12,48 @@
  */
 
 #include <stdio.h>
-#include <stdlib.h>
 #include <string.h>
 
 #include "chfPlugin.h"
 #include "db_field_log.h"
 #include "dbExtractArray.h"
 #include "dbLock.h"
+#include "epicsExit.h"
+#include "freeList.h"
 #include "epicsExport.h"
 
-/*
- * The size of the data is different for each channel, and can even
- * change at runtime, so a freeList doesn't make much sense here.
- */
+typedef struct myStruct {
+    void *arrayFreeList;
+} myStruct;
+
+static void *myStructFreeList;
+
+static void * allocPvt(void)
+{
+    return freeListCalloc(myStructFreeList);
+}
+
+static void freePvt(void *pvt)
+{
+    myStruct *my = (myStruct*) pvt;
+
+    if (my->arrayFreeList) freeListCleanup(my->arrayFreeList);
+    freeListFree(myStructFreeList, pvt);
+}
+
 static void freeArray(db_field_log *pfl) {
-    free(pfl->u.r.field);
+    freeListFree(pfl->u.r.pvt, pfl->u.r.field);
 }
 
 static db_field_log* filter(void* pvt, dbChannel *chan, db_field_log *pfl) {
+    myStruct *my = (myStruct*) pvt;
     epicsTimeStamp now;
     epicsTimeGetCurrent(&now);
 
     /* If reference and not already copied,
        must make a copy (to ensure coherence between time and data) */
-    if (pfl->type == dbfl_type_ref && !pfl->dtor) {
-        void *pTarget = calloc(pfl->no_elements, pfl->field_size);
+    if (pfl->type == dbfl_type_ref && !pfl->dtor && pfl->no_elements > 0) {
+        void *pTarget = freeListMalloc(my->arrayFreeList);
         void *pSource = pfl->u.r.field;
         if (pTarget) {
             long offset = 0;
@@ -47,7 +64,7 @@ static db_field_log* filter(void* pvt, dbChannel *chan, db_field_log *pfl) {
                 nSource, pfl->no_elements, offset, 1);
             pfl->u.r.field = pTarget;
             pfl->dtor = freeArray;
-            pfl->u.r.pvt = pvt;
+            pfl->u.r.pvt = my->arrayFreeList;
             dbScanUnlock(dbChannelRecord(chan));
         }
     }
@@ -56,10 +73,18 @@ static db_field_log* filter(void* pvt, dbChannel *chan, db_field_log *pfl) {
     return pfl;
 }
 
+/* Copies are made from a free list of buffers the size of the field */
 static void channelRegisterPre(dbChannel *chan, void *pvt,
                                chPostEventFunc **cb_out, void **arg_out, db_field_log *probe)
 {
+    myStruct *my = (myStruct*) pvt;
+
+    if (!my->arrayFreeList)
+        freeListInitPvt(&my->arrayFreeList,
+            dbChannelElements(chan) * dbChannelFieldSize(chan), 2);
+    if (!my->arrayFreeList) return;
     *cb_out = filter;
+    *arg_out = pvt;
 }
 
 static void channel_report(dbChannel *chan, void *pvt, int level, const unsigned short indent)
@@ -68,8 +93,8 @@ static void channel_report(dbChannel *chan, void *pvt, int level, const unsigned
 }
 
 static chfPluginIf pif = {
-    NULL, /* allocPvt, */
-    NULL, /* freePvt, */
+    allocPvt,
+    freePvt,
 
     NULL, /* parse_error, */
     NULL, /* parse_ok, */
@@ -81,9 +106,20 @@ static chfPluginIf pif = {
     NULL /* channel_close */
 };
 
+static void tsShutdown(void* ignore)
+{
+    if(myStructFreeList)
+        freeListCleanup(myStructFreeList);
+    myStructFreeList = NULL;
+}
+
 static void tsInitialize(void)
 {
+    if (!myStructFreeList)
+        freeListInitPvt(&myStructFreeList, sizeof(myStruct), 64);
+
     chfPluginRegister("ts", &pif, NULL);
+    epicsAtExit(tsShutdown, NULL);
 }
 
 epicsExportRegistrar(tsInitialize);
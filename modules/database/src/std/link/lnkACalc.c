@@ -0,0 +1,715 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+/* lnkACalc.c */
+
+/*  Usage
+ *      {acalc:{expr:"A*B", args:[{...}, ...], reduce:"sum", units:"mm"}}
+ *  First link in 'args' is 'A', second is 'B', and so forth.
+ *  Inputs with more than one element are arrays, the expression gets
+ *  evaluated once for each element and the results are returned as an
+ *  array, or combined into one value by the optional 'reduce' operation.
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "dbDefs.h"
+#include "errlog.h"
+#include "epicsMath.h"
+#include "epicsString.h"
+#include "epicsTypes.h"
+#include "alarm.h"
+#include "dbAccessDefs.h"
+#include "dbCommon.h"
+#include "dbConvertFast.h"
+#include "dbLink.h"
+#include "dbJLink.h"
+#include "dbStaticLib.h"
+#include "postfix.h"
+#include "recGbl.h"
+#include "epicsExport.h"
+
+
+typedef long (*FASTCONVERT)();
+
+typedef enum {
+    red_none,
+    red_sum, red_min, red_max, red_mean, red_std
+} reduce_op;
+
+static const char * const reduce_names[] = {
+    "none", "sum", "min", "max", "mean", "std"
+};
+
+typedef struct acalc_arg {
+    double *pval;       /* element values */
+    long size;          /* elements allocated */
+    long nval;          /* elements last read */
+} acalc_arg;
+
+typedef struct acalc_link {
+    jlink jlink;        /* embedded object */
+    int nArgs;
+    enum {
+        ps_init,
+        ps_expr, ps_args, ps_reduce,
+        ps_prec,
+        ps_units,
+        ps_error
+    } pstate;
+    reduce_op reduce;
+    short prec;
+    char *expr;
+    char *post_expr;
+    char *units;
+    struct link inp[CALCPERFORM_NARGS];
+    double arg[CALCPERFORM_NARGS];
+    acalc_arg varg[CALCPERFORM_NARGS];
+    double *pres;       /* results of the expression */
+    long rsize;         /* elements allocated */
+    long nres;          /* elements last calculated */
+    double val;         /* reduced or first result */
+} acalc_link;
+
+static lset lnkACalc_lset;
+
+
+/* Make room for at least n values in *ppval */
+static int growBuffer(double **ppval, long *psize, long n)
+{
+    double *pval;
+
+    if (n <= *psize)
+        return 0;
+
+    pval = realloc(*ppval, n * sizeof(double));
+    if (!pval) {
+        errlogPrintf("lnkACalc: Out of memory\n");
+        return -1;
+    }
+    *ppval = pval;
+    *psize = n;
+    return 0;
+}
+
+static void freeLink(acalc_link *clink)
+{
+    int i;
+
+    for (i = 0; i < CALCPERFORM_NARGS; i++)
+        free(clink->varg[i].pval);
+    free(clink->pres);
+    free(clink->expr);
+    free(clink->post_expr);
+    free(clink->units);
+    free(clink);
+}
+
+
+/*************************** jlif Routines **************************/
+
+static jlink* lnkACalc_alloc(short dbfType)
+{
+    acalc_link *clink;
+
+    if (dbfType != DBF_INLINK) {
+        errlogPrintf("lnkACalc: Only works with input links\n");
+        return NULL;
+    }
+
+    clink = calloc(1, sizeof(struct acalc_link));
+    if (!clink) {
+        errlogPrintf("lnkACalc: calloc() failed.\n");
+        return NULL;
+    }
+
+    clink->nArgs = 0;
+    clink->pstate = ps_init;
+    clink->reduce = red_none;
+    clink->prec = 15;   /* standard value for a double */
+
+    return &clink->jlink;
+}
+
+static void lnkACalc_free(jlink *pjlink)
+{
+    acalc_link *clink = CONTAINER(pjlink, struct acalc_link, jlink);
+    int i;
+
+    for (i = 0; i < clink->nArgs; i++)
+        dbJLinkFree(clink->inp[i].value.json.jlink);
+
+    freeLink(clink);
+}
+
+static jlif_result lnkACalc_integer(jlink *pjlink, long long num)
+{
+    acalc_link *clink = CONTAINER(pjlink, struct acalc_link, jlink);
+
+    if (clink->pstate == ps_prec) {
+        clink->prec = num;
+        return jlif_continue;
+    }
+
+    if (clink->pstate != ps_args) {
+        errlogPrintf("lnkACalc: Unexpected integer %lld\n", num);
+        return jlif_stop;
+    }
+
+    if (clink->nArgs == CALCPERFORM_NARGS) {
+        errlogPrintf("lnkACalc: Too many input args, limit is %d\n",
+            CALCPERFORM_NARGS);
+        return jlif_stop;
+    }
+
+    clink->arg[clink->nArgs++] = num;
+
+    return jlif_continue;
+}
+
+static jlif_result lnkACalc_double(jlink *pjlink, double num)
+{
+    acalc_link *clink = CONTAINER(pjlink, struct acalc_link, jlink);
+
+    if (clink->pstate != ps_args) {
+        errlogPrintf("lnkACalc: Unexpected double %g\n", num);
+        return jlif_stop;
+    }
+
+    if (clink->nArgs == CALCPERFORM_NARGS) {
+        errlogPrintf("lnkACalc: Too many input args, limit is %d\n",
+            CALCPERFORM_NARGS);
+        return jlif_stop;
+    }
+
+    clink->arg[clink->nArgs++] = num;
+
+    return jlif_continue;
+}
+
+static jlif_result lnkACalc_string(jlink *pjlink, const char *val, size_t len)
+{
+    acalc_link *clink = CONTAINER(pjlink, struct acalc_link, jlink);
+    short err;
+
+    if (clink->pstate == ps_units) {
+        clink->units = epicsStrnDup(val, len);
+        return jlif_continue;
+    }
+
+    if (clink->pstate == ps_reduce) {
+        int i;
+
+        for (i = red_sum; i <= red_std; i++) {
+            if (strlen(reduce_names[i]) == len &&
+                !epicsStrnCaseCmp(val, reduce_names[i], len)) {
+                clink->reduce = i;
+                return jlif_continue;
+            }
+        }
+        errlogPrintf("lnkACalc: Bad 'reduce' parameter \"%.*s\"\n",
+            (int) len, val);
+        return jlif_stop;
+    }
+
+    if (clink->pstate != ps_expr) {
+        errlogPrintf("lnkACalc: Unexpected string \"%.*s\"\n", (int) len, val);
+        return jlif_stop;
+    }
+
+    clink->expr = epicsStrnDup(val, len);
+    clink->post_expr = malloc(INFIX_TO_POSTFIX_SIZE(len+1));
+    if (!clink->post_expr) {
+        errlogPrintf("lnkACalc: Out of memory\n");
+        return jlif_stop;
+    }
+
+    if (postfix(clink->expr, clink->post_expr, &err) < 0) {
+        errlogPrintf("lnkACalc: Error in calc expression, %s\n",
+            calcErrorStr(err));
+        return jlif_stop;
+    }
+
+    return jlif_continue;
+}
+
+static jlif_key_result lnkACalc_start_map(jlink *pjlink)
+{
+    acalc_link *clink = CONTAINER(pjlink, struct acalc_link, jlink);
+
+    if (clink->pstate == ps_args)
+        return jlif_key_child_inlink;
+
+    if (clink->pstate != ps_init) {
+        errlogPrintf("lnkACalc: Unexpected map\n");
+        return jlif_key_stop;
+    }
+
+    return jlif_key_continue;
+}
+
+static jlif_result lnkACalc_map_key(jlink *pjlink, const char *key, size_t len)
+{
+    acalc_link *clink = CONTAINER(pjlink, struct acalc_link, jlink);
+
+    if (len == 4 && !strncmp(key, "expr", len) && !clink->post_expr)
+        clink->pstate = ps_expr;
+    else if (len == 4 && !strncmp(key, "args", len) && !clink->nArgs)
+        clink->pstate = ps_args;
+    else if (len == 4 && !strncmp(key, "prec", len))
+        clink->pstate = ps_prec;
+    else if (len == 5 && !strncmp(key, "units", len) && !clink->units)
+        clink->pstate = ps_units;
+    else if (len == 6 && !strncmp(key, "reduce", len))
+        clink->pstate = ps_reduce;
+    else {
+        errlogPrintf("lnkACalc: Unknown key \"%.*s\"\n", (int) len, key);
+        return jlif_stop;
+    }
+
+    return jlif_continue;
+}
+
+static jlif_result lnkACalc_end_map(jlink *pjlink)
+{
+    acalc_link *clink = CONTAINER(pjlink, struct acalc_link, jlink);
+
+    if (clink->pstate == ps_error)
+        return jlif_stop;
+    else if (!clink->post_expr) {
+        errlogPrintf("lnkACalc: No expression ('expr' key)\n");
+        return jlif_stop;
+    }
+
+    return jlif_continue;
+}
+
+static jlif_result lnkACalc_start_array(jlink *pjlink)
+{
+    acalc_link *clink = CONTAINER(pjlink, struct acalc_link, jlink);
+
+    if (clink->pstate != ps_args) {
+        errlogPrintf("lnkACalc: Unexpected array\n");
+        return jlif_stop;
+    }
+
+    return jlif_continue;
+}
+
+static jlif_result lnkACalc_end_array(jlink *pjlink)
+{
+    acalc_link *clink = CONTAINER(pjlink, struct acalc_link, jlink);
+
+    if (clink->pstate == ps_error)
+        return jlif_stop;
+
+    return jlif_continue;
+}
+
+static void lnkACalc_end_child(jlink *parent, jlink *child)
+{
+    acalc_link *clink = CONTAINER(parent, struct acalc_link, jlink);
+    struct link *plink;
+
+    if (clink->pstate != ps_args) {
+        errlogPrintf("lnkACalc: Unexpected child link, parser state = %d\n",
+            clink->pstate);
+        goto errOut;
+    }
+    if (clink->nArgs == CALCPERFORM_NARGS) {
+        errlogPrintf("lnkACalc: Too many input args, limit is %d\n",
+            CALCPERFORM_NARGS);
+        goto errOut;
+    }
+
+    plink = &clink->inp[clink->nArgs++];
+    plink->type = JSON_LINK;
+    plink->value.json.string = NULL;
+    plink->value.json.jlink = child;
+    return;
+
+errOut:
+    clink->pstate = ps_error;
+    dbJLinkFree(child);
+}
+
+static struct lset* lnkACalc_get_lset(const jlink *pjlink)
+{
+    return &lnkACalc_lset;
+}
+
+static void lnkACalc_report(const jlink *pjlink, int level, int indent)
+{
+    acalc_link *clink = CONTAINER(pjlink, struct acalc_link, jlink);
+    int i;
+
+    if (clink->reduce)
+        printf("%*s'acalc': %s(\"%s\") = %.*g %s\n", indent, "",
+            reduce_names[clink->reduce], clink->expr, clink->prec,
+            clink->val, clink->units ? clink->units : "");
+    else
+        printf("%*s'acalc': \"%s\" = %ld element(s) %s\n", indent, "",
+            clink->expr, clink->nres, clink->units ? clink->units : "");
+
+    if (level > 0) {
+        for (i = 0; i < clink->nArgs; i++) {
+            struct link *plink = &clink->inp[i];
+            jlink *child = plink->type == JSON_LINK ?
+                plink->value.json.jlink : NULL;
+
+            if (clink->varg[i].nval > 1)
+                printf("%*s  Input %c: %ld elements\n", indent, "",
+                    i + 'A', clink->varg[i].nval);
+            else
+                printf("%*s  Input %c: %g\n", indent, "",
+                    i + 'A', clink->arg[i]);
+
+            if (child)
+                dbJLinkReport(child, level - 1, indent + 4);
+        }
+    }
+}
+
+static long lnkACalc_map_children(jlink *pjlink, jlink_map_fn rtn, void *ctx)
+{
+    acalc_link *clink = CONTAINER(pjlink, struct acalc_link, jlink);
+    int i;
+
+    for (i = 0; i < clink->nArgs; i++) {
+        struct link *child = &clink->inp[i];
+        long status = dbJLinkMapChildren(child, rtn, ctx);
+
+        if (status)
+            return status;
+    }
+    return 0;
+}
+
+/*************************** lset Routines **************************/
+
+/* Constant inputs are loaded once, and may be arrays */
+static void loadConstant(acalc_link *clink, int i)
+{
+    struct link *child = &clink->inp[i];
+    acalc_arg *parg = &clink->varg[i];
+    long n;
+
+    do {
+        if (growBuffer(&parg->pval, &parg->size, parg->size ? 2 * parg->size : 16))
+            return;
+        n = parg->size;
+        if (dbLoadLinkArray(child, DBR_DOUBLE, parg->pval, &n))
+            return;
+    } while (n == parg->size);
+
+    parg->nval = n;
+    if (n > 0)
+        clink->arg[i] = parg->pval[0];
+}
+
+static void lnkACalc_open(struct link *plink)
+{
+    acalc_link *clink = CONTAINER(plink->value.json.jlink,
+        struct acalc_link, jlink);
+    int i;
+
+    for (i = 0; i < clink->nArgs; i++) {
+        struct link *child = &clink->inp[i];
+
+        child->precord = plink->precord;
+        dbJLinkInit(child);
+        if (dbLinkIsConstant(child))
+            loadConstant(clink, i);
+    }
+}
+
+static void lnkACalc_remove(struct dbLocker *locker, struct link *plink)
+{
+    acalc_link *clink = CONTAINER(plink->value.json.jlink,
+        struct acalc_link, jlink);
+    int i;
+
+    for (i = 0; i < clink->nArgs; i++) {
+        struct link *child = &clink->inp[i];
+
+        dbRemoveLink(locker, child);
+    }
+
+    freeLink(clink);
+    plink->value.json.jlink = NULL;
+}
+
+static int lnkACalc_isConn(const struct link *plink)
+{
+    acalc_link *clink = CONTAINER(plink->value.json.jlink,
+        struct acalc_link, jlink);
+    int connected = 1;
+    int i;
+
+    for (i = 0; i < clink->nArgs; i++) {
+        struct link *child = &clink->inp[i];
+
+        if (dbLinkIsVolatile(child) &&
+            !dbIsLinkConnected(child))
+            connected = 0;
+    }
+
+    return connected;
+}
+
+static int lnkACalc_getDBFtype(const struct link *plink)
+{
+    return DBF_DOUBLE;
+}
+
+static long lnkACalc_getElements(const struct link *plink, long *nelements)
+{
+    acalc_link *clink = CONTAINER(plink->value.json.jlink,
+        struct acalc_link, jlink);
+    long nelm = 1;
+    int i;
+
+    if (!clink->reduce) {
+        for (i = 0; i < clink->nArgs; i++) {
+            struct link *child = &clink->inp[i];
+            long n = clink->varg[i].nval;
+
+            if (!dbLinkIsConstant(child) && dbGetNelements(child, &n))
+                continue;
+            if (n > nelm)
+                nelm = n;
+        }
+    }
+    *nelements = nelm;
+    return 0;
+}
+
+/* Read the inputs, sets *pnelem to the number of elements to calculate.
+ * A failed or empty input raises a LINK/INVALID alarm on the record.
+ */
+static long readInputs(acalc_link *clink, dbCommon *prec, long *pnelem)
+{
+    long nelem = -1;
+    int i;
+
+    for (i = 0; i < clink->nArgs; i++) {
+        struct link *child = &clink->inp[i];
+        acalc_arg *parg = &clink->varg[i];
+        long n = 1;
+        long status;
+
+        if (child->type != JSON_LINK)
+            continue;
+
+        if (!dbLinkIsConstant(child)) {
+            if (dbGetNelements(child, &n) || n < 1)
+                n = 1;
+            if (growBuffer(&parg->pval, &parg->size, n)) {
+                recGblSetSevrMsg(prec, LINK_ALARM, INVALID_ALARM,
+                    "acalc %c no memory", 'A' + i);
+                return S_db_noMemory;
+            }
+            status = dbGetLink(child, DBR_DOUBLE, parg->pval, NULL, &n);
+            if (status) {
+                parg->nval = 0;
+                recGblSetSevrMsg(prec, LINK_ALARM, INVALID_ALARM,
+                    "acalc %c read failed", 'A' + i);
+                return status;
+            }
+            parg->nval = n;
+            if (n > 0)
+                clink->arg[i] = parg->pval[0];
+        }
+
+        if (parg->nval < 1) {
+            recGblSetSevrMsg(prec, LINK_ALARM, INVALID_ALARM,
+                "acalc %c is empty", 'A' + i);
+            return S_db_badField;
+        }
+
+        /* Arrays are combined element by element, single values are
+         * used for every element.
+         */
+        if (parg->nval != 1 && (nelem < 0 || parg->nval < nelem))
+            nelem = parg->nval;
+    }
+    *pnelem = nelem < 0 ? 1 : nelem;
+    return 0;
+}
+
+/* Evaluate the expression for each element */
+static long calculate(acalc_link *clink, long nelem)
+{
+    double arg[CALCPERFORM_NARGS];
+    double val = 0;
+    long status;
+    long i;
+    int j;
+
+    if (growBuffer(&clink->pres, &clink->rsize, nelem))
+        return S_db_noMemory;
+
+    for (i = 0; i < nelem; i++) {
+        memcpy(arg, clink->arg, sizeof(arg));
+        for (j = 0; j < clink->nArgs; j++) {
+            if (clink->varg[j].nval > 1)
+                arg[j] = clink->varg[j].pval[i];
+        }
+        /* VAL is the result for the previous element */
+        status = calcPerform(arg, &val, clink->post_expr);
+        if (status)
+            return status;
+        clink->pres[i] = val;
+    }
+    clink->nres = nelem;
+    return 0;
+}
+
+static double reduce(reduce_op op, const double *pval, long n)
+{
+    double sum = 0, res;
+    long i;
+
+    switch (op) {
+    case red_min:
+        res = pval[0];
+        for (i = 1; i < n; i++)
+            if (res > pval[i] || isnan(pval[i]))
+                res = pval[i];
+        return res;
+
+    case red_max:
+        res = pval[0];
+        for (i = 1; i < n; i++)
+            if (res < pval[i] || isnan(pval[i]))
+                res = pval[i];
+        return res;
+
+    default:
+        break;
+    }
+
+    for (i = 0; i < n; i++)
+        sum += pval[i];
+    if (op == red_sum)
+        return sum;
+    res = sum / n;
+    if (op == red_mean)
+        return res;
+
+    /* Population standard deviation, two passes for accuracy */
+    sum = 0;
+    for (i = 0; i < n; i++)
+        sum += (pval[i] - res) * (pval[i] - res);
+    return sqrt(sum / n);
+}
+
+static long lnkACalc_getValue(struct link *plink, short dbrType, void *pbuffer,
+    long *pnRequest)
+{
+    acalc_link *clink = CONTAINER(plink->value.json.jlink,
+        struct acalc_link, jlink);
+    long nRequest = pnRequest ? *pnRequest : 1;
+    long nelem;
+    long status;
+    FASTCONVERT conv;
+    short dbrSize;
+    long i;
+
+    if(INVALID_DB_REQ(dbrType))
+        return S_db_badDbrtype;
+
+    conv = dbFastPutConvertRoutine[DBR_DOUBLE][dbrType];
+    dbrSize = dbValueSize(dbrType);
+
+    status = readInputs(clink, plink->precord, &nelem);
+    if (!status) {
+        if (!clink->reduce && nelem > nRequest)
+            nelem = nRequest;
+        status = calculate(clink, nelem);
+        if (status)
+            recGblSetSevrMsg(plink->precord, LINK_ALARM, INVALID_ALARM,
+                "acalc calcPerform error");
+    }
+    if (status) {
+        clink->nres = 0;
+        if (pnRequest)
+            *pnRequest = 0;
+        return status;
+    }
+
+    if (clink->reduce) {
+        clink->val = reduce(clink->reduce, clink->pres, nelem);
+        status = conv(&clink->val, pbuffer, NULL);
+        nelem = 1;
+    }
+    else {
+        clink->val = clink->pres[0];
+        for (i = 0; !status && i < nelem; i++)
+            status = conv(&clink->pres[i], (char *) pbuffer + i * dbrSize,
+                NULL);
+    }
+
+    if (!status && pnRequest)
+        *pnRequest = nelem;
+    return status;
+}
+
+static long lnkACalc_getPrecision(const struct link *plink, short *precision)
+{
+    acalc_link *clink = CONTAINER(plink->value.json.jlink,
+        struct acalc_link, jlink);
+
+    *precision = clink->prec;
+    return 0;
+}
+
+static long lnkACalc_getUnits(const struct link *plink, char *units, int len)
+{
+    acalc_link *clink = CONTAINER(plink->value.json.jlink,
+        struct acalc_link, jlink);
+
+    if (clink->units) {
+        strncpy(units, clink->units, --len);
+        units[len] = '\0';
+    }
+    else
+        units[0] = '\0';
+    return 0;
+}
+
+static long doLocked(struct link *plink, dbLinkUserCallback rtn, void *priv)
+{
+    return rtn(plink, priv);
+}
+
+
+/************************* Interface Tables *************************/
+
+static lset lnkACalc_lset = {
+    0, 1, /* not Constant, Volatile */
+    lnkACalc_open, lnkACalc_remove,
+    NULL, NULL, NULL,
+    lnkACalc_isConn, lnkACalc_getDBFtype, lnkACalc_getElements,
+    lnkACalc_getValue,
+    NULL, NULL, NULL,
+    lnkACalc_getPrecision, lnkACalc_getUnits,
+    NULL, NULL,
+    NULL, NULL,
+    NULL, doLocked
+};
+
+static jlif lnkACalcIf = {
+    "acalc", lnkACalc_alloc, lnkACalc_free,
+    NULL, NULL, lnkACalc_integer, lnkACalc_double, lnkACalc_string,
+    lnkACalc_start_map, lnkACalc_map_key, lnkACalc_end_map,
+    lnkACalc_start_array, lnkACalc_end_array,
+    lnkACalc_end_child, lnkACalc_get_lset,
+    lnkACalc_report, lnkACalc_map_children, NULL
+};
+epicsExportAddress(jlif, lnkACalcIf);
@@ -91,6 +91,9 @@ static long do_sub(aSubRecord *);
 
 #define NUM_ARGS        21
 
+/* Each array in an allocation starts on this boundary */
+#define ARRAY_ALIGN     8
+
 /* These are the names of the Input fields */
 static const char *Ifldnames[] = {
     "A", "B", "C", "D", "E", "F", "G", "H", "I", "J", "K",
@@ -172,37 +175,42 @@ static long init_record(struct dbCommon *pcommon, int pass)
 }
 
 
+/* All the arrays of a set are carved out of a single allocation */
 static long initFields(epicsEnum16 *pft, epicsUInt32 *pno, epicsUInt32 *pne,
     epicsUInt32 *pon, const char **fldnames, void **pval, void **povl)
 {
+    size_t size[NUM_ARGS];
+    size_t total = 0;
+    char *pbuf, *povlbuf = NULL;
     int i;
-    long status = 0;
 
-    for (i = 0; i < NUM_ARGS; i++, pft++, pno++, pne++, pval++) {
-        epicsUInt32 num;
-        epicsUInt32 flen;
-
-        if (*pft > DBF_ENUM)
-            *pft = DBF_CHAR;
+    for (i = 0; i < NUM_ARGS; i++) {
+        if (pft[i] > DBF_ENUM)
+            pft[i] = DBF_CHAR;
 
-        if (*pno == 0)
-            *pno = 1;
+        if (pno[i] == 0)
+            pno[i] = 1;
 
-        flen = dbValueSize(*pft);
-        num = *pno * flen;
-        *pval = callocMustSucceed(*pno, flen, "aSubRecord::init_record");
+        size[i] = (size_t) pno[i] * dbValueSize(pft[i]);
+        size[i] = (size[i] + ARRAY_ALIGN - 1) & ~(size_t) (ARRAY_ALIGN - 1);
+        total += size[i];
+    }
 
-        *pne = *pno;
+    pbuf = callocMustSucceed(1, total, "aSubRecord::init_record");
+    if (povl)
+        povlbuf = callocMustSucceed(1, total, "aSubRecord::init_record");
 
+    for (i = 0; i < NUM_ARGS; i++) {
+        pval[i] = pbuf;
+        pbuf += size[i];
+        pne[i] = pno[i];
         if (povl) {
-            if (num)
-                *povl = callocMustSucceed(*pno, flen,
-                    "aSubRecord::init_record");
-            povl++;
-            *pon++ = *pne;
+            povl[i] = povlbuf;
+            povlbuf += size[i];
+            pon[i] = pne[i];
         }
     }
-    return status;
+    return 0;
 }
 
 
@@ -39,6 +39,9 @@
 
 #define indexof(field) compressRecord##field
 
+/* Number of results computed in each pass of compress_array() */
+#define BLOCK 64
+
 /* Create RSET - Record Support Entry Table*/
 #define report NULL
 #define initialize NULL
@@ -109,27 +112,51 @@ static void monitor(compressRecord *prec)
     db_post_events(prec, (void*)&prec->val, monitor_mask);
 }
 
-static void put_value(compressRecord *prec, double *psource, int n)
+static void put_value(compressRecord *prec, const double *psource,
+    epicsUInt32 n)
 {
-    int fifo = (prec->balg == bufferingALG_FIFO);
+    double *pbuf = prec->bptr;
     epicsUInt32 offset = prec->off;
     epicsUInt32 nuse = prec->nuse;
     epicsUInt32 nsam = prec->nsam;
+    epicsUInt32 first, i;
 
-    nuse += n;
-    if (nuse > nsam)
+    if (n >= nsam - nuse)
         nuse = nsam;
+    else
+        nuse += n;
 
-    while (n--) {
-        /* for LIFO, pre-decrement modulo nsam */
-        if (!fifo)
-            offset = (offset + nsam - 1) % nsam;
+    /* only the last nsam values will remain in the buffer */
+    if (n > nsam) {
+        epicsUInt32 skip = n - nsam;
 
-        prec->bptr[offset] = *psource++;
+        psource += skip;
+        if (prec->balg == bufferingALG_FIFO)
+            offset = (offset + skip) % nsam;
+        else
+            offset = (offset + nsam - skip % nsam) % nsam;
+        n = nsam;
+    }
 
-        /* for FIFO, post-increment modulo nsam */
-        if (fifo)
-            offset = (offset + 1) % nsam;
+    if (prec->balg == bufferingALG_FIFO) {
+        /* copy forward from offset, wrapping at most once */
+        first = nsam - offset;
+        if (first > n)
+            first = n;
+        memcpy(pbuf + offset, psource, first * sizeof(double));
+        memcpy(pbuf, psource + first, (n - first) * sizeof(double));
+        offset = (offset + n) % nsam;
+    }
+    else {
+        /* copy backward from offset - 1, wrapping at most once */
+        first = offset;
+        if (first > n)
+            first = n;
+        for (i = 0; i < first; i++)
+            pbuf[offset - 1 - i] = psource[i];
+        for (i = first; i < n; i++)
+            pbuf[nsam - 1 - (i - first)] = psource[i];
+        offset = (offset + nsam - n) % nsam;
     }
 
     prec->off = offset;
@@ -148,13 +175,70 @@ static int compare(const void *arg1, const void *arg2)
     else               return  1;
 }
 
+/* Compress nout groups of n values each from psource into pdest.
+ * The loops run across the groups, so each result is calculated in the
+ * same order as by a simple loop over its group, but compilers are able
+ * to vectorize them.
+ */
+static void compress_block(int alg, double *psource, double *pdest,
+    epicsInt32 nout, epicsInt32 n)
+{
+    epicsInt32 i, j;
+
+    switch (alg) {
+    case compressALG_N_to_1_Low_Value:
+        /* compress N to 1 keeping the lowest value */
+        for (i = 0; i < nout; i++)
+            pdest[i] = psource[i * n];
+        for (j = 1; j < n; j++) {
+            for (i = 0; i < nout; i++) {
+                double value = psource[i * n + j];
+
+                pdest[i] = value < pdest[i] ? value : pdest[i];
+            }
+        }
+        break;
+    case compressALG_N_to_1_High_Value:
+        /* compress N to 1 keeping the highest value */
+        for (i = 0; i < nout; i++)
+            pdest[i] = psource[i * n];
+        for (j = 1; j < n; j++) {
+            for (i = 0; i < nout; i++) {
+                double value = psource[i * n + j];
+
+                pdest[i] = pdest[i] < value ? value : pdest[i];
+            }
+        }
+        break;
+    case compressALG_N_to_1_Average:
+        /* compress N to 1 keeping the average value */
+        for (i = 0; i < nout; i++)
+            pdest[i] = psource[i * n];
+        for (j = 1; j < n; j++) {
+            for (i = 0; i < nout; i++)
+                pdest[i] += psource[i * n + j];
+        }
+        for (i = 0; i < nout; i++)
+            pdest[i] /= n;
+        break;
+    case compressALG_N_to_1_Median:
+        /* compress N to 1 keeping the median value */
+        /* note: sorts source array (OK; it's a work pointer) */
+        for (i = 0; i < nout; i++) {
+            qsort(psource + i * n, n, sizeof(double), compare);
+            pdest[i] = psource[i * n + n / 2];
+        }
+        break;
+    }
+}
+
 static int compress_array(compressRecord *prec,
     double *psource, int no_elements)
 {
-    epicsInt32 i,j;
+    epicsInt32 i;
     epicsInt32 n, nnew;
     epicsInt32 nsam = prec->nsam;
-    double value;
+    double result[BLOCK];
 
     /* skip out of limit data */
     if (prec->ilil < prec->ihil) {
@@ -176,49 +260,11 @@ static int compress_array(compressRecord *prec,
     else nnew = nsam;
 
     /* compress according to specified algorithm */
-    switch (prec->alg){
-    case compressALG_N_to_1_Low_Value:
-        /* compress N to 1 keeping the lowest value */
-        for (i = 0; i < nnew; i++) {
-            value = *psource++;
-            for (j = 1; j < n; j++, psource++) {
-                if (value > *psource)
-                    value = *psource;
-            }
-            put_value(prec, &value, 1);
-        }
-        break;
-    case compressALG_N_to_1_High_Value:
-        /* compress N to 1 keeping the highest value */
-        for (i = 0; i < nnew; i++){
-            value = *psource++;
-            for (j = 1; j < n; j++, psource++) {
-                if (value < *psource)
-                    value = *psource;
-            }
-            put_value(prec, &value, 1);
-        }
-        break;
-    case compressALG_N_to_1_Average:
-        /* compress N to 1 keeping the average value */
-        for (i = 0; i < nnew; i++) {
-            value = 0;
-            for (j = 0; j < n; j++, psource++)
-                value += *psource;
-            value /= n;
-            put_value(prec, &value, 1);
-        }
-        break;
+    for (i = 0; i < nnew; i += BLOCK) {
+        epicsInt32 nout = nnew - i < BLOCK ? nnew - i : BLOCK;
 
-    case compressALG_N_to_1_Median:
-        /* compress N to 1 keeping the median value */
-        /* note: sorts source array (OK; it's a work pointer) */
-        for (i = 0; i < nnew; i++, psource += nnew) {
-            qsort(psource, n, sizeof(double), compare);
-            value = psource[n / 2];
-            put_value(prec, &value, 1);
-        }
-        break;
+        compress_block(prec->alg, psource + i * n, result, nout, n);
+        put_value(prec, result, nout);
     }
     return 0;
 }
@@ -21,12 +21,19 @@
 
 #include "dbDefs.h"
 #include "epicsPrint.h"
+#include "epicsAtomic.h"
 #include "alarm.h"
+#include "callback.h"
+#include "cantProceed.h"
 #include "dbAccess.h"
+#include "dbChannel.h"
 #include "dbEvent.h"
 #include "dbFldTypes.h"
+#include "dbNotify.h"
 #include "errMdef.h"
 #include "epicsTypes.h"
+#include "link.h"
+#include "menuYesNo.h"
 #include "recSup.h"
 #include "recGbl.h"
 #include "dbCommon.h"
@@ -78,6 +85,115 @@ rset fanoutRSET = {
     get_alarm_double
 };
 epicsExportAddress(rset,fanoutRSET);
+
+/* Targets processed in parallel (PARL=YES) */
+typedef struct fanoutTarget {
+    epicsCallback callback;
+    processNotify notify;
+    struct fanoutPvt *ppvt;
+} fanoutTarget;
+
+typedef struct fanoutPvt {
+    struct fanoutRecord *prec;
+    epicsCallback done;
+    int pending;
+    epicsUInt16 oldn;
+    fanoutTarget targets[NLINKS];
+} fanoutPvt;
+
+/* Like a CA forward link, process the target by writing to its PROC field */
+static int targetPut(processNotify *ppn, notifyPutType type)
+{
+    epicsUInt8 one = 1;
+
+    if (type == putDisabledType)
+        return 0;
+    return !dbChannelPut(ppn->chan, DBR_UCHAR, &one, 1);
+}
+
+static void targetDone(processNotify *ppn)
+{
+    fanoutTarget *ptarget = (fanoutTarget *) ppn->usrPvt;
+    fanoutPvt *ppvt = ptarget->ppvt;
+
+    /* The last target to finish completes the fanout */
+    if (epicsAtomicDecrIntT(&ppvt->pending) == 0)
+        callbackRequestProcessCallback(&ppvt->done, ppvt->prec->prio,
+            ppvt->prec);
+}
+
+static void targetProcess(epicsCallback *pcallback)
+{
+    fanoutTarget *ptarget;
+
+    callbackGetUser(ptarget, pcallback);
+    dbProcessNotify(&ptarget->notify);
+}
+
+/* Hand the target of a CA link to a local record over to a callback thread.
+ * Returns FALSE if the link has to be processed by dbScanFwdLink() instead.
+ */
+static int dispatchLink(struct fanoutRecord *prec, struct link *plink)
+{
+    fanoutPvt *ppvt = prec->rpvt;
+    fanoutTarget *ptarget = &ppvt->targets[plink - &prec->lnk0];
+    const char *pvname = plink->value.pv_link.pvname;
+    dbChannel *chan = ptarget->notify.chan;
+
+    /* DB links are in our lock set, they can't be processed elsewhere */
+    if (plink->type != CA_LINK ||
+        !(plink->value.pv_link.pvlMask & pvlOptFWD))
+        return FALSE;
+
+    if (!chan || strcmp(dbChannelName(chan), pvname) != 0) {
+        if (chan)
+            dbChannelDelete(chan);
+        ptarget->notify.chan = chan = dbChannelCreate(pvname);
+        if (chan && dbChannelOpen(chan)) {
+            dbChannelDelete(chan);
+            ptarget->notify.chan = chan = NULL;
+        }
+        if (!chan)  /* Not a local record */
+            return FALSE;
+    }
+
+    callbackSetPriority(prec->prio, &ptarget->callback);
+    epicsAtomicIncrIntT(&ppvt->pending);
+    if (callbackRequest(&ptarget->callback)) {
+        /* Queue full, the pending count can't reach zero here */
+        epicsAtomicDecrIntT(&ppvt->pending);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static void scanLink(struct fanoutRecord *prec, struct link *plink,
+    int parallel)
+{
+    if (!parallel || !dispatchLink(prec, plink))
+        dbScanFwdLink(plink);
+}
+
+static fanoutPvt * createPvt(struct fanoutRecord *prec)
+{
+    fanoutPvt *ppvt = callocMustSucceed(1, sizeof(fanoutPvt),
+        "fanoutRecord");
+    int i;
+
+    ppvt->prec = prec;
+    for (i = 0; i < NLINKS; i++) {
+        fanoutTarget *ptarget = &ppvt->targets[i];
+
+        callbackSetCallback(targetProcess, &ptarget->callback);
+        callbackSetUser(ptarget, &ptarget->callback);
+        ptarget->notify.requestType = putProcessRequest;
+        ptarget->notify.putCallback = targetPut;
+        ptarget->notify.doneCallback = targetDone;
+        ptarget->notify.usrPvt = ptarget;
+        ptarget->ppvt = ppvt;
+    }
+    return ppvt;
+}
 
 static long init_record(struct dbCommon *pcommon, int pass)
 {
@@ -89,16 +205,51 @@ static long init_record(struct dbCommon *pcommon, int pass)
     return 0;
 }
 
+static void complete(struct fanoutRecord *prec, epicsUInt16 oldn)
+{
+    epicsUInt16 events;
+
+    prec->udf = FALSE;
+    recGblGetTimeStamp(prec);
+
+    /* post monitors */
+    events = recGblResetAlarms(prec);
+    if (events)
+        db_post_events(prec, &prec->val, events);
+    if (prec->seln != oldn)
+        db_post_events(prec, &prec->seln, events | DBE_VALUE | DBE_LOG);
+
+    /* finish off */
+    recGblFwdLink(prec);
+    prec->pact = FALSE;
+}
+
 static long process(struct dbCommon *pcommon)
 {
     struct fanoutRecord *prec = (struct fanoutRecord *)pcommon;
+    fanoutPvt *ppvt = prec->rpvt;
     struct link *plink;
-    epicsUInt16 seln, events;
+    epicsUInt16 seln;
     int         i;
     epicsUInt16 oldn = prec->seln;
+    int parallel = prec->parl == menuYesNoYES;
+
+    if (prec->pact) {
+        /* All targets processed in parallel have completed */
+        complete(prec, ppvt->oldn);
+        return 0;
+    }
 
     prec->pact = TRUE;
 
+    if (parallel) {
+        if (!ppvt)
+            prec->rpvt = ppvt = createPvt(prec);
+        ppvt->oldn = oldn;
+        /* Hold off completion until all targets have been dispatched */
+        ppvt->pending = 1;
+    }
+
     /* fetch link selection */
     dbGetLink(&prec->sell, DBR_USHORT, &prec->seln, 0, 0);
     seln = prec->seln;
@@ -107,7 +258,7 @@ static long process(struct dbCommon *pcommon)
     case fanoutSELM_All:
         plink = &prec->lnk0;
         for (i = 0; i < NLINKS; i++, plink++) {
-            dbScanFwdLink(plink);
+            scanLink(prec, plink, parallel);
         }
         break;
 
@@ -118,7 +269,7 @@ static long process(struct dbCommon *pcommon)
             break;
         }
         plink = &prec->lnk0 + i;
-        dbScanFwdLink(plink);
+        scanLink(prec, plink, parallel);
         break;
 
     case fanoutSELM_Mask:
@@ -135,24 +286,16 @@ static long process(struct dbCommon *pcommon)
         plink = &prec->lnk0;
         for (i = 0; i < NLINKS; i++, seln >>= 1, plink++) {
             if (seln & 1)
-                dbScanFwdLink(plink);
+                scanLink(prec, plink, parallel);
         }
         break;
     default:
         recGblSetSevr(prec, SOFT_ALARM, INVALID_ALARM);
     }
-    prec->udf = FALSE;
-    recGblGetTimeStamp(prec);
 
-    /* post monitors */
-    events = recGblResetAlarms(prec);
-    if (events)
-        db_post_events(prec, &prec->val, events);
-    if (prec->seln != oldn)
-        db_post_events(prec, &prec->seln, events | DBE_VALUE | DBE_LOG);
+    if (parallel && epicsAtomicDecrIntT(&ppvt->pending) != 0)
+        return 0;   /* targetDone() will complete the record */
 
-    /* finish off */
-    recGblFwdLink(prec);
-    prec->pact = FALSE;
+    complete(prec, oldn);
     return 0;
 }
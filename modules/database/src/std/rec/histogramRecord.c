@@ -24,8 +24,10 @@
 
 #include "dbDefs.h"
 #include "epicsPrint.h"
+#include "epicsMath.h"
 #include "alarm.h"
 #include "callback.h"
+#include "cantProceed.h"
 #include "dbAccess.h"
 #include "dbEvent.h"
 #include "epicsPrint.h"
@@ -44,6 +46,9 @@
 
 #define indexof(field) histogramRecord##field
 
+/* Number of samples binned in each pass of add_count() */
+#define CHUNK 256
+
 /* Create RSET - Record Support Entry Table*/
 #define report NULL
 #define initialize NULL
@@ -94,9 +99,11 @@ typedef struct myCallback {
     histogramRecord *prec;
 } myCallback;
 
-static long add_count(histogramRecord *);
+static long add_count(histogramRecord *, const double *psig, epicsUInt32 n);
 static long clear_histogram(histogramRecord *);
+static void set_width(histogramRecord *);
 static void monitor(histogramRecord *);
+static void post_stats(histogramRecord *, unsigned short monitor_mask);
 static long readValue(histogramRecord *);
 
 
@@ -112,6 +119,7 @@ static void wdogCallback(epicsCallback *arg)
         dbScanLock((struct dbCommon *)prec);
         recGblGetTimeStamp(prec);
         db_post_events(prec, (void*)&prec->val, DBE_VALUE | DBE_LOG);
+        post_stats(prec, DBE_VALUE | DBE_LOG);
         prec->mcnt = 0;
         dbScanUnlock((struct dbCommon *)prec);
     }
@@ -157,11 +165,19 @@ static long init_record(struct dbCommon *pcommon, int pass)
         if (!prec->bptr) {
             if (prec->nelm <= 0)
                 prec->nelm = 1;
-            prec->bptr = calloc(prec->nelm, sizeof(epicsUInt32));
+            prec->bptr = callocMustSucceed(prec->nelm, sizeof(epicsUInt64),
+                "histogram calloc failed");
         }
 
+        /* allocate space for array input */
+        if (prec->snel == 0)
+            prec->snel = 1;
+        if (prec->snel > 1 && !prec->sptr)
+            prec->sptr = callocMustSucceed(prec->snel, sizeof(double),
+                "histogram calloc failed");
+
         /* calculate width of array element */
-        prec->wdth = (prec->ulim - prec->llim) / prec->nelm;
+        set_width(prec);
         return 0;
     }
 
@@ -206,6 +222,8 @@ static long process(struct dbCommon *pcommon)
         return S_dev_missingSup;
     }
 
+    if (!pact)
+        prec->snrd = 0;
     status = readValue(prec); /* read the new value */
 
     /* check if device support set pact */
@@ -215,8 +233,12 @@ static long process(struct dbCommon *pcommon)
 
     recGblGetTimeStampSimm(prec, prec->simm, &prec->siol);
 
-    if (status == 0)
-        add_count(prec);
+    if (status == 0) {
+        if (prec->snrd > 0 && prec->sptr)
+            add_count(prec, prec->sptr, prec->snrd);
+        else
+            add_count(prec, &prec->sgnl, 1);
+    }
     else if (status == 2)
         status = 0;
 
@@ -260,7 +282,7 @@ static long special(DBADDR *paddr, int after)
 
     case SPC_MOD:
         /* increment frequency in histogram array */
-        add_count(prec);
+        add_count(prec, &prec->sgnl, 1);
         return 0;
 
     case SPC_RESET:
@@ -268,7 +290,7 @@ static long special(DBADDR *paddr, int after)
             wdogInit(prec);
         }
         else {
-            prec->wdth = (prec->ulim - prec->llim) / prec->nelm;
+            set_width(prec);
             clear_histogram(prec);
         }
         return 0;
@@ -290,20 +312,75 @@ static void monitor(histogramRecord *prec)
         prec->mcnt = 0;
     }
     /* send out monitors connected to the value field */
-    if (monitor_mask)
+    if (monitor_mask) {
         db_post_events(prec, (void*)&prec->val, monitor_mask);
+        post_stats(prec, monitor_mask);
+    }
 
     return;
 }
+
+static double percentile(histogramRecord *prec, epicsUInt64 total,
+    double pct)
+{
+    double rank = pct / 100.0 * total;
+    double cumul = 0;
+    double bin;
+    int i;
+
+    if (rank <= 0)
+        rank = 0;
+    for (i = 0; i < prec->nelm - 1; i++) {
+        if (cumul + prec->bptr[i] >= rank && prec->bptr[i] > 0)
+            break;
+        cumul += prec->bptr[i];
+    }
+    bin = i;
+    if (prec->bptr[i] > 0) {
+        double frac = (rank - cumul) / prec->bptr[i];
+
+        bin += frac < 1.0 ? frac : 1.0;
+    }
+    else
+        bin += 1.0;
+
+    if (prec->bspc == histogramBSPC_Log)
+        return prec->llim * pow(10.0, bin * prec->wdth);
+    return prec->llim + bin * prec->wdth;
+}
+
+static void post_stats(histogramRecord *prec, unsigned short monitor_mask)
+{
+    epicsUInt64 total = 0;
+    int i;
+
+    if (monitor_mask & DBE_VALUE) {
+        for (i = 0; i < prec->nelm; i++)
+            total += prec->bptr[i];
+        if (total > 0) {
+            prec->pvla = percentile(prec, total, prec->pcta);
+            prec->pvlb = percentile(prec, total, prec->pctb);
+            prec->pvlc = percentile(prec, total, prec->pctc);
+        }
+    }
+    db_post_events(prec, &prec->ncnt, monitor_mask);
+    db_post_events(prec, &prec->mean, monitor_mask);
+    db_post_events(prec, &prec->sdev, monitor_mask);
+    db_post_events(prec, &prec->smin, monitor_mask);
+    db_post_events(prec, &prec->smax, monitor_mask);
+    db_post_events(prec, &prec->pvla, monitor_mask);
+    db_post_events(prec, &prec->pvlb, monitor_mask);
+    db_post_events(prec, &prec->pvlc, monitor_mask);
+}
 
 static long cvt_dbaddr(DBADDR *paddr)
 {
     histogramRecord *prec = (histogramRecord *) paddr->precord;
 
     paddr->no_elements = prec->nelm;
-    paddr->field_type = DBF_ULONG;
-    paddr->field_size = sizeof(epicsUInt32);
-    paddr->dbr_field_type = DBF_ULONG;
+    paddr->field_type = DBF_UINT64;
+    paddr->field_size = sizeof(epicsUInt64);
+    paddr->dbr_field_type = DBF_UINT64;
     return 0;
 }
 
@@ -317,36 +394,135 @@ static long get_array_info(DBADDR *paddr, long *no_elements, long *offset)
     return 0;
 }
 
-static long add_count(histogramRecord *prec)
+static void set_width(histogramRecord *prec)
+{
+    if (prec->bspc == histogramBSPC_Log)
+        prec->wdth = prec->llim > 0 ?
+            log10(prec->ulim / prec->llim) / prec->nelm : 0.0;
+    else
+        prec->wdth = (prec->ulim - prec->llim) / prec->nelm;
+}
+
+/* Find the bins for up to CHUNK samples. The loops have no branches or
+ * calls (except log10) so that compilers can vectorize them.
+ */
+static void find_bins(histogramRecord *prec, const double *psig, int n,
+    int *pbin)
+{
+    const double llim = prec->llim;
+    const double ulim = prec->ulim;
+    const double scale = 1.0 / prec->wdth;
+    const int nelm = prec->nelm;
+    double pos[CHUNK];
+    int i;
+
+    if (prec->bspc == histogramBSPC_Log) {
+        for (i = 0; i < n; i++) {
+            double sig = psig[i] >= llim && psig[i] < ulim ? psig[i] : llim;
+
+            pos[i] = log10(sig / llim) * scale;
+        }
+    }
+    else {
+        for (i = 0; i < n; i++) {
+            double sig = psig[i] >= llim && psig[i] < ulim ? psig[i] : llim;
+
+            pos[i] = (sig - llim) * scale;
+        }
+    }
+
+    /* Bins include their upper edge, and the first bin also its lower */
+    for (i = 0; i < n; i++) {
+        int bin = (int) pos[i];
+
+        bin -= (bin > 0) & (bin == pos[i]);
+        bin = bin < nelm ? bin : nelm - 1;
+        pbin[i] = (psig[i] >= llim) & (psig[i] < ulim) ? bin : nelm;
+    }
+}
+
+/* Merge the statistics of n samples into the running values */
+static void add_stats(histogramRecord *prec, const double *psig, int n)
 {
-    double temp;
-    epicsUInt32 *pdest;
+    double sum = 0, ssq = 0, smin = psig[0], smax = psig[0];
+    double mean, delta;
+    epicsUInt64 total;
     int i;
 
+    for (i = 0; i < n; i++) {
+        sum += psig[i];
+        smin = psig[i] < smin ? psig[i] : smin;
+        smax = psig[i] > smax ? psig[i] : smax;
+    }
+    mean = sum / n;
+    for (i = 0; i < n; i++)
+        ssq += (psig[i] - mean) * (psig[i] - mean);
+
+    if (prec->ncnt == 0) {
+        prec->smin = smin;
+        prec->smax = smax;
+    }
+    else {
+        if (smin < prec->smin)
+            prec->smin = smin;
+        if (smax > prec->smax)
+            prec->smax = smax;
+    }
+
+    total = prec->ncnt + n;
+    delta = mean - prec->mean;
+    prec->mean += delta * n / total;
+    prec->ssq += ssq + delta * delta * prec->ncnt * n / total;
+    prec->ncnt = total;
+    prec->sdev = total > 1 ? sqrt(prec->ssq / (total - 1)) : 0.0;
+}
+
+static long add_count(histogramRecord *prec, const double *psig, epicsUInt32 n)
+{
+    double sig[CHUNK];
+    int bins[CHUNK];
+    epicsUInt32 done;
+    epicsInt32 counted = 0;
+
     if (prec->csta == FALSE)
         return 0;
 
-    if (prec->llim >= prec->ulim) {
+    if (prec->llim >= prec->ulim ||
+        (prec->bspc == histogramBSPC_Log && prec->llim <= 0)) {
         if (prec->nsev < INVALID_ALARM) {
             prec->stat = SOFT_ALARM;
             prec->sevr = INVALID_ALARM;
-            return -1;
         }
+        return -1;
     }
-    if (prec->sgnl < prec->llim ||
-        prec->sgnl >= prec->ulim)
-        return 0;
 
-    temp = prec->sgnl - prec->llim;
-    for (i = 1; i <= prec->nelm; i++){
-        if (temp <= (double) i * prec->wdth)
+    for (done = 0; done < n; ) {
+        int m = 0;
+        int i;
+
+        /* Gather the next chunk, leaving out NaNs */
+        while (m < CHUNK && done < n) {
+            if (!isnan(psig[done]))
+                sig[m++] = psig[done];
+            done++;
+        }
+        if (m == 0)
             break;
+
+        add_stats(prec, sig, m);
+        find_bins(prec, sig, m, bins);
+        for (i = 0; i < m; i++) {
+            if (bins[i] < prec->nelm) {
+                prec->bptr[bins[i]]++;
+                counted++;
+            }
+        }
     }
-    pdest = prec->bptr + i - 1;
-    if (*pdest == (epicsUInt32) UINT_MAX)
-        *pdest = 0;
-    (*pdest)++;
-    prec->mcnt++;
+
+    if (prec->mcnt > INT_MAX - counted)
+        prec->mcnt = INT_MAX;
+    else
+        prec->mcnt += counted;
 
     return 0;
 }
@@ -357,6 +533,10 @@ static long clear_histogram(histogramRecord *prec)
 
     for (i = 0; i < prec->nelm; i++)
         prec->bptr[i] = 0;
+    prec->ncnt = 0;
+    prec->mean = prec->sdev = prec->ssq = 0.0;
+    prec->smin = prec->smax = 0.0;
+    prec->pvla = prec->pvlb = prec->pvlc = 0.0;
     prec->mcnt = prec->mdel + 1;
     prec->udf = FALSE;
 
@@ -426,6 +606,13 @@ static long get_precision(const DBADDR *paddr,long *precision)
         case indexof(SGNL):
         case indexof(SVAL):
         case indexof(WDTH):
+        case indexof(MEAN):
+        case indexof(SDEV):
+        case indexof(SMIN):
+        case indexof(SMAX):
+        case indexof(PVLA):
+        case indexof(PVLB):
+        case indexof(PVLC):
             *precision = prec->prec;
             break;
         case indexof(SDEL):
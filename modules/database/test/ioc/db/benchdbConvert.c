@@ -5,6 +5,12 @@
 * EPICS BASE is distributed subject to a Software License Agreement found
 * in file LICENSE that is included with this distribution.
 \*************************************************************************/
+
+/* Measure the array conversions of dbConvert.c for every pair of numeric
+ * field and request types, in GB/s of converted output.
+ */
+
+#include "stdio.h"
 #include "string.h"
 
 #include "cantProceed.h"
@@ -12,116 +18,127 @@
 #include "dbConvert.h"
 #include "dbDefs.h"
 #include "epicsTime.h"
-#include "epicsMath.h"
-#include "epicsAssert.h"
+#include "epicsTypes.h"
 
 #include "epicsUnitTest.h"
 #include "testMain.h"
 
-typedef struct {
-    size_t nelem, niter;
-
-    short *output;
-    short *input;
-
-    GETCONVERTFUNC getter;
-
+#define NTOTAL 20000000 /* elements converted for each pair */
+
+static const struct {
+    const char *name;
+    short type;
+    size_t size;
+} types[] = {
+    {"CHAR",   DBF_CHAR,   sizeof(epicsInt8)},
+    {"UCHAR",  DBF_UCHAR,  sizeof(epicsUInt8)},
+    {"SHORT",  DBF_SHORT,  sizeof(epicsInt16)},
+    {"USHORT", DBF_USHORT, sizeof(epicsUInt16)},
+    {"LONG",   DBF_LONG,   sizeof(epicsInt32)},
+    {"ULONG",  DBF_ULONG,  sizeof(epicsUInt32)},
+    {"INT64",  DBF_INT64,  sizeof(epicsInt64)},
+    {"UINT64", DBF_UINT64, sizeof(epicsUInt64)},
+    {"FLOAT",  DBF_FLOAT,  sizeof(epicsFloat32)},
+    {"DOUBLE", DBF_DOUBLE, sizeof(epicsFloat64)},
+};
+#define NTYPES NELEMENTS(types)
+
+/* Fill an array with small values that every type can hold */
+static void fill(void *pbuf, short type, long nelem)
+{
+    GETCONVERTFUNC getter = dbGetConvertRoutine[DBF_SHORT][type];
+    epicsInt16 *values = callocMustSucceed(nelem, sizeof(epicsInt16), "fill");
     DBADDR addr;
-} testData;
+    long i;
+
+    for (i = 0; i < nelem; i++)
+        values[i] = (epicsInt16) (i % 100);
+    memset(&addr, 0, sizeof(addr));
+    addr.field_type = DBF_SHORT;
+    addr.field_size = sizeof(epicsInt16);
+    addr.no_elements = nelem;
+    addr.pfield = values;
+    getter(&addr, pbuf, nelem, nelem, 0);
+    free(values);
+}
 
-static long runRep(testData *D)
+/* Returns GB/s written by the get (or put) routine for the pair */
+static double timePair(int put, int field, int request, long nelem,
+    long offset, void *pfield, void *pbuf)
 {
-    size_t i;
+    DBADDR addr;
+    long niter = NTOTAL / nelem;
+    long i;
+    size_t outsize = put ? types[field].size : types[request].size;
+    epicsUInt64 start;
+    double elapsed;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.field_type = types[field].type;
+    addr.field_size = (short) types[field].size;
+    addr.no_elements = nelem;
+    addr.pfield = pfield;
+
+    fill(pfield, types[field].type, nelem);
+    fill(pbuf, types[request].type, nelem);
+
+    start = epicsMonotonicGet();
+    if (put) {
+        PUTCONVERTFUNC putter =
+            dbPutConvertRoutine[types[request].type][types[field].type];
+
+        for (i = 0; i < niter; i++)
+            putter(&addr, pbuf, nelem, nelem, offset);
+    }
+    else {
+        GETCONVERTFUNC getter =
+            dbGetConvertRoutine[types[field].type][types[request].type];
 
-    for(i=0; i<D->niter; i++) {
-        D->getter(&D->addr, D->output, D->nelem, D->nelem, 0);
+        for (i = 0; i < niter; i++)
+            getter(&addr, pbuf, nelem, nelem, offset);
     }
-    return 0;
+    elapsed = (epicsMonotonicGet() - start) * 1e-9;
+
+    return elapsed > 0 ? niter * nelem * outsize / elapsed / 1e9 : 0.0;
 }
 
-static void runBench(size_t nelem, size_t niter, size_t nrep)
+static void runMatrix(int put, long nelem, long offset)
 {
-    size_t i;
-    testData tdat;
-    double *reptimes;
-    testDiag("Using %lu element arrays.",(unsigned long)nelem);
-    testDiag("run %lu reps with %lu iterations each",
-             (unsigned long)nrep, (unsigned long)niter);
-
-    reptimes = callocMustSucceed(nrep, sizeof(*reptimes), "runBench");
-    tdat.output = callocMustSucceed(nelem, sizeof(*tdat.output), "runBench");
-    tdat.input = callocMustSucceed(nelem, sizeof(*tdat.input), "runBench");
-
-    tdat.nelem = nelem;
-    tdat.niter = niter;
-
-    tdat.getter = dbGetConvertRoutine[DBF_SHORT][DBF_SHORT];
-
-    memset(&tdat.addr, 0, sizeof(tdat.addr));
-    tdat.addr.field_type = DBF_SHORT;
-    tdat.addr.field_size = nelem*sizeof(*tdat.input);
-    tdat.addr.no_elements = nelem;
-    tdat.addr.pfield = (void*)tdat.input;
-
-    for(i=0; i<nelem; i++)
-        tdat.input[i] = (short)i;
-
-    for(i=0; i<nrep; i++)
-    {
-        epicsTimeStamp start, stop;
-
-        if(epicsTimeGetCurrent(&start)!=epicsTimeOK) {
-            testAbort("Failed to get timestamp");
-            goto done;
+    void *pfield = callocMustSucceed(nelem, sizeof(epicsFloat64), "runMatrix");
+    void *pbuf = callocMustSucceed(nelem, sizeof(epicsFloat64), "runMatrix");
+    char line[128];
+    size_t src, dst, len;
+
+    testDiag("%s, %ld elements from offset %ld, GB/s written:",
+        put ? "dbPut (request type -> field type)" :
+              "dbGet (field type -> request type)", nelem, offset);
+    len = sprintf(line, "%-7s", "src\\dst");
+    for (dst = 0; dst < NTYPES; dst++)
+        len += sprintf(line + len, " %6s", types[dst].name);
+    testDiag("%s", line);
+
+    for (src = 0; src < NTYPES; src++) {
+        len = sprintf(line, "%-7s", types[src].name);
+        for (dst = 0; dst < NTYPES; dst++) {
+            double rate = put ?
+                timePair(put, dst, src, nelem, offset, pfield, pbuf) :
+                timePair(put, src, dst, nelem, offset, pfield, pbuf);
+
+            len += sprintf(line + len, " %6.2f", rate);
         }
-
-        if(runRep(&tdat))
-            goto done;
-
-        if(epicsTimeGetCurrent(&stop)!=epicsTimeOK) {
-            testAbort("Failed to get timestamp");
-            goto done;
-        }
-
-        reptimes[i] = epicsTimeDiffInSeconds(&stop, &start);
-
-        testDiag("%lu bytes in %.03f ms.  %.1f MB/s",
-                 (unsigned long)(nelem*niter),
-                 reptimes[i]*1e3,
-                 (nelem*niter)/reptimes[i]/1e6);
-    }
-
-    {
-        double sum=0, sum2=0, mean;
-        for(i=0; i<nrep; i++) {
-            sum += reptimes[i];
-            sum2 += reptimes[i]*reptimes[i];
-        }
-
-        mean = sum/nrep;
-        testDiag("Final: %.04f ms +- %.05f ms.  %.1f MB/s  (for %lu elements)",
-                 mean*1e3,
-                 sqrt(sum2/nrep - mean*mean)*1e3,
-                 (nelem*niter)/mean/1e6,
-                 (unsigned long)nelem);
+        testDiag("%s", line);
     }
 
-done:
-    free(reptimes);
-    free(tdat.input);
-    free(tdat.output);
+    free(pfield);
+    free(pbuf);
 }
 
 MAIN(benchdbConvert)
 {
     testPlan(0);
-    runBench(1, 10000000, 10);
-    runBench(2,  5000000, 10);
-    runBench(10, 1000000, 10);
-    runBench(100, 100000, 10);
-    runBench(10000, 1000, 10);
-    runBench(100000, 100, 10);
-    runBench(1000000, 10, 10);
-    runBench(10000000, 1, 10);
+    runMatrix(0, 10000, 0);
+    runMatrix(0, 10000, 5000);
+    runMatrix(1, 10000, 0);
+    runMatrix(0, 10, 0);
     return testDone();
 }
@@ -0,0 +1,129 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+ \*************************************************************************/
+
+#include <string.h>
+
+#include <epicsStdio.h>
+#include <dbAccess.h>
+#include <dbCommon.h>
+#include <dbStaticLib.h>
+#include <dbUnitTest.h>
+#include <testMain.h>
+
+#define NRECS 100
+#define LONGER "a value of forty characters, more or less"
+
+void dbTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+static void *precords[NRECS];
+
+static void createRecords(DBENTRY *pentry, int first, int last)
+{
+    int i;
+
+    for (i = first; i < last; i++) {
+        char name[20];
+
+        epicsSnprintf(name, sizeof(name), "arena%d", i);
+        if (dbFindRecordType(pentry, "x") || dbCreateRecord(pentry, name))
+            testAbort("Can't create %s", name);
+        precords[i] = pentry->precnode->precord;
+    }
+}
+
+MAIN(dbArenaTest)
+{
+    DBENTRY entry;
+    ptrdiff_t stride;
+    void *pdeleted;
+    const char *pslots[2];
+    char *pshort;
+    char longValue[20000];
+    int i, contiguous = 1, reused = 1;
+
+    testPlan(21);
+
+    testdbPrepare();
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    dbInitEntry(pdbbase, &entry);
+    createRecords(&entry, 0, NRECS);
+
+    /* The first chunk holds 8 records, the later ones more */
+    stride = (char *) precords[1] - (char *) precords[0];
+    testOk(stride >= (ptrdiff_t) entry.precordType->rec_size,
+        "Stride %ld holds a record of %d bytes", (long) stride,
+        entry.precordType->rec_size);
+    for (i = 1; i < 8; i++)
+        if ((char *) precords[i] - (char *) precords[i - 1] != stride)
+            contiguous = 0;
+    testOk(contiguous, "Records of one type are next to each other");
+
+    testOk1(!dbFindRecord(&entry, "arena0") &&
+        !strcmp(entry.precnode->recordname, "arena0"));
+    testOk1(!dbFindRecord(&entry, "arena99") &&
+        entry.precnode->precord == precords[99]);
+
+    testDiag("Aliases and info items");
+    testOk1(!dbFindRecord(&entry, "arena5") &&
+        !dbCreateAlias(&entry, "arena5alias"));
+    testOk1(!dbFindRecord(&entry, "arena5alias") &&
+        entry.precnode->precord == precords[5]);
+    testOk1(!dbFindRecord(&entry, "arena5") &&
+        !dbPutInfo(&entry, "first", "one") &&
+        !dbPutInfo(&entry, "second", "two"));
+    testOk1(!dbPutInfo(&entry, "first", "a longer value") &&
+        !strcmp(dbGetInfo(&entry, "first"), "a longer value") &&
+        !strcmp(dbGetInfo(&entry, "second"), "two"));
+    testOk1(!dbFindInfo(&entry, "second") && !dbDeleteInfo(&entry) &&
+        dbGetInfo(&entry, "second") == NULL);
+
+    testDiag("Replaced strings are reused");
+    testOk1(!dbFindInfo(&entry, "first"));
+    for (i = 0; i < 100; i++) {
+        const char *pvalue;
+
+        if (dbPutInfoString(&entry, i & 1 ? "a longer value" : "another value"))
+            reused = 0;
+        pvalue = dbGetInfo(&entry, "first");
+        if (i < 2)
+            pslots[i] = pvalue;
+        else if (pvalue != pslots[i & 1])
+            reused = 0;
+    }
+    testOk(reused, "Replacing a string alternates between two slots");
+    testOk1(!dbPutInfoString(&entry, dbGetInfo(&entry, "first")) &&
+        !strcmp(dbGetInfo(&entry, "first"), "a longer value"));
+    memset(longValue, 'x', sizeof(longValue) - 1);
+    longValue[sizeof(longValue) - 1] = 0;
+    testOk1(!dbPutInfoString(&entry, longValue) &&
+        !strcmp(dbGetInfo(&entry, "first"), longValue));
+    testOk1(!dbPutInfoString(&entry, "short") &&
+        !strcmp(dbGetInfo(&entry, "first"), "short"));
+
+    testDiag("A string shortened in place is freed to its own slot size");
+    testOk1(!dbPutInfo(&entry, "shortened", LONGER));
+    pshort = (char *) dbGetInfo(&entry, "shortened");
+    pshort[3] = '\0';
+    testOk1(!dbPutInfoString(&entry, "x"));
+    testOk1(!dbPutInfo(&entry, "other", LONGER) &&
+        dbGetInfo(&entry, "other") == pshort);
+
+        testDiag("Deleted records are reused");
+    pdeleted = precords[42];
+    testOk1(!dbFindRecord(&entry, "arena42") && !dbDeleteRecord(&entry));
+    testOk1(dbFindRecord(&entry, "arena42") == S_dbLib_recNotFound);
+    createRecords(&entry, 42, 43);
+    testOk(precords[42] == pdeleted, "New record uses the deleted space");
+    testOk1(!dbFindRecord(&entry, "arena42") &&
+        !strcmp(((dbCommon *) entry.precnode->precord)->name, "arena42"));
+
+    dbFinishEntry(&entry);
+    testdbCleanup();
+
+    return testDone();
+}
@@ -83,3 +83,106 @@ void dbCaLinkTest_testCAC(void)
         testAbort("Unexpected exception in testCAC: %s", e.what());
     }
 }
+
+extern "C" void dbCaLinkTest_setPact(const char *name, int pact);
+
+static epicsEvent *batchDone;
+static put_batch_handler_args batchArgs;
+
+extern "C"
+void putBatchCallback(struct put_batch_handler_args args)
+{
+    batchArgs = args;
+    batchDone->signal();
+}
+
+static void getDoubles(chid chanid, double *buf, unsigned long count)
+{
+    testECA(ca_array_get(DBR_DOUBLE, count, chanid, buf));
+    testECA(ca_pend_io(1.0));
+}
+
+extern "C"
+void dbCaLinkTest_testPutBatch(void)
+{
+    try {
+        CATestContext ctxt;
+        epicsEvent done;
+        chid chan1 = 0, chan2 = 0, chan3 = 0;
+        double dvals[3] = {1.5, 2.5, 3.5}, dget[3];
+        dbr_long_t lvals[2] = {7, 8};
+
+        batchDone = &done;
+        testECA(ca_create_channel("target1", NULL, NULL, 0, &chan1));
+        testECA(ca_create_channel("target2", NULL, NULL, 0, &chan2));
+        testECA(ca_create_channel("target1", NULL, NULL, 0, &chan3));
+        testECA(ca_pend_io(1.0));
+
+        testDiag("All writes succeed");
+        {
+            ca_put_batch_item items[2] = {
+                {DBR_DOUBLE, 3, chan1, dvals, -1},
+                {DBR_LONG, 2, chan2, lvals, -1},
+            };
+            testECA(ca_put_batch(items, 2, putBatchCallback, &ctxt));
+            testOk1(done.wait(5.0));
+            testOk1(batchArgs.usr == &ctxt && batchArgs.pItems == items &&
+                batchArgs.nItems == 2 && batchArgs.nFailed == 0);
+            testOk1(items[0].status == ECA_NORMAL &&
+                items[1].status == ECA_NORMAL);
+            getDoubles(chan1, dget, 3);
+            testOk1(dget[0] == 1.5 && dget[1] == 2.5 && dget[2] == 3.5);
+            getDoubles(chan2, dget, 2);
+            testOk1(dget[0] == 7.0 && dget[1] == 8.0);
+        }
+
+        testDiag("Some writes can't be queued");
+        {
+            double value = 4.5;
+            ca_put_batch_item items[3] = {
+                {DBR_DOUBLE, 1, chan1, &value, -1},
+                {DBR_DOUBLE, 1, NULL, &value, -1},
+                {-1, 1, chan2, &value, -1},
+            };
+            testECA(ca_put_batch(items, 3, putBatchCallback, NULL));
+            testOk1(done.wait(5.0));
+            testOk1(batchArgs.nItems == 3 && batchArgs.nFailed == 2);
+            testOk1(items[0].status == ECA_NORMAL);
+            testOk1(items[1].status == ECA_BADCHID);
+            testOk1(items[2].status == ECA_BADTYPE);
+            getDoubles(chan1, dget, 1);
+            testOk1(dget[0] == 4.5);
+
+            testOk1(ca_put_batch(&items[2], 1, putBatchCallback, NULL) ==
+                ECA_BADTYPE);
+            testOk(!done.tryWait(), "No callback when nothing was queued");
+        }
+
+        testDiag("Channel cleared while its write is pending");
+        {
+            double value = 9.5;
+            dbr_long_t lvalue = 9;
+            ca_put_batch_item items[2] = {
+                {DBR_DOUBLE, 1, chan3, &value, -1},
+                {DBR_LONG, 1, chan2, &lvalue, -1},
+            };
+            // target1 looks busy, so the write waits for it
+            dbCaLinkTest_setPact("target1", 1);
+            testECA(ca_put_batch(items, 2, putBatchCallback, NULL));
+            testOk(!done.tryWait(), "Batch is pending");
+            testECA(ca_clear_channel(chan3));
+            testOk(!done.tryWait(), "No callback after the channel is cleared");
+            dbCaLinkTest_setPact("target1", 0);
+            getDoubles(chan2, dget, 1);
+            testOk(dget[0] == 9.0, "Other write took place");
+            getDoubles(chan1, dget, 1);
+            testOk(dget[0] == 4.5, "Cancelled write didn't");
+        }
+
+        testECA(ca_clear_channel(chan1));
+        testECA(ca_clear_channel(chan2));
+        batchDone = NULL;
+    }catch(std::exception& e){
+        testAbort("Unexpected exception in testPutBatch: %s", e.what());
+    }
+}
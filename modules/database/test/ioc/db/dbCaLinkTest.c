@@ -610,9 +610,117 @@ static void testCAC(void)
     free(buftarg2);
 }
 
+void dbCaLinkTest_testPutBatch(void);
+
+void dbCaLinkTest_setPact(const char *name, int pact)
+{
+    dbCommon *prec = testdbRecordPtr(name);
+
+    dbScanLock(prec);
+    prec->pact = pact;
+    dbScanUnlock(prec);
+}
+
+static void testPutBatch(void)
+{
+    arrRecord *psrc, *ptarg1, *ptarg2;
+    double *bufsrc, *buftarg1;
+    epicsInt32 *buftarg2;
+
+    testDiag("Check ca_put_batch() with local CA");
+    testdbPrepare();
+
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    testdbReadDatabase("dbCaLinkTest3.db", NULL, "NELM=5,TARGET=target1");
+
+    psrc = (arrRecord*)testdbRecordPtr("source");
+    ptarg1= (arrRecord*)testdbRecordPtr("target1");
+    ptarg2= (arrRecord*)testdbRecordPtr("target2");
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    bufsrc = psrc->bptr;
+    buftarg1= ptarg1->bptr;
+    buftarg2= ptarg2->bptr;
+
+    dbCaLinkTest_testPutBatch();
+
+    testIocShutdownOk();
+
+    testdbCleanup();
+
+    free(bufsrc);
+    free(buftarg1);
+    free(buftarg2);
+}
+
+#define NWORKLINKS 8
+
+static void testWorkers(void)
+{
+    caLink *pca[NWORKLINKS];
+    int i, shared = 0;
+
+    testDiag("Links shared between dbCaLink threads");
+    testdbPrepare();
+
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    for (i = 0; i < NWORKLINKS; i++) {
+        char macros[8];
+
+        epicsSnprintf(macros, sizeof(macros), "N=%d", i);
+        testdbReadDatabase("dbCaLinkTest4.db", NULL, macros);
+    }
+
+    dbCaLinkThreads = 4;
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+    dbCaLinkThreads = 1;
+
+    testOk1(epicsThreadGetId("dbCaLink3") != NULL);
+
+    for (i = 0; i < NWORKLINKS; i++) {
+        char name[16];
+        xRecord *psrc, *ptarg;
+        epicsInt32 temp = 100 + i;
+
+        epicsSnprintf(name, sizeof(name), "source%d", i);
+        psrc = (xRecord*)testdbRecordPtr(name);
+        epicsSnprintf(name, sizeof(name), "target%d", i);
+        ptarg = (xRecord*)testdbRecordPtr(name);
+
+        testdbCaWaitForConnect(&psrc->lnk);
+        pca[i] = (caLink *) psrc->lnk.value.pv_link.pvt;
+        if (i && pca[i]->worker != pca[0]->worker)
+            shared = 1;
+
+        dbScanLock((dbCommon*)psrc);
+        putLink(&psrc->lnk, DBR_LONG, &temp, 1);
+        dbScanUnlock((dbCommon*)psrc);
+
+        dbScanLock((dbCommon*)ptarg);
+        testOp("%d", ptarg->val, ==, 100 + i);
+        dbScanUnlock((dbCommon*)ptarg);
+    }
+    testOk(shared, "Links use more than one thread");
+
+    testIocShutdownOk();
+
+    testdbCleanup();
+}
+
 MAIN(dbCaLinkTest)
 {
-    testPlan(101);
+    testPlan(156);
     testNativeLink();
     testStringLink();
     testCP();
@@ -622,5 +730,7 @@ MAIN(dbCaLinkTest)
     testArrayLink(10,10);
     testreTargetTypeChange();
     testCAC();
+    testPutBatch();
+    testWorkers();
     return testDone();
 }
@@ -0,0 +1,157 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+ \*************************************************************************/
+
+/* Measure the throughput of database links along chains of records */
+
+#include <stdio.h>
+
+#include <epicsStdio.h>
+#include <epicsTime.h>
+#include <errlog.h>
+#include <dbAccess.h>
+#include <dbLink.h>
+#include <dbLock.h>
+#include <dbUnitTest.h>
+#include <testMain.h>
+
+#include "xRecord.h"
+
+#define NRECS 1000
+#define NLOOPS 10000
+#define DBFILE "dbDbLinkPerform.db"
+
+void dbTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+static const struct {
+    const char *prefix;
+    const char *field;
+    const char *opts;
+    short dbrType;
+} chains[] = {
+    {"d:", "F64", "NPP", DBR_DOUBLE},
+    {"l:", "VAL", "NPP", DBR_LONG},
+    {"s:", "I16", "NPP", DBR_LONG},
+    {"f:", "F32", "NPP", DBR_DOUBLE},
+    {"m:", "F64", "NPP MS", DBR_DOUBLE},
+};
+#define NCHAINS (sizeof(chains) / sizeof(chains[0]))
+
+static xRecord *recs[NCHAINS][NRECS];
+
+static void writeDb(void)
+{
+    FILE *fp = fopen(DBFILE, "w");
+    unsigned j;
+
+    if (!fp)
+        testAbort("Can't create " DBFILE);
+    fprintf(fp, "record(x, \"$(P)rec0\") {}\n");
+    for (j = 1; j < NRECS; j++) {
+        fprintf(fp, "record(x, \"$(P)rec%u\") {\n", j);
+        fprintf(fp, "    field(INP, \"$(P)rec%u.$(F) $(O)\")\n", j - 1);
+        fprintf(fp, "}\n");
+    }
+    fclose(fp);
+}
+
+static double since(epicsUInt64 start)
+{
+    return (epicsMonotonicGet() - start) * 1e-9;
+}
+
+static double runGets(unsigned c)
+{
+    epicsFloat64 f64;
+    epicsInt32 i32;
+    void *pbuffer = chains[c].dbrType == DBR_DOUBLE ?
+        (void *) &f64 : (void *) &i32;
+    epicsUInt64 start;
+    unsigned i, j;
+
+    dbScanLock((dbCommon *) recs[c][0]);
+    start = epicsMonotonicGet();
+    for (i = 0; i < NLOOPS; i++) {
+        for (j = 1; j < NRECS; j++) {
+            if (dbGetLink(&recs[c][j]->inp, chains[c].dbrType, pbuffer,
+                    NULL, NULL))
+                testAbort("dbGetLink failed");
+        }
+    }
+    dbScanUnlock((dbCommon *) recs[c][0]);
+    return since(start);
+}
+
+static double runPuts(unsigned c)
+{
+    epicsFloat64 f64 = 1.0;
+    epicsInt32 i32 = 1;
+    void *pbuffer = chains[c].dbrType == DBR_DOUBLE ?
+        (void *) &f64 : (void *) &i32;
+    epicsUInt64 start;
+    unsigned i, j;
+
+    dbScanLock((dbCommon *) recs[c][0]);
+    start = epicsMonotonicGet();
+    for (i = 0; i < NLOOPS; i++) {
+        for (j = 1; j < NRECS; j++) {
+            if (dbPutLink(&recs[c][j]->inp, chains[c].dbrType, pbuffer, 1))
+                testAbort("dbPutLink failed");
+        }
+    }
+    dbScanUnlock((dbCommon *) recs[c][0]);
+    return since(start);
+}
+
+MAIN(dbDbLinkPerform)
+{
+    const double nlinks = (double) NLOOPS * (NRECS - 1);
+    unsigned c, j;
+
+    testPlan(0);
+
+    writeDb();
+    testdbPrepare();
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    for (c = 0; c < NCHAINS; c++) {
+        char macros[80];
+
+        epicsSnprintf(macros, sizeof(macros), "P=%s,F=%s,O=%s",
+            chains[c].prefix, chains[c].field, chains[c].opts);
+        if (dbLoadRecords(DBFILE, macros))
+            testAbort("Can't load " DBFILE);
+    }
+    remove(DBFILE);
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    for (c = 0; c < NCHAINS; c++) {
+        for (j = 0; j < NRECS; j++) {
+            char name[40];
+
+            epicsSnprintf(name, sizeof(name), "%srec%u", chains[c].prefix, j);
+            recs[c][j] = (xRecord *) testdbRecordPtr(name);
+        }
+    }
+
+    testDiag("Chains of %u records, %u passes", NRECS, NLOOPS);
+    for (c = 0; c < NCHAINS; c++) {
+        char label[40];
+
+        epicsSnprintf(label, sizeof(label), "%s %s as %s", chains[c].field,
+            chains[c].opts, chains[c].dbrType == DBR_DOUBLE ? "DOUBLE" : "LONG");
+        testDiag("%-24s get %6.1f ns, put %6.1f ns", label,
+            runGets(c) * 1e9 / nlinks, runPuts(c) * 1e9 / nlinks);
+    }
+
+    testIocShutdownOk();
+    testdbCleanup();
+
+    return testDone();
+}
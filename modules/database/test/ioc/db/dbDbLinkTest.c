@@ -109,9 +109,62 @@ void checkAlarm(void)
     testOk1(strcmp(amsg, "a me")==0);
 }
 
+static
+void checkGet(const char *link, short dbrType, const void *expect,
+    size_t size)
+{
+    dbCommon* src = testdbRecordPtr("src");
+    char buf[MAX_STRING_SIZE];
+    int i;
+
+    testdbPutFieldOk("src.INP", DBF_STRING, link);
+
+    /* The second get uses the cached fast path */
+    for (i = 0; i < 2; i++) {
+        long status;
+
+        memset(buf, 0xff, sizeof(buf));
+        dbScanLock(src);
+        status = dbGetLink(dbGetDevLink(src), dbrType, buf, NULL, NULL);
+        dbScanUnlock(src);
+        testOk(!status && memcmp(buf, expect, size) == 0,
+            "Get %d from %s, pass %d", dbrType, link, i);
+    }
+}
+
+static
+void checkValues(void)
+{
+    xRecord* target = (xRecord*)testdbRecordPtr("target");
+    epicsFloat64 f64 = -1.25;
+    epicsInt32 i32 = -123456;
+    epicsInt16 i16 = -1234;
+    epicsUInt8 u8 = 0xa5;
+    epicsFloat32 f32 = -1.25;
+    epicsFloat64 cvt = -1234;
+
+    testDiag("checkValues()");
+
+    dbScanLock((dbCommon*)target);
+    target->f64 = f64;
+    target->val = i32;
+    target->i16 = i16;
+    target->u8 = u8;
+    dbScanUnlock((dbCommon*)target);
+
+    checkGet("target.F64", DBR_DOUBLE, &f64, sizeof(f64));
+    checkGet("target.VAL", DBR_LONG, &i32, sizeof(i32));
+    checkGet("target.I16", DBR_SHORT, &i16, sizeof(i16));
+    checkGet("target.U8", DBR_UCHAR, &u8, sizeof(u8));
+    checkGet("target.F64", DBR_FLOAT, &f32, sizeof(f32));
+    checkGet("target.I16", DBR_DOUBLE, &cvt, sizeof(cvt));
+    checkGet("target.VAL", DBR_STRING, "-123456", 8);
+    checkGet("target.NAME", DBR_STRING, "target", 7);
+}
+
 MAIN(dbDbLinkTest)
 {
-    testPlan(18);
+    testPlan(42);
 
     testdbPrepare();
 
@@ -127,6 +180,7 @@ MAIN(dbDbLinkTest)
 
     checkTime();
     checkAlarm();
+    checkValues();
 
     testIocShutdownOk();
 
@@ -0,0 +1,114 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+ \*************************************************************************/
+
+#include <string.h>
+
+#include <envDefs.h>
+#include <epicsStdio.h>
+#include <errlog.h>
+#include <dbAccess.h>
+#include <dbStaticLib.h>
+#include <iocInit.h>
+#include <dbUnitTest.h>
+#include <testMain.h>
+
+#define NRECS 50
+
+static void testRecordOrder(void)
+{
+    DBENTRY entry;
+    long status;
+    int n = 0, inOrder = 1;
+
+    dbInitEntry(pdbbase, &entry);
+    status = dbFindRecordType(&entry, "x");
+    testOk1(status == 0);
+    for (status = dbFirstRecord(&entry); !status;
+         status = dbNextRecord(&entry)) {
+        char name[40];
+
+        if (dbIsAlias(&entry))
+            continue;
+        epicsSnprintf(name, sizeof(name), "q:rec%d", n);
+        if (strcmp(dbGetRecordName(&entry), name) != 0) {
+            testDiag("record %d is '%s'", n, dbGetRecordName(&entry));
+            inOrder = 0;
+        }
+        n++;
+    }
+    testOk(n == NRECS, "%d records loaded", n);
+    testOk(inOrder, "Records were created in the order requested");
+    dbFinishEntry(&entry);
+}
+
+void dbTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+MAIN(dbLoadQueueTest)
+{
+    int i;
+
+    testPlan(14);
+    testdbPrepare();
+
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    /* Run from O.<arch> or the directory containing it */
+    epicsEnvSet("EPICS_DB_INCLUDE_PATH", ".:..");
+    dbLoadRecordsParallel = 3;
+
+    testDiag("Queue %d requests", NRECS);
+    for (i = 0; i < NRECS; i++) {
+        char subs[40];
+
+        epicsSnprintf(subs, sizeof(subs), "P=q:,N=%d", i);
+        if (dbLoadRecords("dbLoadQueueTest.db", subs))
+            testAbort("dbLoadRecords(\"dbLoadQueueTest.db\", \"%s\") failed",
+                subs);
+    }
+
+    testDiag("A later definition of the same record is applied last");
+    testOk1(dbLoadRecords("dbLoadQueueTest.db", "P=q:,N=5,D=second,A=b") == 0);
+
+    eltc(0);
+    testOk(dbLoadRecords("noSuchFile.db", NULL) != 0,
+        "Missing file is reported immediately");
+    eltc(1);
+
+    testOk1(dbLoadRecordsWait() == 0);
+
+    testDiag("Errors found while parsing are reported by dbLoadRecordsWait()");
+    eltc(0);
+    testOk1(dbLoadRecords("dbLoadQueueTest.db", "P=q:,N=7") == 0);
+    testOk1(dbLoadRecordsWait() != 0);
+    eltc(1);
+
+    testDiag("iocInit fails if a queued request failed");
+    eltc(0);
+    testOk1(dbLoadRecords("dbLoadQueueTest.db", "P=q:,N=7") == 0);
+    testOk1(iocBuild() != 0);
+    eltc(1);
+    testRecordOrder();
+
+    testIocInitOk();
+
+    testdbGetFieldEqual("q:rec5.DESC", DBR_STRING, "second");
+    testdbGetFieldEqual("q:alias5b.DESC", DBR_STRING, "second");
+    testdbGetFieldEqual("q:rec6.DESC", DBR_STRING, "default");
+
+    eltc(0);
+    testOk(dbLoadRecords("dbLoadQueueTest.db", "P=q:,N=99") == -2,
+        "Not queued after iocInit");
+    eltc(1);
+
+    testIocShutdownOk();
+
+    testdbCleanup();
+    dbLoadRecordsParallel = 0;
+    epicsEnvUnset("EPICS_DB_INCLUDE_PATH");
+
+    return testDone();
+}
@@ -0,0 +1,116 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+ \*************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <envDefs.h>
+#include <dbAccess.h>
+#include <dbStaticLib.h>
+#include <dbLoadTemplate.h>
+#include <dbUnitTest.h>
+#include <testMain.h>
+
+#define TEMPLATE "dbLoadTemplateTest.template"
+#define INCLUDE "dbLoadTemplateTestInc.db"
+#define SUBSFILE "dbLoadTemplateTest.substitutions"
+
+void dbTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+static void writeFile(const char *name, const char *text)
+{
+    FILE *fp = fopen(name, "w");
+
+    if (!fp)
+        testAbort("Can't create %s", name);
+    fputs(text, fp);
+    fclose(fp);
+}
+
+static void testDesc(const char *record, const char *expect)
+{
+    DBENTRY entry;
+
+    dbInitEntry(pdbbase, &entry);
+    if (dbFindRecord(&entry, record)) {
+        testFail("%s not found", record);
+    }
+    else {
+        const char *desc = !dbFindField(&entry, "DESC") ?
+            dbGetString(&entry) : NULL;
+
+        testOk(desc && strcmp(desc, expect) == 0, "%s.DESC \"%s\" (%s)",
+            record, desc ? desc : "", expect);
+    }
+    dbFinishEntry(&entry);
+}
+
+static void testInfo(const char *record, const char *expect)
+{
+    DBENTRY entry;
+    const char *value;
+
+    dbInitEntry(pdbbase, &entry);
+    value = dbFindRecord(&entry, record) ? NULL : dbGetInfo(&entry, "raw");
+    testOk(value && strcmp(value, expect) == 0, "%s info \"%s\" (%s)",
+        record, value ? value : "", expect);
+    dbFinishEntry(&entry);
+}
+
+MAIN(dbLoadTemplateTest)
+{
+    testPlan(9);
+    testdbPrepare();
+
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+    epicsEnvSet("EPICS_DB_INCLUDE_PATH", ".");
+
+    writeFile(TEMPLATE,
+        "record(x, \"$(P)rec\") {\n"
+        "    field(DESC, \"$(D=default)\")\n"
+        "    info(raw, '$(P)\\\\$(D)')\n"
+        "}\n"
+        "include \"" INCLUDE "\"\n");
+    writeFile(INCLUDE,
+        "record(x, \"$(P)inc\") {\n"
+        "    field(DESC, \"$(P)$(D=)\")\n"
+        "}\n");
+    writeFile(SUBSFILE,
+        "file \"" TEMPLATE "\" {\n"
+        "    { P=\"a:\", D=one }\n"
+        "    { P=\"b:\" }\n"
+        "    { P=\"c:\", D=three }\n"
+        "}\n");
+
+    testDiag("Instances of one template");
+    testOk1(dbLoadTemplate(SUBSFILE, NULL) == 0);
+    testDesc("a:rec", "one");
+    testDesc("b:rec", "default");
+    testDesc("c:rec", "three");
+    testDesc("c:inc", "c:three");
+    testInfo("b:rec", "$(P)\\$(D)");
+
+    testDiag("Template changed between dbLoadTemplate calls");
+    writeFile(TEMPLATE,
+        "record(x, \"$(P)rec\") {\n"
+        "    field(DESC, \"changed $(D=default)\")\n"
+        "}\n");
+    writeFile(SUBSFILE,
+        "file \"" TEMPLATE "\" {\n"
+        "    { P=\"d:\", D=one }\n"
+        "}\n");
+    testOk1(dbLoadTemplate(SUBSFILE, NULL) == 0);
+    testDesc("d:rec", "changed one");
+    testDesc("a:rec", "one");
+
+    testdbCleanup();
+    remove(SUBSFILE);
+    remove(INCLUDE);
+    remove(TEMPLATE);
+
+    return testDone();
+}
@@ -114,6 +114,42 @@ void testSets(void) {
     testdbCleanup();
 }
 
+static void testLinkInit(void)
+{
+    dbCommon *precb, *precc;
+    testDiag("testing locks while links are resolved");
+
+    testdbPrepare();
+
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+    testdbReadDatabase("dbLockTest.db", NULL, NULL);
+
+    dbLockInitRecords(pdbbase);
+
+    precb = testdbRecordPtr("recb");
+    precc = testdbRecordPtr("recc");
+
+    /* every record can be locked before the lockSets are computed */
+    testOk1(precb->lset->plockSet!=NULL);
+    dbScanLock(precb);
+    dbScanUnlock(precb);
+
+    dbLockSetMerge(NULL, precb, precc);
+    compareSets(0, "recb", "recc");
+    dbScanLock(precc);
+    dbScanUnlock(precc);
+
+    dbLockComputeSets(pdbbase);
+    compareSets(1, "recb", "recc");
+    testOk1(precb->lset->plockSet->refcount==2);
+    compareSets(0, "reca", "recb");
+
+    dbLockCleanupRecords(pdbbase);
+
+    testdbCleanup();
+}
+
 static void testSingleLock(void)
 {
     dbCommon *prec;
@@ -417,11 +453,12 @@ static void testLinkNOP(void)
 MAIN(dbLockTest)
 {
 #ifdef LOCKSET_DEBUG
-    testPlan(100);
+    testPlan(105);
 #else
-    testPlan(88);
+    testPlan(93);
 #endif
     testSets();
+    testLinkInit();
     testSingleLock();
     testMultiLock();
     testLinkBreak();
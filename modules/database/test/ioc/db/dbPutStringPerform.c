@@ -0,0 +1,124 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+ \*************************************************************************/
+
+/* Measure the time taken to set fields while loading records */
+
+#include <stdio.h>
+
+#include <epicsStdio.h>
+#include <epicsTime.h>
+#include <dbAccess.h>
+#include <dbStaticLib.h>
+#include <dbUnitTest.h>
+#include <testMain.h>
+
+#define NRECS 100000
+#define DBFILE "dbPutStringPerform.db"
+
+void dbTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+static const struct {
+    const char *field;
+    const char *value;
+} fields[] = {
+    {"DESC", "Some description"},
+    {"SCAN", "1 second"},
+    {"DTYP", "Soft Channel"},
+    {"PINI", "YES"},
+    {"PHAS", "2"},
+    {"VAL", "42"},
+    {"I16", "-7"},
+    {"U32", "0x1000"},
+    {"F32", "2.5"},
+    {"F64", "3.14159"},
+    {"SFX", "After"},
+    {"LNK", "other:rec CP MS"},
+};
+#define NFIELDS (sizeof(fields) / sizeof(fields[0]))
+
+static double since(epicsUInt64 start)
+{
+    return (epicsMonotonicGet() - start) * 1e-9;
+}
+
+static void writeDb(int withFields)
+{
+    FILE *fp = fopen(DBFILE, "w");
+    unsigned i, j;
+
+    if (!fp)
+        testAbort("Can't create " DBFILE);
+    for (j = 0; j < NRECS; j++) {
+        fprintf(fp, "record(x, \"$(P)rec%u\") {\n", j);
+        for (i = 0; withFields && i < NFIELDS; i++)
+            fprintf(fp, "    field(%s, \"%s\")\n", fields[i].field,
+                fields[i].value);
+        fprintf(fp, "}\n");
+    }
+    fclose(fp);
+}
+
+static double loadDb(int withFields)
+{
+    epicsUInt64 start;
+    double elapsed;
+
+    writeDb(withFields);
+    testdbPrepare();
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    start = epicsMonotonicGet();
+    if (dbLoadRecords(DBFILE, "P=perf:"))
+        testAbort("Can't load " DBFILE);
+    elapsed = since(start);
+
+    testdbCleanup();
+    remove(DBFILE);
+    return elapsed;
+}
+
+MAIN(dbPutStringPerform)
+{
+    DBENTRY entry;
+    epicsUInt64 start;
+    double elapsed, empty;
+    unsigned i, j;
+
+    testPlan(0);
+
+    testdbPrepare();
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    dbInitEntry(pdbbase, &entry);
+    if (dbFindRecordType(&entry, "x") || dbCreateRecord(&entry, "perf"))
+        testAbort("Can't create record");
+
+    for (i = 0; i < NFIELDS; i++) {
+        start = epicsMonotonicGet();
+        for (j = 0; j < NRECS; j++)
+            dbFindField(&entry, fields[i].field);
+        elapsed = since(start);
+        start = epicsMonotonicGet();
+        for (j = 0; j < NRECS; j++)
+            dbPutString(&entry, fields[i].value);
+        testDiag("%-5s find %4.0f ns, put %4.0f ns \"%s\"", fields[i].field,
+            elapsed * 1e9 / NRECS, since(start) * 1e9 / NRECS,
+            fields[i].value);
+    }
+    dbFinishEntry(&entry);
+    testdbCleanup();
+
+    empty = loadDb(0);
+    testDiag("Load %d records without fields: %.3f sec", NRECS, empty);
+    elapsed = loadDb(1);
+    testDiag("Load %d records with %u fields:  %.3f sec, %.0f ns per field",
+        NRECS, (unsigned) NFIELDS, elapsed,
+        (elapsed - empty) * 1e9 / NRECS / NFIELDS);
+
+    return testDone();
+}
@@ -0,0 +1,133 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+ \*************************************************************************/
+
+/* Measure insert and lookup times of the process variable directory */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <epicsEvent.h>
+#include <epicsStdio.h>
+#include <epicsUnitTest.h>
+#include <epicsThread.h>
+#include <epicsTime.h>
+#include <dbBase.h>
+#include <dbStaticLib.h>
+#include <dbStaticPvt.h>
+#include <testMain.h>
+
+#define NNAMES 1000000
+#define NTHREADS 4
+
+static dbRecordNode *nodes;
+static DBBASE *pdbbase;
+
+typedef struct {
+    epicsEventId done;
+    int offset;
+    int found;
+} lookupArgs;
+
+static int lookupAll(int offset, int step)
+{
+    int i, found = 0;
+
+    for (i = offset; i < NNAMES; i += step) {
+        const char *name = nodes[i].recordname;
+
+        if (dbPvdFind(pdbbase, name, strlen(name)))
+            found++;
+    }
+    return found;
+}
+
+static void lookupThread(void *arg)
+{
+    lookupArgs *pargs = arg;
+
+    pargs->found = lookupAll(pargs->offset, NTHREADS);
+    epicsEventMustTrigger(pargs->done);
+}
+
+static double since(epicsUInt64 start)
+{
+    return (epicsMonotonicGet() - start) * 1e-9;
+}
+
+MAIN(dbPvdPerform)
+{
+    lookupArgs args[NTHREADS];
+    epicsUInt64 start;
+    double elapsed;
+    int i, found = 0;
+
+    testPlan(0);
+
+    nodes = calloc(NNAMES, sizeof(*nodes));
+    if (!nodes)
+        testAbort("Out of memory");
+    for (i = 0; i < NNAMES; i++) {
+        char name[60];
+
+        epicsSnprintf(name, sizeof(name), "IOC%02d:SUB%03d:DEV%04d:SIG",
+            i % 37, (i / 37) % 251, i / (37 * 251));
+        nodes[i].recordname = strdup(name);
+    }
+
+    pdbbase = dbAllocBase();
+
+    start = epicsMonotonicGet();
+    for (i = 0; i < NNAMES; i++)
+        dbPvdAdd(pdbbase, NULL, &nodes[i]);
+    elapsed = since(start);
+    testDiag("Insert %d names: %.3f sec, %.0f ns each", NNAMES, elapsed,
+        elapsed * 1e9 / NNAMES);
+
+    start = epicsMonotonicGet();
+    found = lookupAll(0, 1);
+    elapsed = since(start);
+    testDiag("Look up %d names: %.3f sec, %.0f ns each", found, elapsed,
+        elapsed * 1e9 / NNAMES);
+
+    start = epicsMonotonicGet();
+    for (i = 0; i < NNAMES; i++) {
+        char name[60];
+
+        epicsSnprintf(name, sizeof(name), "MISSING:%d", i);
+        if (dbPvdFind(pdbbase, name, strlen(name)))
+            found++;
+    }
+    elapsed = since(start);
+    testDiag("Look up %d missing names: %.3f sec, %.0f ns each", NNAMES,
+        elapsed, elapsed * 1e9 / NNAMES);
+
+    start = epicsMonotonicGet();
+    for (i = 0; i < NTHREADS; i++) {
+        args[i].done = epicsEventMustCreate(epicsEventEmpty);
+        args[i].offset = i;
+        epicsThreadMustCreate("dbPvdPerform", epicsThreadPriorityMedium,
+            epicsThreadGetStackSize(epicsThreadStackSmall),
+            lookupThread, &args[i]);
+    }
+    found = 0;
+    for (i = 0; i < NTHREADS; i++) {
+        epicsEventMustWait(args[i].done);
+        epicsEventDestroy(args[i].done);
+        found += args[i].found;
+    }
+    elapsed = since(start);
+    testDiag("Look up %d names from %d threads: %.3f sec", found, NTHREADS,
+        elapsed);
+
+    dbPvdDump(pdbbase, 0);
+
+    dbFreeBase(pdbbase);
+    for (i = 0; i < NNAMES; i++)
+        free(nodes[i].recordname);
+    free(nodes);
+
+    return testDone();
+}
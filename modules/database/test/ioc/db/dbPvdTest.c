@@ -0,0 +1,118 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+ \*************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <epicsStdio.h>
+#include <epicsUnitTest.h>
+#include <dbBase.h>
+#include <dbStaticLib.h>
+#include <dbStaticPvt.h>
+#include <testMain.h>
+
+#define NNAMES 10000
+
+static dbRecordNode nodes[NNAMES];
+
+typedef struct {
+    int count;
+    int inOrder;
+    const char *last;
+} prefixResult;
+
+static void countPrefix(PVDENTRY *ppvd, void *arg)
+{
+    prefixResult *presult = arg;
+    const char *name = ppvd->precnode->recordname;
+
+    if (presult->last && strcmp(presult->last, name) >= 0)
+        presult->inOrder = 0;
+    presult->last = name;
+    presult->count++;
+}
+
+static int findAll(DBBASE *pdbbase, int step, int offset)
+{
+    int i, found = 0;
+
+    for (i = offset; i < NNAMES; i += step) {
+        const char *name = nodes[i].recordname;
+        PVDENTRY *ppvd = dbPvdFind(pdbbase, name, strlen(name));
+
+        if (ppvd && ppvd->precnode == &nodes[i])
+            found++;
+    }
+    return found;
+}
+
+static void testPrefix(DBBASE *pdbbase, const char *prefix, int expect)
+{
+    prefixResult result = {0, 1, NULL};
+
+    dbPvdForEachPrefix(pdbbase, prefix, countPrefix, &result);
+    testOk(result.count == expect && result.inOrder,
+        "prefix \"%s\" found %d names (expected %d) in%s order",
+        prefix, result.count, expect, result.inOrder ? "" : " the wrong");
+}
+
+MAIN(dbPvdTest)
+{
+    DBBASE *pdbbase;
+    PVDENTRY *ppvd;
+    int i, added = 0;
+
+    testPlan(14);
+
+    /* Start small so the directory has to grow */
+    dbPvdTableSize(256);
+    pdbbase = dbAllocBase();
+
+    for (i = 0; i < NNAMES; i++) {
+        char name[40];
+
+        epicsSnprintf(name, sizeof(name), "pvd:%c:%d", 'a' + i % 4, i);
+        nodes[i].recordname = strdup(name);
+        if (dbPvdAdd(pdbbase, NULL, &nodes[i]))
+            added++;
+    }
+    testOk(added == NNAMES, "Added %d names", added);
+    testOk1(findAll(pdbbase, 1, 0) == NNAMES);
+
+    testOk(!dbPvdAdd(pdbbase, NULL, &nodes[5]), "Duplicate name rejected");
+    testOk1(!dbPvdFind(pdbbase, "pvd:a:", 6));
+    testOk(dbPvdFind(pdbbase, "pvd:b:1xyz", 7) != NULL,
+        "Lookup uses only the given length of the name");
+
+    testPrefix(pdbbase, "pvd:", NNAMES);
+    testPrefix(pdbbase, "pvd:c:", NNAMES / 4);
+    testPrefix(pdbbase, "pvd:d:99", 29);
+    testPrefix(pdbbase, "zzz", 0);
+
+    testDiag("Delete every other name");
+    ppvd = dbPvdFind(pdbbase, nodes[0].recordname,
+        strlen(nodes[0].recordname));
+    for (i = 0; i < NNAMES; i += 2)
+        dbPvdDelete(pdbbase, &nodes[i]);
+    testOk(ppvd && ppvd->precnode == &nodes[0],
+        "Deleted entry still readable by a lookup that found it");
+    testOk1(findAll(pdbbase, 2, 1) == NNAMES / 2);
+    testOk1(findAll(pdbbase, 2, 0) == 0);
+    testPrefix(pdbbase, "pvd:b:", NNAMES / 4);
+
+    testDiag("Add them back");
+    for (i = 0; i < NNAMES; i += 2)
+        dbPvdAdd(pdbbase, NULL, &nodes[i]);
+    ppvd = dbPvdFind(pdbbase, nodes[0].recordname,
+        strlen(nodes[0].recordname));
+    testOk1(ppvd && ppvd->precnode == &nodes[0]);
+
+    dbFreeBase(pdbbase);
+    for (i = 0; i < NNAMES; i++)
+        free(nodes[i].recordname);
+
+    return testDone();
+}
@@ -0,0 +1,95 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+ \*************************************************************************/
+
+/* Compare the time taken to load a large database by parsing it with
+ * the time taken to load the same records from a snapshot.
+ */
+
+#include <stdio.h>
+
+#include <epicsStdio.h>
+#include <epicsTime.h>
+#include <dbAccess.h>
+#include <dbUnitTest.h>
+#include <testMain.h>
+
+#define NFILES 500
+#define RECS_PER_FILE 1000
+#define SNAPFILE "dbSnapshotPerform.dbsnap"
+#define DBFILE "dbSnapshotPerform.db"
+
+void dbTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+static void writeDb(void)
+{
+    FILE *fp = fopen(DBFILE, "w");
+    int i;
+
+    if (!fp)
+        testAbort("Can't create " DBFILE);
+    for (i = 0; i < RECS_PER_FILE; i++) {
+        fprintf(fp, "record(x, \"$(P)rec%d\") {\n"
+            "    field(DESC, \"Record %d of $(P)\")\n"
+            "    field(VAL, \"%d\")\n"
+            "    field(F64, \"$(SCALE=1.0)\")\n"
+            "    field(LNK, \"$(P)rec%d NPP\")\n"
+            "    info(autosaveFields, \"VAL\")\n"
+            "}\n", i, i, i, (i + 1) % RECS_PER_FILE);
+    }
+    fclose(fp);
+}
+
+static double loadAll(int useSnapshot)
+{
+    epicsUInt64 start;
+    double elapsed;
+    int i;
+
+    testdbPrepare();
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    start = epicsMonotonicGet();
+    if (useSnapshot)
+        dbLoadSnapshot(SNAPFILE);
+    for (i = 0; i < NFILES; i++) {
+        char subs[40];
+
+        epicsSnprintf(subs, sizeof(subs), "P=f%d:", i);
+        dbLoadRecords(DBFILE, subs);
+    }
+    if (dbLoadRecordsWait())
+        testAbort("Loading failed");
+    elapsed = (epicsMonotonicGet() - start) * 1e-9;
+
+    testdbCleanup();
+    return elapsed;
+}
+
+MAIN(dbSnapshotPerform)
+{
+    double parse, write, read;
+
+    testPlan(0);
+    writeDb();
+    remove(SNAPFILE);
+
+    testDiag("Loading %d records from %d files", NFILES * RECS_PER_FILE,
+        NFILES);
+    parse = loadAll(0);
+    testDiag("Parse database files:                 %8.3f sec", parse);
+    write = loadAll(1);
+    testDiag("Parse and write snapshot:             %8.3f sec", write);
+    read = loadAll(1);
+    testDiag("Load from snapshot:                   %8.3f sec", read);
+    if (read > 0)
+        testDiag("Snapshot speed-up:                    %8.1f times",
+            parse / read);
+
+    remove(SNAPFILE);
+    remove(DBFILE);
+    return testDone();
+}
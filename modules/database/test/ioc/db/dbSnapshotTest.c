@@ -0,0 +1,203 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+ \*************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <epicsStdio.h>
+#include <envDefs.h>
+#include <errlog.h>
+#include <osiFileName.h>
+#include <dbAccess.h>
+#include <dbStaticLib.h>
+#include <dbUnitTest.h>
+#include <testMain.h>
+
+#define NRECS 20
+#define SNAPFILE "dbSnapshotTest.dbsnap"
+#define DBFILE "dbSnapshotTest.db"
+#define MAINFILE "dbSnapshotMain.db"
+#define INCFILE "dbSnapshotInc.db"
+
+void dbTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+static void writeDb(const char *desc)
+{
+    FILE *fp = fopen(DBFILE, "w");
+
+    if (!fp)
+        testAbort("Can't create " DBFILE);
+    fprintf(fp, "record(x, \"$(P)rec$(N)\") {\n"
+        "    field(DESC, \"%s\")\n"
+        "    field(VAL, \"$(N)\")\n"
+        "    field(F64, \"1.5\")\n"
+        "    field(SFX, \"After\")\n"
+        "    field(LNK, \"$(P)rec0 NPP NMS\")\n"
+        "    info(snapTest, \"$(N)\")\n"
+        "    alias(\"$(P)alias$(N)\")\n"
+        "}\n", desc);
+    fclose(fp);
+}
+
+static void writeInc(const char *dir, const char *desc)
+{
+    char name[100];
+    FILE *fp;
+
+    epicsSnprintf(name, sizeof(name), "%s/" INCFILE, dir);
+    fp = fopen(name, "w");
+    if (!fp)
+        testAbort("Can't create %s", name);
+    fprintf(fp, "record(x, \"s:inc\") {\n"
+        "    field(DESC, \"%s\")\n"
+        "}\n", desc);
+    fclose(fp);
+}
+
+/* Replace a string in the snapshot, to show that it was used */
+static int patchSnapshot(const char *from, const char *to)
+{
+    size_t len = strlen(from);
+    long size, i;
+    int count = 0;
+    char *buf;
+    FILE *fp = fopen(SNAPFILE, "r+b");
+
+    if (!fp)
+        return 0;
+    fseek(fp, 0, SEEK_END);
+    size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    buf = malloc(size);
+    if (!buf || fread(buf, 1, size, fp) != (size_t) size) {
+        free(buf);
+        fclose(fp);
+        return 0;
+    }
+    for (i = 0; i + len <= (size_t) size; i++) {
+        if (memcmp(buf + i, from, len) == 0) {
+            memcpy(buf + i, to, len);
+            count++;
+        }
+    }
+    fseek(fp, 0, SEEK_SET);
+    fwrite(buf, 1, size, fp);
+    fclose(fp);
+    free(buf);
+    return count;
+}
+
+static void loadAndCheck(const char *desc)
+{
+    DBENTRY entry;
+    int i;
+
+    testdbPrepare();
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    testOk1(dbLoadSnapshot(SNAPFILE) == 0);
+    for (i = 0; i < NRECS; i++) {
+        char subs[40];
+
+        epicsSnprintf(subs, sizeof(subs), "P=s:,N=%d", i);
+        dbLoadRecords(DBFILE, subs);
+    }
+    testOk1(dbLoadRecordsWait() == 0);
+
+    testIocInitOk();
+
+    testdbGetFieldEqual("s:rec7.DESC", DBR_STRING, desc);
+    testdbGetFieldEqual("s:alias7.VAL", DBR_LONG, 7);
+    testdbGetFieldEqual("s:rec7.F64", DBR_DOUBLE, 1.5);
+    testdbGetFieldEqual("s:rec7.SFX", DBR_STRING, "After");
+    testdbGetFieldEqual("s:rec7.LNK", DBR_STRING, "s:rec0 NPP NMS");
+
+    dbInitEntry(pdbbase, &entry);
+    testOk(!dbFindRecord(&entry, "s:rec7") &&
+        !strcmp(dbGetInfo(&entry, "snapTest"), "7"), "Info item restored");
+    dbFinishEntry(&entry);
+
+    testIocShutdownOk();
+    testdbCleanup();
+}
+
+/* MAINFILE includes INCFILE, both found through the include path */
+static void loadIncluded(const char *desc)
+{
+    testdbPrepare();
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    testOk1(dbLoadSnapshot(SNAPFILE) == 0);
+    dbLoadRecords(MAINFILE, NULL);
+    testOk1(dbLoadRecordsWait() == 0);
+
+    testIocInitOk();
+    testdbGetFieldEqual("s:inc.DESC", DBR_STRING, desc);
+    testIocShutdownOk();
+    testdbCleanup();
+}
+
+MAIN(dbSnapshotTest)
+{
+    FILE *fp;
+
+    testPlan(37);
+
+    remove(SNAPFILE);
+    writeDb("first");
+
+    testDiag("No snapshot, the database file is parsed");
+    loadAndCheck("first");
+    fp = fopen(SNAPFILE, "rb");
+    testOk(fp != NULL, "Snapshot written");
+    if (fp)
+        fclose(fp);
+
+    testDiag("Snapshot is up to date");
+    testOk1(patchSnapshot("first", "patch") == NRECS);
+    loadAndCheck("patch");
+
+    testDiag("Database file changed");
+    writeDb("third");
+    loadAndCheck("third");
+
+    testDiag("Too late once records are loaded");
+    testdbPrepare();
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+    testdbReadDatabase(DBFILE, NULL, "P=t:,N=0");
+    eltc(0);
+    testOk1(dbLoadSnapshot(SNAPFILE) != 0);
+    eltc(1);
+    testdbCleanup();
+
+    testDiag("Included file shadowed by one earlier in the include path");
+    remove(SNAPFILE);
+    fp = fopen(MAINFILE, "w");
+    if (!fp)
+        testAbort("Can't create " MAINFILE);
+    fprintf(fp, "include \"" INCFILE "\"\n");
+    fclose(fp);
+    writeInc(".", "incA");
+    epicsEnvSet("EPICS_DB_INCLUDE_PATH", ".." OSI_PATH_LIST_SEPARATOR ".");
+    loadIncluded("incA");
+    testOk1(patchSnapshot("incA", "incP") == 1);
+    loadIncluded("incP");
+    writeInc("..", "incB");
+    loadIncluded("incB");
+    epicsEnvUnset("EPICS_DB_INCLUDE_PATH");
+
+    remove(SNAPFILE);
+    remove(DBFILE);
+    remove(MAINFILE);
+    remove(INCFILE);
+    remove("../" INCFILE);
+
+    return testDone();
+}
@@ -4,6 +4,7 @@
 * in file LICENSE that is included with this distribution.
  \*************************************************************************/
 
+#include <stdio.h>
 #include <string.h>
 
 #include <errlog.h>
@@ -293,12 +294,110 @@ static void testDbVerify(const char *record)
 
 void dbTestIoc_registerRecordDeviceDriver(struct dbBase *);
 
+static void testFieldString(const char *pv, const char *expect)
+{
+    DBENTRY entry;
+    const char *value = NULL;
+
+    dbInitEntry(pdbbase, &entry);
+    if (!dbFindRecord(&entry, pv))
+        value = dbGetString(&entry);
+    testOk(value && strcmp(value, expect) == 0,
+        "%s = \"%s\" (expected \"%s\")", pv, value ? value : "",
+        expect);
+    dbFinishEntry(&entry);
+}
+
+/* Loading the same values into the same fields again must give the same
+ * result, and a record type's initial values must not pick up the values
+ * loaded into its first record.
+ */
+static void testLoadRepeated(void)
+{
+    testDiag("Load the same fields repeatedly");
+    testdbPrepare();
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    testdbReadDatabase("dbStaticTestMemo.db", "." OSI_PATH_LIST_SEPARATOR "..",
+        "P=m1:,C8=300");
+    testdbReadDatabase("dbStaticTestMemo.db", "." OSI_PATH_LIST_SEPARATOR "..",
+        "P=m2:,C8=300");
+    testdbReadDatabase("dbStaticTestMemo.db", "." OSI_PATH_LIST_SEPARATOR "..",
+        "P=m3:");
+
+    testFieldString("m1:memo.C8", "44");
+    testFieldString("m2:memo.C8", "44");
+    testFieldString("m3:memo.C8", "12");
+    testFieldString("m2:memo.F64", "2.5");
+    testFieldString("m2:memo.SFX", "After");
+    testFieldString("m3:memo.DISV", "3");
+    testFieldString("m1:plain.DISV", "1");
+    testFieldString("m3:plain.DISV", "1");
+    testFieldString("m3:plain.SFX", "None");
+
+    testdbCleanup();
+}
+
+static void writeFile(const char *name, const char *text)
+{
+    FILE *fp = fopen(name, "w");
+
+    if (!fp)
+        testAbort("Can't create %s", name);
+    fputs(text, fp);
+    fclose(fp);
+}
+
+/* Files are read whole and split into lines as fgets() would have, and
+ * only lines with a '$' in them are macro expanded.
+ */
+static void testLoadLines(void)
+{
+    char comment[1500];
+
+    testDiag("Load lines from a file read into memory");
+    testdbPrepare();
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    memset(comment, 'x', sizeof(comment) - 1);
+    comment[0] = '#';
+    comment[sizeof(comment) - 1] = '\0';
+    writeFile("dbStaticTestLines.db", comment);
+    writeFile("dbStaticTestLinesInc.db",
+        "record(x, \"$(P)inc\") { field(DESC, \"in $(P)\") }\n");
+
+    {
+        FILE *fp = fopen("dbStaticTestLines.db", "a");
+
+        if (!fp)
+            testAbort("Can't append to dbStaticTestLines.db");
+        fputs(" $(P) $(D)\n"
+            "record(x, \"$(P)one\") {\n"
+            "    field(DESC, \"no macros here\")\n"
+            "}\n"
+            "include \"dbStaticTestLinesInc.db\"\n"
+            "record(x, \"$(P)two\") { field(DESC, \"$(D)\") }", fp);
+        fclose(fp);
+    }
+
+    testdbReadDatabase("dbStaticTestLines.db", ".", "P=r:,D=last");
+    testFieldString("r:one.DESC", "no macros here");
+    testFieldString("r:inc.DESC", "in r:");
+    testFieldString("r:two.DESC", "last");
+
+    testdbCleanup();
+    remove("dbStaticTestLines.db");
+    remove("dbStaticTestLinesInc.db");
+}
+
 MAIN(dbStaticTest)
 {
     const char *ldir;
     FILE *fp = NULL;
 
-    testPlan(310);
+    testPlan(322);
     testdbPrepare();
 
     testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
@@ -348,6 +447,9 @@ MAIN(dbStaticTest)
 
     testdbCleanup();
 
+    testLoadRepeated();
+    testLoadLines();
+
     return testDone();
 }
 
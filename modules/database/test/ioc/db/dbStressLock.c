@@ -15,9 +15,13 @@
  * 2) Lock several records.
  * 3) Retarget the TSEL link of a record
  *
+ * A second part times splitting and merging a single large lockset,
+ * a long chain of records, by breaking and restoring links in it.
+ *
  *  Author: Michael Davidsaver <mdavidsaver@bnl.gov>
  */
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
@@ -198,6 +202,125 @@ void worker(void *raw)
     epicsEventMustTrigger(priv->donevent);
 }
 
+/* number of records in the chain, and of breaks made in it */
+#define NCHAIN 20000
+#define NBREAK 200
+
+static
+void putLink(dbCommon *prec, const char *target)
+{
+    char name[60];
+    DBADDR dbaddr;
+
+    strcpy(name, prec->name);
+    strcat(name, ".TSEL");
+    if(dbNameToAddr(name, &dbaddr))
+        testAbort("bad record name %s", name);
+    if(dbPutField(&dbaddr, DBR_STRING, target, 1))
+        testAbort("put to %s fails", name);
+}
+
+static
+void testChain(void)
+{
+    DBENTRY ent;
+    dbCommon **pchain, *pleaf;
+    epicsUInt64 start;
+    double split = 0, merge = 0, splitmax = 0, mergemax = 0;
+    double detach = 0, attach = 0;
+    unsigned long nsets;
+    int i, nsplit = 0, nmerge = 0, ndetach = 0, nattach = 0;
+
+    testDiag("Break and restore links in a chain of %d records", NCHAIN);
+
+    pchain = callocMustSucceed(NCHAIN, sizeof(*pchain), "no mem");
+
+    testdbPrepare();
+
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    dbInitEntry(pdbbase, &ent);
+    for(i=0; i<NCHAIN; i++) {
+        char name[20], target[20];
+
+        sprintf(name, "chain%d", i);
+        sprintf(target, "chain%d", i-1);
+        if(dbFindRecordType(&ent, "x") || dbCreateRecord(&ent, name) ||
+           (i>0 && (dbFindField(&ent, "TSEL") || dbPutString(&ent, target))))
+            testAbort("Can't create %s", name);
+        pchain[i] = ent.precnode->precord;
+    }
+    /* a single record linked to one in the chain */
+    if(dbFindRecordType(&ent, "x") || dbCreateRecord(&ent, "chainleaf") ||
+       dbFindField(&ent, "TSEL") || dbPutString(&ent, "chain0"))
+        testAbort("Can't create chainleaf");
+    pleaf = ent.precnode->precord;
+    dbFinishEntry(&ent);
+
+    start = epicsMonotonicGet();
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+    testDiag("iocInit took %.3f sec", (epicsMonotonicGet()-start)*1e-9);
+
+    nsets = dbLockCountSets();
+
+    for(i=0; i<NBREAK; i++) {
+        size_t n = 1 + (size_t)(getRand()*(NCHAIN-2));
+        double duration;
+
+        start = epicsMonotonicGet();
+        putLink(pchain[n], "");
+        duration = (epicsMonotonicGet()-start)*1e-9;
+        split += duration;
+        if(duration>splitmax)
+            splitmax = duration;
+        if(pchain[n]->lset->plockSet!=pchain[n-1]->lset->plockSet)
+            nsplit++;
+
+        start = epicsMonotonicGet();
+        putLink(pchain[n], pchain[n-1]->name);
+        duration = (epicsMonotonicGet()-start)*1e-9;
+        merge += duration;
+        if(duration>mergemax)
+            mergemax = duration;
+        if(pchain[n]->lset->plockSet==pchain[n-1]->lset->plockSet)
+            nmerge++;
+
+        /* move the single record to another place in the chain */
+        start = epicsMonotonicGet();
+        putLink(pleaf, "");
+        detach += (epicsMonotonicGet()-start)*1e-9;
+        if(pleaf->lset->plockSet!=pchain[0]->lset->plockSet)
+            ndetach++;
+
+        start = epicsMonotonicGet();
+        putLink(pleaf, pchain[n]->name);
+        attach += (epicsMonotonicGet()-start)*1e-9;
+        if(pleaf->lset->plockSet==pchain[0]->lset->plockSet)
+            nattach++;
+    }
+
+    testOk(nsplit==NBREAK, "%d of %d breaks split the lockset", nsplit, NBREAK);
+    testOk(nmerge==NBREAK, "%d of %d restores merged the locksets", nmerge, NBREAK);
+    testOk(ndetach==NBREAK, "%d of %d detached records split off", ndetach, NBREAK);
+    testOk(nattach==NBREAK, "%d of %d attached records merged", nattach, NBREAK);
+    testOk(dbLockCountSets()==nsets, "%lu locksets at the end",
+           dbLockCountSets());
+
+    testDiag("split AVG = %g us\tMAX = %g us", split/NBREAK*1e6, splitmax*1e6);
+    testDiag("merge AVG = %g us\tMAX = %g us", merge/NBREAK*1e6, mergemax*1e6);
+    testDiag("detach one record AVG = %g us", detach/NBREAK*1e6);
+    testDiag("attach one record AVG = %g us", attach/NBREAK*1e6);
+
+    testIocShutdownOk();
+
+    testdbCleanup();
+
+    free(pchain);
+}
+
 MAIN(dbStressTest)
 {
     DBENTRY ent;
@@ -218,10 +341,10 @@ MAIN(dbStressTest)
             nworkers = val;
     }
 
-    testPlan(80+nworkers*3);
+    testPlan(85+nworkers*3);
 
 #if defined(__rtems__)
-    testSkip(80+nworkers*3, "Test assumes time sliced preempting scheduling");
+    testSkip(85+nworkers*3, "Test assumes time sliced preempting scheduling");
     return testDone();
 #endif
 
@@ -355,5 +478,7 @@ MAIN(dbStressTest)
     free(priv);
     free(precords);
 
+    testChain();
+
     return testDone();
 }
@@ -0,0 +1,109 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+ \*************************************************************************/
+
+/* Compare the time taken by dbLoadTemplate to load a substitution file
+ * with many instances of one template with the time taken to load the
+ * same instances with one dbLoadRecords call each.
+ */
+
+#include <stdio.h>
+
+#include <epicsStdio.h>
+#include <epicsTime.h>
+#include <dbAccess.h>
+#include <dbLoadTemplate.h>
+#include <dbUnitTest.h>
+#include <testMain.h>
+
+#define NINSTANCES 10000
+#define TEMPLATE "dbTemplatePerform.template"
+#define SUBSFILE "dbTemplatePerform.substitutions"
+
+void dbTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+static void writeFiles(void)
+{
+    FILE *fp = fopen(TEMPLATE, "w");
+    int i;
+
+    if (!fp)
+        testAbort("Can't create " TEMPLATE);
+    fprintf(fp, "# Device $(P)$(R) on channel $(CH)\n");
+    for (i = 0; i < 4; i++) {
+        fprintf(fp, "record(x, \"$(P)$(R)sig%d\") {\n"
+            "    field(DESC, \"Signal %d of $(P)$(R)\")\n"
+            "    field(VAL, \"$(CH)\")\n"
+            "    field(F64, \"$(SCALE=1.0)\")\n"
+            "    field(LNK, \"$(P)$(R)sig%d NPP\")\n"
+            "    info(autosaveFields, \"VAL\")\n"
+            "}\n", i, i, (i + 1) % 4);
+    }
+    fclose(fp);
+
+    fp = fopen(SUBSFILE, "w");
+    if (!fp)
+        testAbort("Can't create " SUBSFILE);
+    fprintf(fp, "file \"" TEMPLATE "\" {\n"
+        "pattern { P, R, CH }\n");
+    for (i = 0; i < NINSTANCES; i++)
+        fprintf(fp, "    { \"crate%d:\", \"dev%d:\", %d }\n",
+            i / 100, i % 100, i);
+    fprintf(fp, "}\n");
+    fclose(fp);
+}
+
+static double loadAll(int useTemplate)
+{
+    epicsUInt64 start;
+    double elapsed;
+    int i;
+
+    testdbPrepare();
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    start = epicsMonotonicGet();
+    if (useTemplate) {
+        if (dbLoadTemplate(SUBSFILE, NULL))
+            testAbort("Loading failed");
+    }
+    else {
+        for (i = 0; i < NINSTANCES; i++) {
+            char subs[60];
+
+            epicsSnprintf(subs, sizeof(subs), "P=crate%d:,R=dev%d:,CH=%d",
+                i / 100, i % 100, i);
+            if (dbLoadRecords(TEMPLATE, subs))
+                testAbort("Loading failed");
+        }
+    }
+    elapsed = (epicsMonotonicGet() - start) * 1e-9;
+
+    testdbCleanup();
+    return elapsed;
+}
+
+MAIN(dbTemplatePerform)
+{
+    double records, templ;
+
+    testPlan(0);
+    writeFiles();
+
+    testDiag("Loading %d instances of a %d record template",
+        NINSTANCES, 4);
+    records = loadAll(0);
+    testDiag("dbLoadRecords per instance:           %8.3f sec", records);
+    templ = loadAll(1);
+    testDiag("dbLoadTemplate:                       %8.3f sec", templ);
+    if (templ > 0)
+        testDiag("Speed-up:                             %8.2f times",
+            records / templ);
+
+    remove(SUBSFILE);
+    remove(TEMPLATE);
+    return testDone();
+}
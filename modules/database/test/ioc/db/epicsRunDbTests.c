@@ -29,6 +29,12 @@ int scanIoTest(void);
 int dbLockTest(void);
 int dbPutLinkTest(void);
 int dbStaticTest(void);
+int dbPvdTest(void);
+int dbArenaTest(void);
+int dbLoadQueueTest(void);
+int dbSnapshotTest(void);
+int iocInitParallelTest(void);
+int dbLoadTemplateTest(void);
 int dbCaLinkTest(void);
 int dbDbLinkTest(void);
 int testDbChannel(void);
@@ -52,6 +58,12 @@ void epicsRunDbTests(void)
     runTest(dbLockTest);
     runTest(dbPutLinkTest);
     runTest(dbStaticTest);
+    runTest(dbPvdTest);
+    runTest(dbArenaTest);
+    runTest(dbLoadQueueTest);
+    runTest(dbSnapshotTest);
+    runTest(iocInitParallelTest);
+    runTest(dbLoadTemplateTest);
     runTest(dbCaLinkTest);
     runTest(dbDbLinkTest);
     runTest(testDbChannel);
@@ -0,0 +1,77 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+ \*************************************************************************/
+
+#include <epicsStdio.h>
+#include <dbAccess.h>
+#include <dbStaticLib.h>
+#include <dbUnitTest.h>
+#include <initHooks.h>
+#include <iocInit.h>
+#include <testMain.h>
+
+#include "xRecord.h"
+
+#define NRECS 1000
+
+void dbTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+static xRecord *precords[NRECS];
+
+static void testInit(int threads)
+{
+    DBENTRY entry;
+    int i, good = 0;
+
+    testDiag("iocInitThreads = %d", threads);
+    iocInitThreads = threads;
+
+    testdbPrepare();
+    testdbReadDatabase("dbTestIoc.dbd", NULL, NULL);
+    dbTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    dbInitEntry(pdbbase, &entry);
+    for (i = 0; i < NRECS; i++) {
+        char name[20], value[20];
+
+        epicsSnprintf(name, sizeof(name), "par%d", i);
+        epicsSnprintf(value, sizeof(value), "%d", i);
+        if (dbFindRecordType(&entry, "x") || dbCreateRecord(&entry, name) ||
+            dbFindField(&entry, "DTYP") ||
+            dbPutString(&entry, "Soft Channel") ||
+            dbFindField(&entry, "INP") || dbPutString(&entry, value))
+            testAbort("Can't create %s", name);
+        precords[i] = entry.precnode->precord;
+    }
+    dbFinishEntry(&entry);
+
+    testIocInitOk();
+
+    for (i = 0; i < NRECS; i++) {
+        if (precords[i]->val == i && precords[i]->dset && precords[i]->mlok)
+            good++;
+    }
+    testOk(good == NRECS, "%d of %d records initialized", good, NRECS);
+    testOk(initHookTime(initHookAfterInitDatabase) > 0,
+        "Database initialized after %.3f sec",
+        initHookTime(initHookAfterInitDatabase));
+
+    testIocShutdownOk();
+    testdbCleanup();
+    iocInitThreads = 0;
+}
+
+MAIN(iocInitParallelTest)
+{
+    testPlan(6);
+
+    testOk1(iocInitParallel("x") == 0);
+    testOk1(iocInitParallel("x") == 0);
+
+    testInit(0);
+    testInit(4);
+
+    return testDone();
+}
@@ -6,11 +6,13 @@
 * in file LICENSE that is included with this distribution.
 \*************************************************************************/
 #include "string.h"
+#include "float.h"
 
 #include "cantProceed.h"
 #include "dbConvert.h"
 #include "dbDefs.h"
 #include "epicsAssert.h"
+#include "epicsMath.h"
 
 #include "epicsUnitTest.h"
 #include "testMain.h"
@@ -149,10 +151,83 @@ static void testBasicPut(void)
     free(scratch);
 }
 
+static void testConvertWrap(void)
+{
+    double dbuf[NELEMENTS(s_input)];
+    short sbuf[NELEMENTS(s_input)];
+    DBADDR addr;
+    long i;
+    int ok;
+
+    testDiag("Test dbGetConvertRoutine[DBF_SHORT][DBF_DOUBLE] with wrap");
+
+    memset(&addr, 0, sizeof(addr));
+    addr.field_type = DBF_SHORT;
+    addr.field_size = sizeof(short);
+    addr.no_elements = s_input_len;
+    addr.pfield = (void*)s_input;
+
+    dbGetConvertRoutine[DBF_SHORT][DBF_DOUBLE](&addr, dbuf, s_input_len,
+        s_input_len, 4);
+    for (ok = 1, i = 0; i < s_input_len; i++)
+        ok &= dbuf[i] == s_input[(i + 4) % s_input_len];
+    testOk(ok, "Elements 4..6 then 0..3");
+
+    testDiag("Test dbPutConvertRoutine[DBF_DOUBLE][DBF_SHORT] with wrap");
+
+    memset(sbuf, 0, sizeof(sbuf));
+    addr.pfield = sbuf;
+    dbPutConvertRoutine[DBF_DOUBLE][DBF_SHORT](&addr, dbuf, s_input_len - 1,
+        s_input_len, 3);
+    testOk(sbuf[3] == s_input[4] && sbuf[6] == s_input[0] &&
+        sbuf[0] == s_input[1] && sbuf[1] == s_input[2] && sbuf[2] == 0,
+        "Elements 3..6 then 0..1 written");
+}
+
+static void testDoubleToFloat(void)
+{
+    double dbuf[] = {1.5, 1e300, -1e300, 1e-300, -1e-300, 0.0};
+    float fbuf[NELEMENTS(dbuf)];
+    float expect[] = {1.5f, FLT_MAX, -FLT_MAX, FLT_MIN, -FLT_MIN, 0.0f};
+    const long n = NELEMENTS(dbuf);
+    DBADDR addr;
+    long i;
+    int ok;
+
+    testDiag("Test double to float conversions are clipped");
+
+    memset(&addr, 0, sizeof(addr));
+    addr.field_type = DBF_DOUBLE;
+    addr.field_size = sizeof(double);
+    addr.no_elements = n;
+    addr.pfield = dbuf;
+
+    dbGetConvertRoutine[DBF_DOUBLE][DBF_FLOAT](&addr, fbuf, n, n, 2);
+    for (ok = 1, i = 0; i < n; i++)
+        ok &= fbuf[i] == expect[(i + 2) % n];
+    testOk(ok, "dbGet DOUBLE to FLOAT");
+
+    dbuf[1] = epicsNAN;
+    dbGetConvertRoutine[DBF_DOUBLE][DBF_FLOAT](&addr, fbuf, n, n, 0);
+    testOk(isnan(fbuf[1]) && fbuf[0] == 1.5f, "NaN stays NaN");
+    dbuf[1] = 1e300;
+
+    addr.field_type = DBF_FLOAT;
+    addr.field_size = sizeof(float);
+    addr.pfield = fbuf;
+    memset(fbuf, 0, sizeof(fbuf));
+    dbPutConvertRoutine[DBF_DOUBLE][DBF_FLOAT](&addr, dbuf, n, n, 3);
+    for (ok = 1, i = 0; i < n; i++)
+        ok &= fbuf[(i + 3) % n] == expect[i];
+    testOk(ok, "dbPut DOUBLE to FLOAT");
+}
+
 MAIN(testdbConvert)
 {
-    testPlan(15);
+    testPlan(20);
     testBasicGet();
     testBasicPut();
+    testConvertWrap();
+    testDoubleToFloat();
     return testDone();
 }
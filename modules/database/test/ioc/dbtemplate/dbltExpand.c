@@ -11,6 +11,7 @@
  * It calls dbLoadTemplate() to parse the substitution file, but replaces
  * dbLoadRecords() with its own version that reads the template file,
  * expands any macros in the text and prints the result to stdout.
+ * The template cache is not used, so dbTemplateCache() does nothing.
  *
  * This technique won't work on Windows, dbLoadRecords() has to be
  * epicsShare... decorated and loaded from a shared library.
@@ -78,6 +79,10 @@ int dbLoadRecords(const char *file, const char *macros)
     return 0;
 }
 
+void dbTemplateCache(int enable)
+{
+}
+
 int main(int argc, char **argv)
 {
     input_buffer = malloc(BUFFER_SIZE);
@@ -108,6 +108,21 @@ static void createAndOpen(const char *chan, const char *json, const char *type,
            "arr has %d filter(s) in post chain", no);
 }
 
+static void createAndOpenTs(const char *chan, const char *json, dbChannel**pch) {
+    char name[80];
+
+    strncpy(name, chan, sizeof(name)-1);
+    strncat(name, json, sizeof(name)-strlen(name)-1);
+
+    testOk(!!(*pch = dbChannelCreate(name)), "dbChannel with plugins ts and arr created");
+    testOk((ellCount(&(*pch)->filters) == 2), "channel has 2 filters in filter list");
+
+    testOk(!(dbChannelOpen(*pch)), "dbChannel with plugins ts and arr opened");
+
+    testOk((ellCount(&(*pch)->pre_chain) == 1 && ellCount(&(*pch)->post_chain) == 1),
+           "ts in pre chain, arr in post chain");
+}
+
 static void testHead (const char *title, const char *typ = "") {
     const char *line = "------------------------------------------------------------------------------";
     testDiag("%s", line);
@@ -130,6 +145,7 @@ static void testHead (const char *title, const char *typ = "") {
 static void check(short dbr_type) {
     dbChannel *pch;
     db_field_log *pfl, *pfl2;
+    void *pcopy;
     dbAddr valaddr;
     dbAddr offaddr;
     const char *offname = NULL, *valname = NULL, *typname = NULL;
@@ -187,6 +203,18 @@ static void check(short dbr_type) {
     TEST1(10, 4, 1, "wrapped");
     dbChannelDelete(pch);
 
+    testHead("Ten %s elements from rec, whole array left in record", typname);
+    createAndOpen(valname, "{arr:{}}", "(default)", &pch, 1);
+    off = 0;
+    (void) dbPutField(&offaddr, DBR_LONG, &off, 1);
+    pfl = db_create_read_log(pch);
+    pfl2 = dbChannelRunPostChain(pch, pfl);
+    testOk(pfl2 == pfl && !pfl->dtor && pfl->u.r.field == valaddr.pfield,
+           "field log still refers to the record");
+    testOk(fl_equals_array(dbr_type, pfl2, ar), "array data correct");
+    db_delete_field_log(pfl);
+    dbChannelDelete(pch);
+
     testHead("Ten %s elements from rec, increment 1, out-of-bound start parameter", typname);
     createAndOpen(valname, "{arr:{s:-500}}", "out-of-bound start", &pch, 1);
     testOk(pch->final_type == valaddr.field_type,
@@ -291,6 +319,37 @@ static void check(short dbr_type) {
     TEST5B(3, -8,  6, "left side from-end");
     TEST5B(3,  2, -4, "right side from-end");
     TEST5B(3, -8, -4, "both sides from-end");
+
+    /* From a copy made by ts, extracted in place */
+
+#define TEST1T(Size, Offset, Incr, Text) \
+    testDiag("Offset: %d (%s)", Offset, Text); \
+    off = Offset; \
+    (void) dbPutField(&offaddr, DBR_LONG, &off, 1); \
+    pfl = db_create_read_log(pch); \
+    testOk(pfl->type == dbfl_type_ref, "original field log has type ref"); \
+    pfl2 = dbChannelRunPreChain(pch, pfl); \
+    pcopy = pfl2->u.r.field; \
+    pfl2 = dbChannelRunPostChain(pch, pfl2); \
+    testOk(pfl2 == pfl && pfl->dtor && pfl->u.r.field == pcopy, \
+           "field log still holds the copy made by ts"); \
+    testOk(fl_equals_array(dbr_type, pfl2, ar##Size##_##Offset##_##Incr), "array data correct"); \
+    db_delete_field_log(pfl);
+
+#define TEST5T(Incr, Left, Right) \
+    testHead("Five %s elements from ts copy, increment " #Incr, typname); \
+    createAndOpenTs(valname, "{ts:{},arr:{s:" #Left ",e:" #Right ",i:" #Incr "}}", &pch); \
+    testOk(pch->final_no_elements == 4 / Incr + 1, \
+           "final no_elements correct (%ld->%ld)", valaddr.no_elements, pch->final_no_elements); \
+    TEST1T(5, 0, Incr, "no offset"); \
+    TEST1T(5, 3, Incr, "from upper block"); \
+    TEST1T(5, 5, Incr, "wrapped"); \
+    TEST1T(5, 9, Incr, "from lower block"); \
+    dbChannelDelete(pch);
+
+    TEST5T(1, 2, 6);
+    TEST5T(2, 2, 6);
+    TEST5T(3, -8, -4);
 }
 
 MAIN(arrTest)
@@ -299,7 +358,7 @@ MAIN(arrTest)
     const chFilterPlugin *plug;
     char arr[] = "arr";
 
-    testPlan(1402);
+    testPlan(1576);
 
     /* Prepare the IOC */
 
@@ -0,0 +1,131 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/* Measure the time taken to run the filter chains of some channels */
+
+#include <stdio.h>
+
+#include "dbAccess.h"
+#include "dbChannel.h"
+#include "dbEvent.h"
+#include "db_field_log.h"
+#include "dbLock.h"
+#include "dbState.h"
+#include "dbUnitTest.h"
+#include "epicsStdio.h"
+#include "epicsTime.h"
+#include "errlog.h"
+#include "testMain.h"
+
+#include "arrRecord.h"
+
+#define NELM 100000
+#define NLOOPS 1000
+#define DBFILE "filterPerform.db"
+
+void filterTest_registerRecordDeviceDriver(struct dbBase *);
+
+static const char *channels[] = {
+    "x.VAL",
+    "x.VAL{ts:{}}",
+    "x.VAL{dbnd:{d:0.5}}",
+    "x.VAL{dec:{n:4}}",
+    "x.VAL{sync:{m:'while',s:'red'}}",
+    "big.VAL",
+    "big.VAL{ts:{}}",
+    "big.VAL{arr:{}}",
+    "big.VAL[10:-10]",
+    "big.VAL{arr:{i:2}}",
+    "big.VAL{ts:{},arr:{s:10,e:-10}}",
+    "big.VAL{ts:{},arr:{i:2}}",
+    "big.VAL{dec:{n:4}}",
+};
+#define NCHANNELS (sizeof(channels) / sizeof(channels[0]))
+
+static void writeDb(void)
+{
+    FILE *fp = fopen(DBFILE, "w");
+
+    if (!fp)
+        testAbort("Can't create " DBFILE);
+    fprintf(fp, "record(x, \"x\") {}\n");
+    fprintf(fp, "record(arr, \"big\") {\n");
+    fprintf(fp, "    field(NELM, \"%d\")\n", NELM);
+    fprintf(fp, "    field(FTVL, \"DOUBLE\")\n");
+    fprintf(fp, "}\n");
+    fclose(fp);
+}
+
+/* Post to a channel's filter chains the way dbEvent does */
+static double runChains(dbChannel *chan)
+{
+    dbCommon *prec = dbChannelRecord(chan);
+    epicsUInt64 start = epicsMonotonicGet();
+    unsigned i;
+
+    for (i = 0; i < NLOOPS; i++) {
+        db_field_log *pfl;
+
+        dbScanLock(prec);
+        pfl = db_create_read_log(chan);
+        if (!pfl)
+            testAbort("Can't create field log");
+        pfl->ctx = dbfl_context_event;
+        pfl->mask = DBE_VALUE;
+        pfl = dbChannelRunPreChain(chan, pfl);
+        dbScanUnlock(prec);
+
+        pfl = dbChannelRunPostChain(chan, pfl);
+        db_delete_field_log(pfl);
+    }
+    return (epicsMonotonicGet() - start) * 1e-9;
+}
+
+MAIN(filterPerform)
+{
+    dbEventCtx evtctx;
+    arrRecord *pbig;
+    unsigned c;
+
+    testPlan(0);
+
+    writeDb();
+    testdbPrepare();
+    testdbReadDatabase("filterTest.dbd", NULL, NULL);
+    filterTest_registerRecordDeviceDriver(pdbbase);
+    if (dbLoadRecords(DBFILE, NULL))
+        testAbort("Can't load " DBFILE);
+    remove(DBFILE);
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    evtctx = db_init_events();
+    dbStateSet(dbStateCreate("red"));
+
+    pbig = (arrRecord *) testdbRecordPtr("big");
+    pbig->nord = NELM;
+
+    testDiag("Filter chains, %u posts each, arrays of %d doubles",
+        NLOOPS, NELM);
+    for (c = 0; c < NCHANNELS; c++) {
+        dbChannel *chan = dbChannelCreate(channels[c]);
+
+        if (!chan || dbChannelOpen(chan))
+            testAbort("Can't open channel %s", channels[c]);
+        testDiag("%-32s %10.1f ns per post", channels[c],
+            runChains(chan) * 1e9 / NLOOPS);
+        dbChannelDelete(chan);
+    }
+
+    db_close_events(evtctx);
+
+    testIocShutdownOk();
+    testdbCleanup();
+
+    return testDone();
+}
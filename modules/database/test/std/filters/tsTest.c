@@ -85,14 +85,14 @@ MAIN(tsTest)
     node = ellFirst(&pch->filters);
     filter = CONTAINER(node, chFilter, list_node);
     plug->fif->channel_register_pre(filter, &cb_out, &arg_out, &fl1);
-    testOk(!!(cb_out) && !(arg_out), "register_pre registers one filter w/o argument");
+    testOk(!!(cb_out) && !!(arg_out), "register_pre registers one filter with argument");
     testOk(fl_equal(&fl1, &fl), "register_pre does not change field_log data type");
 
     testOk(!(dbChannelOpen(pch)), "dbChannel with plugin ts opened");
     node = ellFirst(&pch->pre_chain);
     filter = CONTAINER(node, chFilter, pre_node);
-    testOk((ellCount(&pch->pre_chain) == 1 && filter->pre_arg == NULL),
-           "ts has one filter w/o argument in pre chain");
+    testOk((ellCount(&pch->pre_chain) == 1 && filter->pre_arg != NULL),
+           "ts has one filter with argument in pre chain");
     testOk((ellCount(&pch->post_chain) == 0), "ts has no filter in post chain");
 
     memset(&fl, PATTERN, sizeof(fl));
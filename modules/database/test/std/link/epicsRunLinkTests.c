@@ -16,6 +16,7 @@
 
 int lnkStateTest(void);
 int lnkCalcTest(void);
+int lnkACalcTest(void);
 
 void epicsRunLinkTests(void)
 {
@@ -23,6 +24,7 @@ void epicsRunLinkTests(void)
 
     runTest(lnkStateTest);
     runTest(lnkCalcTest);
+    runTest(lnkACalcTest);
 
     dbmfFreeChunks();
 
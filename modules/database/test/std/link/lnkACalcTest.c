@@ -0,0 +1,182 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in the file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+#include <string.h>
+#include <math.h>
+
+#include "alarm.h"
+#include "dbAccess.h"
+#include "dbUnitTest.h"
+#include "errlog.h"
+#include "dbLink.h"
+#include "dbState.h"
+#include "testMain.h"
+#include "ioRecord.h"
+
+#define testPutLongStr(PV, VAL) \
+    testdbPutArrFieldOk(PV, DBF_CHAR, sizeof(VAL), VAL);
+
+int linkTest_registerRecordDeviceDriver(struct dbBase *);
+
+static void startTestIoc(const char *dbfile)
+{
+    testdbPrepare();
+    testdbReadDatabase("linkTest.dbd", NULL, NULL);
+    linkTest_registerRecordDeviceDriver(pdbbase);
+    testdbReadDatabase(dbfile, NULL, NULL);
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+}
+
+static void testArray(DBLINK *pinp, long nRequest, long nExpect,
+    const double *expect)
+{
+    double f64[10];
+    long n = nRequest;
+    long status = dbGetLink(pinp, DBR_DOUBLE, f64, NULL, &n);
+    int ok = !status && n == nExpect;
+    long i;
+
+    for (i = 0; ok && i < n; i++)
+        ok = fabs(f64[i] - expect[i]) < 1e-9;
+    if (!testOk(ok, "Got %ld of %ld elements (status = %ld)",
+            n, nExpect, status)) {
+        for (i = 0; i < n; i++)
+            testDiag("  [%ld] = %g", i, f64[i]);
+    }
+}
+
+static void testReduce(DBLINK *pinp, const char *link, double expect)
+{
+    double f64 = 0;
+    long status;
+
+    testdbPutArrFieldOk("io.INPUT", DBF_CHAR, strlen(link) + 1, link);
+    status = dbGetLink(pinp, DBR_DOUBLE, &f64, NULL, NULL);
+    testOk(!status && fabs(f64 - expect) < 1e-9, "%s = %g (%g)",
+        link, f64, expect);
+}
+
+static void testACalc(void)
+{
+    ioRecord *pio;
+    DBLINK *pinp;
+    long nelem = 0;
+
+    startTestIoc("ioRecord.db");
+
+    pio = (ioRecord *) testdbRecordPtr("io");
+    pinp = &pio->input;
+
+    testDiag("Element by element");
+    testPutLongStr("io.INPUT", "{acalc:{"
+        "expr:'A*B+C',"
+        "args:[{const:[1,2,3,4]}, {const:[10,20,30,40,50]}, 0.5]"
+        "}}");
+    if (testOk1(pinp->type == JSON_LINK))
+        testDiag("Link was set to '%s'", pinp->value.json.string);
+    {
+        static const double expect[] = {10.5, 40.5, 90.5, 160.5};
+
+        testArray(pinp, 10, 4, expect);
+        testArray(pinp, 2, 2, expect);
+    }
+    testOk(!dbGetNelements(pinp, &nelem) && nelem == 5,
+        "dbGetNelements() = %ld", nelem);
+
+    testDiag("Single value inputs");
+    {
+        dbStateId red = dbStateCreate("red");
+        static const double expect[] = {2, 3, 4};
+        static const double one[] = {1};
+
+        testPutLongStr("io.INPUT", "{acalc:{"
+            "expr:'A+B',"
+            "args:[{const:[1,2,3]}, {state:'red'}]"
+            "}}");
+        dbStateSet(red);
+        testArray(pinp, 10, 3, expect);
+
+        testPutLongStr("io.INPUT", "{acalc:{"
+            "expr:'A',"
+            "args:[{state:'red'}]"
+            "}}");
+        testArray(pinp, 10, 1, one);
+    }
+
+    testDiag("VAL is the previous result");
+    {
+        static const double expect[] = {1, 3, 6, 10};
+
+        testPutLongStr("io.INPUT", "{acalc:{"
+            "expr:'VAL+A',"
+            "args:[{const:[1,2,3,4]}]"
+            "}}");
+        testArray(pinp, 10, 4, expect);
+    }
+
+    testDiag("Reductions");
+    testReduce(pinp, "{acalc:{expr:'A',args:[{const:[1,2,3,4]}],"
+        "reduce:'sum'}}", 10);
+    testReduce(pinp, "{acalc:{expr:'A',args:[{const:[3,1,4,2]}],"
+        "reduce:'min'}}", 1);
+    testReduce(pinp, "{acalc:{expr:'A',args:[{const:[3,1,4,2]}],"
+        "reduce:'max'}}", 4);
+    testReduce(pinp, "{acalc:{expr:'A',args:[{const:[1,2,3,4]}],"
+        "reduce:'mean'}}", 2.5);
+    testReduce(pinp, "{acalc:{expr:'A',args:[{const:[1,2,3,4]}],"
+        "reduce:'std'}}", sqrt(1.25));
+    testReduce(pinp, "{acalc:{expr:'(A-B)*(A-B)',"
+        "args:[{const:[1,2,3]},{const:[2,4,6]}],reduce:'sum'}}", 14);
+    testOk(!dbGetNelements(pinp, &nelem) && nelem == 1,
+        "dbGetNelements() = %ld", nelem);
+
+    testDiag("Conversion to the requested type");
+    {
+        epicsInt32 i32[4] = {0};
+        long n = 4;
+
+        testPutLongStr("io.INPUT", "{acalc:{"
+            "expr:'A*2',"
+            "args:[{const:[1,2,3]}]"
+            "}}");
+        testOk(!dbGetLink(pinp, DBR_LONG, i32, NULL, &n) && n == 3 &&
+            i32[0] == 2 && i32[1] == 4 && i32[2] == 6,
+            "Got %ld longs %d %d %d", n, i32[0], i32[1], i32[2]);
+    }
+
+    testDiag("An empty input is an error");
+    {
+        double f64 = 0;
+        long n = 4;
+
+        testPutLongStr("io.INPUT", "{acalc:{"
+            "expr:'A+1',"
+            "args:[{const:[]}]"
+            "}}");
+        testOk1(dbGetLink(pinp, DBR_DOUBLE, &f64, NULL, NULL) != 0);
+        testOk(pio->nsta == LINK_ALARM && pio->nsev == INVALID_ALARM,
+            "Alarm raised %d/%d", pio->nsta, pio->nsev);
+        testOk(dbGetLink(pinp, DBR_DOUBLE, &f64, NULL, &n) != 0 && n == 0,
+            "Array request got %ld elements", n);
+    }
+
+    testIocShutdownOk();
+
+    testdbCleanup();
+}
+
+
+MAIN(lnkACalcTest)
+{
+    testPlan(30);
+
+    testACalc();
+
+    return testDone();
+}
@@ -0,0 +1,149 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+#include "dbAccess.h"
+#include "dbUnitTest.h"
+#include "errlog.h"
+#include "recSup.h"
+#include "registryFunction.h"
+#include "testMain.h"
+
+#include "aSubRecord.h"
+
+static
+long doubleSubr(aSubRecord *prec)
+{
+    const epicsFloat64 *pin = prec->a;
+    epicsFloat64 *pout = prec->vala;
+    epicsUInt32 i;
+
+    for (i = 0; i < prec->nea; i++)
+        pout[i] = 2 * pin[i];
+    prec->neva = prec->nea;
+    return 0;
+}
+
+/* Writes its output, then reports an error */
+static
+long failSubr(aSubRecord *prec)
+{
+    doubleSubr(prec);
+    return -1;
+}
+
+/* Completes on the second call */
+static
+long laterSubr(aSubRecord *prec)
+{
+    if (!prec->pact) {
+        prec->pact = TRUE;
+        return 0;
+    }
+    return doubleSubr(prec);
+}
+
+static
+void testBuffers(void)
+{
+    aSubRecord *prec = (aSubRecord *) testdbRecordPtr("double");
+    char *pa = prec->a;
+    char *pvala = prec->vala;
+
+    testDiag("Arrays are carved out of one allocation");
+    testOk(pa + 8 * sizeof(epicsFloat64) == (char *) prec->b,
+        "B follows A (%p, %p)", prec->a, prec->b);
+    testOk(pvala + 8 * sizeof(epicsFloat64) == (char *) prec->valb,
+        "VALB follows VALA (%p, %p)", prec->vala, prec->valb);
+}
+
+static
+void testProcess(void)
+{
+    static const double input[] = {1, 2, 3, 4, 5};
+    static const double expect[] = {2, 4, 6, 8, 10};
+    testMonitor *mon;
+
+    testDiag("Processing");
+    mon = testMonitorCreate("double.VALA", DBE_VALUE, 0);
+    testdbPutArrFieldOk("src", DBF_DOUBLE, 5, input);
+    testdbPutFieldOk("double.PROC", DBF_LONG, 1);
+    testdbGetArrFieldEqual("dst", DBF_DOUBLE, 8, 5, expect);
+    testdbGetArrFieldEqual("double.VALA", DBF_DOUBLE, 8, 5, expect);
+    testdbGetFieldEqual("double.NEVA", DBF_ULONG, 5);
+    testMonitorWait(mon);
+    testOk1(testMonitorCount(mon, 1) == 1);
+    testMonitorDestroy(mon);
+}
+
+static
+void testError(void)
+{
+    static const double input[] = {1, 2, 3};
+    static const double before[] = {7, 8};
+
+    testDiag("Subroutine returns an error");
+    testdbPutArrFieldOk("dst", DBF_DOUBLE, 2, before);
+    testdbPutArrFieldOk("src", DBF_DOUBLE, 3, input);
+    testdbPutFieldOk("fail.PROC", DBF_LONG, 1);
+    testdbGetFieldEqual("fail.VAL", DBF_LONG, -1);
+    testdbGetArrFieldEqual("dst", DBF_DOUBLE, 8, 2, before);
+}
+
+static
+void testAsync(void)
+{
+    static const double input[] = {1, 2, 3};
+    static const double before[] = {7, 8};
+    static const double expect[] = {2, 4, 6};
+    aSubRecord *prec = (aSubRecord *) testdbRecordPtr("later");
+
+    testDiag("Asynchronous subroutine");
+    testdbPutArrFieldOk("dst", DBF_DOUBLE, 2, before);
+    testdbPutArrFieldOk("src", DBF_DOUBLE, 3, input);
+    testdbPutFieldOk("later.PROC", DBF_LONG, 1);
+    testOk1(prec->pact);
+    testdbGetArrFieldEqual("dst", DBF_DOUBLE, 8, 2, before);
+
+    /* Overwrite the source before the subroutine completes */
+    testdbPutArrFieldOk("src", DBF_DOUBLE, 1, expect);
+
+    dbScanLock((dbCommon *) prec);
+    prec->rset->process((dbCommon *) prec);
+    dbScanUnlock((dbCommon *) prec);
+
+    testOk1(!prec->pact);
+    testdbGetArrFieldEqual("dst", DBF_DOUBLE, 8, 3, expect);
+}
+
+void recTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+MAIN(aSubTest)
+{
+    testPlan(21);
+
+    testdbPrepare();
+    testdbReadDatabase("recTestIoc.dbd", NULL, NULL);
+    recTestIoc_registerRecordDeviceDriver(pdbbase);
+    registryFunctionAdd("double", (REGISTRYFUNCTION) doubleSubr);
+    registryFunctionAdd("fail", (REGISTRYFUNCTION) failSubr);
+    registryFunctionAdd("later", (REGISTRYFUNCTION) laterSubr);
+
+    testdbReadDatabase("aSubTest.db", NULL, NULL);
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    testBuffers();
+    testProcess();
+    testError();
+    testAsync();
+
+    testIocShutdownOk();
+    testdbCleanup();
+
+    return testDone();
+}
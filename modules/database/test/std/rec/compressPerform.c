@@ -0,0 +1,122 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+ \*************************************************************************/
+
+/* Measure the time taken by compress records to process large arrays */
+
+#include <stdio.h>
+
+#include <epicsStdio.h>
+#include <epicsTime.h>
+#include <errlog.h>
+#include <dbAccess.h>
+#include <dbLock.h>
+#include <dbUnitTest.h>
+#include <testMain.h>
+
+#define NELEM 1000000
+#define NLOOPS 20
+#define DBFILE "compressPerform.db"
+
+void recTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+static const struct {
+    const char *name;
+    const char *alg;
+    const char *balg;
+    unsigned n;
+} comps[] = {
+    {"circ:fifo", "Circular Buffer", "FIFO Buffer", 1},
+    {"circ:lifo", "Circular Buffer", "LIFO Buffer", 1},
+    {"low:4", "N to 1 Low Value", "FIFO Buffer", 4},
+    {"high:4", "N to 1 High Value", "FIFO Buffer", 4},
+    {"mean:4", "N to 1 Average", "FIFO Buffer", 4},
+    {"low:1000", "N to 1 Low Value", "FIFO Buffer", 1000},
+    {"mean:1000", "N to 1 Average", "FIFO Buffer", 1000},
+    {"median:4", "N to 1 Median", "FIFO Buffer", 4},
+    {"average:4", "Average", "FIFO Buffer", 4},
+};
+#define NCOMPS (sizeof(comps) / sizeof(comps[0]))
+
+static double since(epicsUInt64 start)
+{
+    return (epicsMonotonicGet() - start) * 1e-9;
+}
+
+static void writeDb(void)
+{
+    FILE *fp = fopen(DBFILE, "w");
+    unsigned i;
+
+    if (!fp)
+        testAbort("Can't create " DBFILE);
+    fprintf(fp, "record(waveform, \"src\") {\n");
+    fprintf(fp, "    field(FTVL, \"DOUBLE\")\n");
+    fprintf(fp, "    field(NELM, \"%u\")\n", NELEM);
+    fprintf(fp, "}\n");
+    for (i = 0; i < NCOMPS; i++) {
+        /* Circular buffers wrap on every pass */
+        unsigned nsam = comps[i].n > 1 ? NELEM / comps[i].n : NELEM - 1;
+
+        fprintf(fp, "record(compress, \"%s\") {\n", comps[i].name);
+        fprintf(fp, "    field(INP, \"src NPP\")\n");
+        fprintf(fp, "    field(ALG, \"%s\")\n", comps[i].alg);
+        fprintf(fp, "    field(BALG, \"%s\")\n", comps[i].balg);
+        fprintf(fp, "    field(N, \"%u\")\n", comps[i].n);
+        fprintf(fp, "    field(NSAM, \"%u\")\n", nsam);
+        fprintf(fp, "}\n");
+    }
+    fclose(fp);
+}
+
+static double runProcess(dbCommon *prec)
+{
+    epicsUInt64 start;
+    unsigned i;
+
+    dbScanLock(prec);
+    start = epicsMonotonicGet();
+    for (i = 0; i < NLOOPS; i++)
+        dbProcess(prec);
+    dbScanUnlock(prec);
+    return since(start) / NLOOPS;
+}
+
+MAIN(compressPerform)
+{
+    static double values[NELEM];
+    unsigned i;
+
+    testPlan(0);
+
+    writeDb();
+    testdbPrepare();
+    testdbReadDatabase("recTestIoc.dbd", NULL, NULL);
+    recTestIoc_registerRecordDeviceDriver(pdbbase);
+    testdbReadDatabase(DBFILE, NULL, NULL);
+    remove(DBFILE);
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    for (i = 0; i < NELEM; i++)
+        values[i] = (i * 7919) % 1000;
+    testdbPutArrFieldOk("src", DBF_DOUBLE, NELEM, values);
+
+    testDiag("Processing %u element input arrays", NELEM);
+    for (i = 0; i < NCOMPS; i++) {
+        double elapsed = runProcess(testdbRecordPtr(comps[i].name));
+
+        testDiag("%-10s %-18s %8.3f ms, %6.2f GB/s", comps[i].name,
+            comps[i].alg, elapsed * 1e3,
+            NELEM * sizeof(double) / elapsed * 1e-9);
+    }
+
+    testIocShutdownOk();
+    testdbCleanup();
+
+    return testDone();
+}
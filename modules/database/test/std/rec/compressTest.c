@@ -346,10 +346,70 @@ void testLIFOCirc(void)
     testdbCleanup();
 }
 
+static
+void testArrays(void)
+{
+    static const double input[] = {4, 1, 3, 2, 8, 6, 7, 5, 9, 12, 10, 11};
+    static const double low[] = {1, 2, 5, 10};
+    static const double high[] = {4, 8, 9, 12};
+    static const double median[] = {3, 6, 7, 11};
+    static const double fifo[] = {5, 9, 12, 10, 11};
+    static const double lifo[] = {11, 10, 12, 9, 5};
+    double mean[4];
+    int i;
+
+    testDiag("Test N to 1 compression of arrays");
+
+    for (i = 0; i < 4; i++)
+        mean[i] = (input[3 * i] + input[3 * i + 1] + input[3 * i + 2]) / 3;
+
+    testdbPrepare();
+
+    testdbReadDatabase("recTestIoc.dbd", NULL, NULL);
+
+    recTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    testdbReadDatabase("compressTestArray.db", NULL, NULL);
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    testdbPutArrFieldOk("wf", DBF_DOUBLE, NELEMENTS(input), input);
+
+    testdbPutFieldOk("low.PROC", DBF_LONG, 0);
+    testdbGetArrFieldEqual("low", DBF_DOUBLE, 4, 4, low);
+    testdbPutFieldOk("high.PROC", DBF_LONG, 0);
+    testdbGetArrFieldEqual("high", DBF_DOUBLE, 4, 4, high);
+    testdbPutFieldOk("mean.PROC", DBF_LONG, 0);
+    testdbGetArrFieldEqual("mean", DBF_DOUBLE, 4, 4, mean);
+    testdbPutFieldOk("median.PROC", DBF_LONG, 0);
+    testdbGetArrFieldEqual("median", DBF_DOUBLE, 4, 4, median);
+
+    testDiag("Arrays longer than the buffer keep their last values");
+    testdbPutFieldOk("fifo.PROC", DBF_LONG, 0);
+    testdbGetArrFieldEqual("fifo", DBF_DOUBLE, 5, 5, fifo);
+    testdbPutFieldOk("lifo.PROC", DBF_LONG, 0);
+    testdbGetArrFieldEqual("lifo", DBF_DOUBLE, 5, 5, lifo);
+
+    testDiag("And again, after wrapping around");
+    testdbPutFieldOk("low.PROC", DBF_LONG, 0);
+    testdbGetArrFieldEqual("low", DBF_DOUBLE, 4, 4, low);
+    testdbPutFieldOk("fifo.PROC", DBF_LONG, 0);
+    testdbGetArrFieldEqual("fifo", DBF_DOUBLE, 5, 5, fifo);
+    testdbPutFieldOk("lifo.PROC", DBF_LONG, 0);
+    testdbGetArrFieldEqual("lifo", DBF_DOUBLE, 5, 5, lifo);
+
+    testIocShutdownOk();
+
+    testdbCleanup();
+}
+
 MAIN(compressTest)
 {
-    testPlan(116);
+    testPlan(135);
     testFIFOCirc();
     testLIFOCirc();
+    testArrays();
     return testDone();
 }
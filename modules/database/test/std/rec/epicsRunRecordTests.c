@@ -24,6 +24,9 @@ int asyncSoftTest(void);
 int simmTest(void);
 int mbbioDirectTest(void);
 int scanEventTest(void);
+int fanoutTest(void);
+int histogramTest(void);
+int aSubTest(void);
 
 void epicsRunRecordTests(void)
 {
@@ -51,5 +54,9 @@ void epicsRunRecordTests(void)
 
     runTest(scanEventTest);
 
+    runTest(fanoutTest);
+    runTest(histogramTest);
+    runTest(aSubTest);
+
     epicsExit(0);   /* Trigger test harness */
 }
@@ -0,0 +1,90 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+#include "dbAccess.h"
+#include "dbLock.h"
+#include "dbUnitTest.h"
+#include "epicsThread.h"
+#include "epicsTime.h"
+#include "errlog.h"
+#include "testMain.h"
+
+void recTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+static
+int waitIdle(dbCommon *prec)
+{
+    int pact = 1;
+    int i;
+
+    for (i = 0; pact && i < 500; i++) {
+        epicsThreadSleep(0.01);
+        dbScanLock(prec);
+        pact = prec->pact;
+        dbScanUnlock(prec);
+    }
+    return !pact;
+}
+
+static
+void checkTargets(int count)
+{
+    dbCommon *fan = testdbRecordPtr("fan");
+    int pact, i;
+
+    testdbPutFieldOk("fan.PROC", DBF_LONG, 1);
+
+    dbScanLock(fan);
+    pact = fan->pact;
+    dbScanUnlock(fan);
+    testOk(pact, "fan waits for its targets");
+
+    testOk(waitIdle(fan), "fan completed");
+
+    for (i = 0; i < 5; i++) {
+        char name[8] = "cnt0";
+        dbCommon *cnt;
+
+        name[3] += i;
+        cnt = testdbRecordPtr(name);
+        testdbGetFieldEqual(name, DBF_LONG, count);
+        testOk(epicsTimeLessThanEqual(&cnt->time, &fan->time),
+            "%s completed before fan", name);
+    }
+}
+
+MAIN(fanoutTest)
+{
+    testPlan(2*(3+2*5) + 6);
+
+    testdbPrepare();
+
+    testdbReadDatabase("recTestIoc.dbd", NULL, NULL);
+    recTestIoc_registerRecordDeviceDriver(pdbbase);
+
+    testdbReadDatabase("fanoutTest.db", NULL, NULL);
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    testDiag("Parallel targets");
+    checkTargets(1);
+    checkTargets(2);
+
+    testDiag("Specified link only");
+    testdbPutFieldOk("fan.SELM", DBF_STRING, "Specified");
+    testdbPutFieldOk("fan.SELN", DBF_LONG, 2);
+    testdbPutFieldOk("fan.PROC", DBF_LONG, 1);
+    testOk(waitIdle(testdbRecordPtr("fan")), "fan completed");
+    testdbGetFieldEqual("cnt2", DBF_LONG, 3);
+    testdbGetFieldEqual("cnt0", DBF_LONG, 2);
+
+    testIocShutdownOk();
+    testdbCleanup();
+
+    return testDone();
+}
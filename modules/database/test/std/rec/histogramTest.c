@@ -0,0 +1,169 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+#include <math.h>
+
+#include "dbAccess.h"
+#include "dbUnitTest.h"
+#include "epicsMath.h"
+#include "errlog.h"
+#include "testMain.h"
+
+void recTestIoc_registerRecordDeviceDriver(struct dbBase *);
+
+static
+void putSamples(unsigned long count, const double *samples)
+{
+    testdbPutArrFieldOk("wf", DBF_DOUBLE, count, samples);
+}
+
+static
+void testGetDouble(const char *pv, double expect)
+{
+    DBADDR addr;
+    double val = epicsNAN;
+
+    if (dbNameToAddr(pv, &addr) ||
+        dbGetField(&addr, DBR_DOUBLE, &val, NULL, NULL, NULL)) {
+        testFail("Can't get %s", pv);
+        return;
+    }
+    testOk(fabs(val - expect) < 1e-6, "%s = %g (%g)", pv, val, expect);
+}
+
+static
+void testLinear(void)
+{
+    static const double samples[] = {
+        0.0, 0.5, 1.0, 1.5, 5.0, 9.5, 10.0, -1.0, 0.0
+    };
+    static const epicsUInt32 expect[] = {3, 1, 0, 0, 1, 0, 0, 0, 0, 1};
+    static const epicsUInt32 twice[] = {6, 2, 0, 0, 2, 0, 0, 0, 0, 2};
+    static const epicsUInt32 zero[10];
+    double withNaN[9];
+    int i;
+
+    testDiag("Array of samples, linear bins");
+
+    for (i = 0; i < 9; i++)
+        withNaN[i] = samples[i];
+    withNaN[8] = epicsNAN;
+
+    putSamples(9, withNaN);
+    testdbPutFieldOk("hist.PROC", DBF_LONG, 1);
+    testdbGetFieldEqual("hist.SNRD", DBF_ULONG, 9);
+    testdbGetArrFieldEqual("hist", DBF_ULONG, 10, 10, expect);
+    testdbGetFieldEqual("hist.NCNT", DBF_ULONG, 8);
+    testGetDouble("hist.MEAN", 26.5 / 8);
+    testGetDouble("hist.SMIN", -1.0);
+    testGetDouble("hist.SMAX", 10.0);
+    testGetDouble("hist.SDEV", 4.3419671);
+
+    testDiag("Statistics continue over the next array");
+    putSamples(8, samples);
+    testdbPutFieldOk("hist.PROC", DBF_LONG, 1);
+    testdbGetArrFieldEqual("hist", DBF_ULONG, 10, 10, twice);
+    testdbGetFieldEqual("hist.NCNT", DBF_ULONG, 16);
+    testGetDouble("hist.MEAN", 26.5 / 8);
+    testGetDouble("hist.SDEV", 4.1947388);
+
+    testDiag("An empty array adds nothing");
+    putSamples(0, samples);
+    testdbGetFieldEqual("wf.NORD", DBF_ULONG, 0);
+    testdbPutFieldOk("hist.PROC", DBF_LONG, 1);
+    testdbGetFieldEqual("hist.SNRD", DBF_ULONG, 0);
+    testdbGetArrFieldEqual("hist", DBF_ULONG, 10, 10, twice);
+    testdbGetFieldEqual("hist.NCNT", DBF_ULONG, 16);
+    testGetDouble("hist.MEAN", 26.5 / 8);
+
+    testdbPutFieldOk("hist.CMD", DBF_STRING, "Clear");
+    testdbGetArrFieldEqual("hist", DBF_ULONG, 10, 10, zero);
+    testdbGetFieldEqual("hist.NCNT", DBF_ULONG, 0);
+}
+
+static
+void testPercentiles(void)
+{
+    double samples[1000];
+    int i;
+
+    testDiag("Percentiles from 1000 evenly spread samples");
+
+    for (i = 0; i < 1000; i++)
+        samples[i] = (i + 0.5) / 100;
+    putSamples(1000, samples);
+    testdbPutFieldOk("hist.PROC", DBF_LONG, 1);
+    testdbGetFieldEqual("hist.NCNT", DBF_ULONG, 1000);
+    testGetDouble("hist.MEAN", 5.0);
+    testGetDouble("hist.PVLA", 5.0);
+    testGetDouble("hist.PVLB", 9.0);
+    testGetDouble("hist.PVLC", 9.9);
+    testdbPutFieldOk("hist.CMD", DBF_STRING, "Clear");
+}
+
+static
+void testLog(void)
+{
+    static const double samples[] = {2, 10, 20, 200, 2000, 0.5, -3, 10000};
+    static const epicsUInt32 expect[] = {2, 1, 1, 1};
+
+    testDiag("Logarithmic bins");
+
+    testGetDouble("hlog.WDTH", 1.0);
+    putSamples(8, samples);
+    testdbPutFieldOk("hlog.PROC", DBF_LONG, 1);
+    testdbGetArrFieldEqual("hlog", DBF_ULONG, 4, 4, expect);
+    testdbGetFieldEqual("hlog.NCNT", DBF_ULONG, 8);
+    testGetDouble("hlog.PVLA", pow(10.0, 1.5));
+
+    testdbPutFieldOk("hlog.LLIM", DBF_DOUBLE, 0.0);
+    testdbPutFieldOk("hlog.PROC", DBF_LONG, 1);
+    testdbGetFieldEqual("hlog.NCNT", DBF_ULONG, 0);
+}
+
+static
+void testScalar(void)
+{
+    static const epicsUInt32 expect[] = {1, 1, 0, 1};
+
+    testDiag("Single values put to SGNL");
+
+    testdbPutFieldOk("hone.SGNL", DBF_DOUBLE, 0.0);
+    testdbPutFieldOk("hone.SGNL", DBF_DOUBLE, 1.5);
+    testdbPutFieldOk("hone.SGNL", DBF_DOUBLE, 3.99);
+    testdbPutFieldOk("hone.SGNL", DBF_DOUBLE, 4.0);
+    testdbGetArrFieldEqual("hone", DBF_ULONG, 4, 4, expect);
+    testdbGetFieldEqual("hone.NCNT", DBF_ULONG, 4);
+    testdbGetFieldEqual("hone.MCNT", DBF_LONG, 3);
+
+    testdbPutFieldOk("hone.CMD", DBF_STRING, "Stop");
+    testdbPutFieldOk("hone.SGNL", DBF_DOUBLE, 0.0);
+    testdbGetArrFieldEqual("hone", DBF_ULONG, 4, 4, expect);
+}
+
+MAIN(histogramTest)
+{
+    testPlan(52);
+
+    testdbPrepare();
+    testdbReadDatabase("recTestIoc.dbd", NULL, NULL);
+    recTestIoc_registerRecordDeviceDriver(pdbbase);
+    testdbReadDatabase("histogramTest.db", NULL, NULL);
+
+    eltc(0);
+    testIocInitOk();
+    eltc(1);
+
+    testLinear();
+    testPercentiles();
+    testLog();
+    testScalar();
+
+    testIocShutdownOk();
+    testdbCleanup();
+
+    return testDone();
+}
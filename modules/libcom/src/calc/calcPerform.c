@@ -142,7 +142,9 @@ LIBCOM_API long
 
         case MODULO:
             itop = (epicsInt32) *ptop--;
-            if (itop)
+            if (itop == -1)     /* INT_MIN % -1 traps on some CPUs */
+                *ptop = 0;
+            else if (itop)
                 *ptop = (epicsInt32) *ptop % itop;
             else
                 *ptop = epicsNAN;
@@ -385,6 +387,46 @@ LIBCOM_API long
         case COND_END:
             break;
 
+        case ADD_ARG:
+            *ptop += parg[(int) *pinst++];
+            break;
+
+        case SUB_ARG:
+            *ptop -= parg[(int) *pinst++];
+            break;
+
+        case MULT_ARG:
+            *ptop *= parg[(int) *pinst++];
+            break;
+
+        case DIV_ARG:
+            *ptop /= parg[(int) *pinst++];
+            break;
+
+        case NOT_EQ_ARG:
+            *ptop = *ptop != parg[(int) *pinst++];
+            break;
+
+        case LESS_THAN_ARG:
+            *ptop = *ptop < parg[(int) *pinst++];
+            break;
+
+        case LESS_OR_EQ_ARG:
+            *ptop = *ptop <= parg[(int) *pinst++];
+            break;
+
+        case EQUAL_ARG:
+            *ptop = *ptop == parg[(int) *pinst++];
+            break;
+
+        case GR_OR_EQ_ARG:
+            *ptop = *ptop >= parg[(int) *pinst++];
+            break;
+
+        case GR_THAN_ARG:
+            *ptop = *ptop > parg[(int) *pinst++];
+            break;
+
         default:
             errlogPrintf("calcPerform: Bad Opcode %d at %p\n", op, pinst-1);
             return -1;
@@ -440,6 +482,19 @@ calcArgUsage(const char *pinst, unsigned long *pinputs, unsigned long *pstores)
             inputs |= (1 << (op - FETCH_A)) & ~stores;
             break;
 
+        case ADD_ARG:
+        case SUB_ARG:
+        case MULT_ARG:
+        case DIV_ARG:
+        case NOT_EQ_ARG:
+        case LESS_THAN_ARG:
+        case LESS_OR_EQ_ARG:
+        case EQUAL_ARG:
+        case GR_OR_EQ_ARG:
+        case GR_THAN_ARG:
+            inputs |= (1 << *pinst++) & ~stores;
+            break;
+
         case STORE_A:
         case STORE_B:
         case STORE_C:
@@ -508,6 +563,16 @@ static int cond_search(const char **ppinst, int match)
         case MAX:
         case FINITE:
         case ISNAN:
+        case ADD_ARG:
+        case SUB_ARG:
+        case MULT_ARG:
+        case DIV_ARG:
+        case NOT_EQ_ARG:
+        case LESS_THAN_ARG:
+        case LESS_OR_EQ_ARG:
+        case EQUAL_ARG:
+        case GR_OR_EQ_ARG:
+        case GR_THAN_ARG:
             pinst++;
             break;
         case COND_IF:
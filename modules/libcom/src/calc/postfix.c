@@ -206,6 +206,225 @@ static int
 }
 
 
+/* fold_constant
+ *
+ * Evaluate the constant instructions from pstart up to pend and replace
+ * them with a literal holding the result. Returns the new end of the
+ * instructions, or NULL if the literal would need more space.
+ */
+static char *
+    fold_constant(char *pstart, char *pend)
+{
+    double args[CALCPERFORM_NARGS] = {0};
+    double lit_d = 0;
+    epicsInt32 lit_i;
+    char save = *pend;
+    long status;
+
+    *pend = END_EXPRESSION;
+    status = calcPerform(args, &lit_d, pstart);
+    *pend = save;
+    if (status)
+        return NULL;
+
+    /* Same encoding as the parser, but never lose the sign of -0.0 */
+    if (lit_d >= -2147483648.0 && lit_d <= 2147483647.0 &&
+        lit_d == (double) (lit_i = (epicsInt32) lit_d) &&
+        (lit_d != 0 || 1.0 / lit_d > 0)) {
+        if (pend - pstart < 1 + (int) sizeof(epicsInt32))
+            return NULL;
+        *pstart++ = LITERAL_INT;
+        memcpy(pstart, &lit_i, sizeof(epicsInt32));
+        return pstart + sizeof(epicsInt32);
+    }
+    if (pend - pstart < 1 + (int) sizeof(double))
+        return NULL;
+    *pstart++ = LITERAL_DOUBLE;
+    memcpy(pstart, &lit_d, sizeof(double));
+    return pstart + sizeof(double);
+}
+
+/* fused_opcode
+ *
+ * Return the fused form of a binary operator whose right operand is an
+ * argument, or NOT_GENERATED if it doesn't have one.
+ */
+static int
+    fused_opcode(int op)
+{
+    switch (op) {
+    case ADD:           return ADD_ARG;
+    case SUB:           return SUB_ARG;
+    case MULT:          return MULT_ARG;
+    case DIV:           return DIV_ARG;
+    case NOT_EQ:        return NOT_EQ_ARG;
+    case LESS_THAN:     return LESS_THAN_ARG;
+    case LESS_OR_EQ:    return LESS_OR_EQ_ARG;
+    case EQUAL:         return EQUAL_ARG;
+    case GR_OR_EQ:      return GR_OR_EQ_ARG;
+    case GR_THAN:       return GR_THAN_ARG;
+    }
+    return NOT_GENERATED;
+}
+
+/* optimize
+ *
+ * Rewrite a valid postfix expression in place. Operators whose operands
+ * are all constant are folded into a literal if that doesn't make the
+ * code longer, and an argument fetch followed by a common arithmetic or
+ * relational operator becomes one fused instruction. Folding evaluates
+ * the operators with calcPerform(), so the results don't change.
+ */
+static void
+    optimize(char *pinst)
+{
+    struct {
+        char *pstart;   /* first instruction computing this value */
+        int constant;
+    } value[CALCPERFORM_STACK + 1];
+    int depth = 0;
+    const char *pin = pinst;
+    char *pout = pinst;
+    char *plast = NULL;     /* previous instruction output */
+    int op;
+
+    while ((op = *pin) != END_EXPRESSION) {
+        int len = 1;
+        int pops = 0;
+        int pushes = 1;
+        int constant = FALSE;   /* pushes a literal or constant */
+        int fold = FALSE;       /* depends only on its operands */
+        char *pstart;
+
+        switch (op) {
+        case LITERAL_DOUBLE:
+            len += sizeof(double);
+            constant = TRUE;
+            break;
+
+        case LITERAL_INT:
+            len += sizeof(epicsInt32);
+            constant = TRUE;
+            break;
+
+        case CONST_PI:
+        case CONST_D2R:
+        case CONST_R2D:
+            constant = TRUE;
+            break;
+
+        case FETCH_VAL:
+        case FETCH_A: case FETCH_B: case FETCH_C: case FETCH_D:
+        case FETCH_E: case FETCH_F: case FETCH_G: case FETCH_H:
+        case FETCH_I: case FETCH_J: case FETCH_K: case FETCH_L:
+        case RANDOM:
+            break;
+
+        case STORE_A: case STORE_B: case STORE_C: case STORE_D:
+        case STORE_E: case STORE_F: case STORE_G: case STORE_H:
+        case STORE_I: case STORE_J: case STORE_K: case STORE_L:
+            pops = 1;
+            pushes = 0;
+            break;
+
+        case MIN:
+        case MAX:
+        case FINITE:
+        case ISNAN:
+            len = 2;
+            pops = pin[1];
+            fold = TRUE;
+            break;
+
+        case UNARY_NEG:
+        case ABS_VAL:
+        case EXP:
+        case LOG_10:
+        case LOG_E:
+        case SQU_RT:
+        case ACOS:
+        case ASIN:
+        case ATAN:
+        case COS:
+        case COSH:
+        case SIN:
+        case SINH:
+        case TAN:
+        case TANH:
+        case CEIL:
+        case FLOOR:
+        case ISINF:
+        case NINT:
+        case REL_NOT:
+        case BIT_NOT:
+            pops = 1;
+            fold = TRUE;
+            break;
+
+        case COND_IF:
+        case COND_ELSE:
+            pops = 1;
+            pushes = 0;
+            break;
+
+        case COND_END:
+            /* The result of a conditional is never constant */
+            value[depth - 1].constant = FALSE;
+            pushes = 0;
+            break;
+
+        default:
+            /* All the other operators are binary */
+            pops = 2;
+            fold = TRUE;
+            break;
+        }
+
+        pstart = pops ? value[depth - pops].pstart : pout;
+        memmove(pout, pin, len);
+        pin += len;
+
+        if (fold) {
+            char *pend;
+            int i;
+
+            for (i = depth - pops; i < depth; i++)
+                fold = fold && value[i].constant;
+            if (fold && (pend = fold_constant(pstart, pout + len))) {
+                depth -= pops;
+                value[depth].pstart = pstart;
+                value[depth++].constant = TRUE;
+                plast = pstart;
+                pout = pend;
+                continue;
+            }
+            /* Too long here, but may fold into a larger expression */
+            constant = fold;
+        }
+
+        if (plast && *plast >= FETCH_A && *plast <= FETCH_L &&
+            fused_opcode(op) != NOT_GENERATED) {
+            /* The fetch was the right operand */
+            plast[1] = *plast - FETCH_A;
+            plast[0] = fused_opcode(op);
+            pout = plast + 2;
+            depth--;
+            value[depth - 1].constant = FALSE;
+            continue;
+        }
+
+        depth -= pops;
+        if (pushes) {
+            value[depth].pstart = pstart;
+            value[depth++].constant = constant;
+        }
+        plast = pout;
+        pout += len;
+    }
+    *pout = END_EXPRESSION;
+}
+
+
 /* postfix
  *
  * convert an infix expression to a postfix expression
@@ -482,6 +701,7 @@ LIBCOM_API long
         *perror = CALC_ERR_INCOMPLETE;
         goto bad;
     }
+    optimize(pdest);
     return 0;
 
 bad:
@@ -598,6 +818,17 @@ LIBCOM_API void
         "COND_IF",
         "COND_ELSE",
         "COND_END",
+    /* Fused operators */
+        "ADD_ARG",
+        "SUB_ARG",
+        "MULT_ARG",
+        "DIV_ARG",
+        "NOT_EQ_ARG",
+        "LESS_THAN_ARG",
+        "LESS_OR_EQ_ARG",
+        "EQUAL_ARG",
+        "GR_OR_EQ_ARG",
+        "GR_THAN_ARG",
     /* Misc */
         "NOT_GENERATED"
     };
@@ -624,6 +855,19 @@ LIBCOM_API void
             printf("\t%s, %d arg(s)\n", opcodes[(int) op], *++pinst);
             pinst++;
             break;
+        case ADD_ARG:
+        case SUB_ARG:
+        case MULT_ARG:
+        case DIV_ARG:
+        case NOT_EQ_ARG:
+        case LESS_THAN_ARG:
+        case LESS_OR_EQ_ARG:
+        case EQUAL_ARG:
+        case GR_OR_EQ_ARG:
+        case GR_THAN_ARG:
+            printf("\t%s %c\n", opcodes[(int) op], 'A' + *++pinst);
+            pinst++;
+            break;
         default:
             printf("\t%s\n", opcodes[(int) op]);
             pinst++;
@@ -21,6 +21,10 @@
  *     a byte giving the number of arguments to process.
  *  4. You can't use strlen() on an RPN buffer since the literal values
  *     can contain zero bytes.
+ *  5. The fused operators ADD_ARG through GR_THAN_ARG are followed by a
+ *     byte giving the argument index (0 for A) of their right operand,
+ *     which replaces a FETCH_A to FETCH_L instruction. These bytes can
+ *     also be zero.
  */
 
 #ifndef INCpostfixPvth
@@ -99,6 +103,17 @@ typedef enum {
     COND_IF,
     COND_ELSE,
     COND_END,
+    /* Fused operators, only generated by the optimizer */
+    ADD_ARG,
+    SUB_ARG,
+    MULT_ARG,
+    DIV_ARG,
+    NOT_EQ_ARG,
+    LESS_THAN_ARG,
+    LESS_OR_EQ_ARG,
+    EQUAL_ARG,
+    GR_OR_EQ_ARG,
+    GR_THAN_ARG,
     /* Misc */
     NOT_GENERATED
 } rpn_opcode;
@@ -52,6 +52,7 @@ LIBCOM_API extern const ENV_PARAM EPICS_CA_SERVER_PORT;
 LIBCOM_API extern const ENV_PARAM EPICS_CA_MAX_ARRAY_BYTES;
 LIBCOM_API extern const ENV_PARAM EPICS_CA_AUTO_ARRAY_BYTES;
 LIBCOM_API extern const ENV_PARAM EPICS_CA_MAX_SEARCH_PERIOD;
+LIBCOM_API extern const ENV_PARAM EPICS_CA_ANOMALY_SEARCH_RATE;
 LIBCOM_API extern const ENV_PARAM EPICS_CA_NAME_SERVERS;
 LIBCOM_API extern const ENV_PARAM EPICS_CA_MCAST_TTL;
 LIBCOM_API extern const ENV_PARAM EPICS_CAS_INTF_ADDR_LIST;
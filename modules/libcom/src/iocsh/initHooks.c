@@ -20,7 +20,9 @@
 #include "dbDefs.h"
 #include "ellLib.h"
 #include "epicsMutex.h"
+#include "epicsStdio.h"
 #include "epicsThread.h"
+#include "epicsTime.h"
 
 #include "initHooks.h"
 
@@ -32,6 +34,20 @@ typedef struct initHookLink {
 static ELLLIST functionList = ELLLIST_INIT;
 static epicsMutexId listLock;
 
+/*
+ * When each state was announced, and how long its hooks took,
+ * in announcement order since the last initHookAtIocBuild
+ */
+typedef struct initHookTiming {
+    initHookState state;
+    epicsUInt64   announced;
+    epicsUInt64   inHooks;
+} initHookTiming;
+
+#define MAX_TIMINGS 64
+static initHookTiming timings[MAX_TIMINGS];
+static int nTimings;
+
 /*
  * Lazy initialization functions
  */
@@ -77,10 +93,20 @@ int initHookRegister(initHookFunction func)
 void initHookAnnounce(initHookState state)
 {
     initHookLink *hook;
+    initHookTiming *ptiming = NULL;
+    epicsUInt64 start = epicsMonotonicGet();
 
     initHookInit();
 
     epicsMutexMustLock(listLock);
+    if (state == initHookAtIocBuild)
+        nTimings = 0;
+    if (nTimings < MAX_TIMINGS) {
+        ptiming = &timings[nTimings++];
+        ptiming->state = state;
+        ptiming->announced = start;
+        ptiming->inHooks = 0;
+    }
     hook = (initHookLink *)ellFirst(&functionList);
     epicsMutexUnlock(listLock);
 
@@ -91,6 +117,60 @@ void initHookAnnounce(initHookState state)
         hook = (initHookLink *)ellNext(&hook->node);
         epicsMutexUnlock(listLock);
     }
+
+    if (ptiming) {
+        epicsMutexMustLock(listLock);
+        ptiming->inHooks = epicsMonotonicGet() - start;
+        epicsMutexUnlock(listLock);
+    }
+}
+
+/*
+ * Boot time profile
+ */
+double initHookTime(initHookState state)
+{
+    double elapsed = -1.0;
+    int i;
+
+    initHookInit();
+
+    epicsMutexMustLock(listLock);
+    for (i = nTimings - 1; i >= 0; i--) {
+        if (timings[i].state == state) {
+            elapsed = (timings[i].announced - timings[0].announced) * 1e-9;
+            break;
+        }
+    }
+    epicsMutexUnlock(listLock);
+    return elapsed;
+}
+
+void initHookShowTimes(void)
+{
+    initHookTiming copy[MAX_TIMINGS];
+    int i, n;
+
+    initHookInit();
+
+    epicsMutexMustLock(listLock);
+    n = nTimings;
+    for (i = 0; i < n; i++)
+        copy[i] = timings[i];
+    epicsMutexUnlock(listLock);
+
+    if (!n) {
+        printf("No initHook states have been announced\n");
+        return;
+    }
+    printf("%-32s %10s %10s %10s\n", "State", "Elapsed", "Step", "In hooks");
+    for (i = 0; i < n; i++) {
+        epicsUInt64 step = i ? copy[i].announced - copy[i - 1].announced : 0;
+
+        printf("%-32s %10.3f %10.3f %10.3f\n", initHookName(copy[i].state),
+            (copy[i].announced - copy[0].announced) * 1e-9, step * 1e-9,
+            copy[i].inHooks * 1e-9);
+    }
 }
 
 void initHookFree(void)
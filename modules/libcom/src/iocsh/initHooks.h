@@ -136,6 +136,26 @@ LIBCOM_API void initHookAnnounce(initHookState state);
  */
 LIBCOM_API const char *initHookName(int state);
 
+/** \brief Returns when \p state was last announced
+ *
+ * The IOC records the time of each announcement and how long the
+ * registered functions took to run, starting again at each
+ * initHookAtIocBuild.
+ * \param state initHook enumeration value
+ * \return Seconds from initHookAtIocBuild to the announcement of \p state,
+ * or a negative value if \p state has not been announced.
+ */
+LIBCOM_API double initHookTime(initHookState state);
+
+/** \brief Print the time of each initHook announcement
+ *
+ * Lists the states announced since the last initHookAtIocBuild, with the
+ * time since that start, the time since the previous state and the time
+ * spent in the registered functions, all in seconds.
+ * The "Step" column shows where IOC boot time goes.
+ */
+LIBCOM_API void initHookShowTimes(void);
+
 /** \brief Forget all registered application functions
  *
  * This cleanup routine is called by unit test programs between IOC runs.
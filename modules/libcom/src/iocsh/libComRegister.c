@@ -25,6 +25,7 @@
 #include "taskwd.h"
 #include "registry.h"
 #include "epicsGeneralTime.h"
+#include "initHooks.h"
 #include "libComRegister.h"
 
 /* Register the PWD environment variable when the cd IOC shell function is
@@ -307,6 +308,15 @@ static void iocLogPrefixCallFunc(const iocshArgBuf *args)
     iocLogPrefix(args[0].sval);
 }
 
+/* initHookShowTimes */
+static const iocshFuncDef initHookShowTimesFuncDef = {"initHookShowTimes",0,NULL,
+    "Show when each initHook state was announced during IOC startup,\n"
+    "and how long the registered hook functions took.\n"};
+static void initHookShowTimesCallFunc(const iocshArgBuf *args)
+{
+    initHookShowTimes();
+}
+
 /* epicsThreadShowAll */
 static const iocshArg epicsThreadShowAllArg0 = { "level",iocshArgInt};
 static const iocshArg * const epicsThreadShowAllArgs[1] = {&epicsThreadShowAllArg0};
@@ -494,6 +504,8 @@ void epicsStdCall libComRegister(void)
     iocshRegister(&errlogFuncDef, errlogCallFunc);
     iocshRegister(&iocLogPrefixFuncDef, iocLogPrefixCallFunc);
 
+    iocshRegister(&initHookShowTimesFuncDef,initHookShowTimesCallFunc);
+
     iocshRegister(&epicsThreadShowAllFuncDef,epicsThreadShowAllCallFunc);
     iocshRegister(&threadFuncDef, threadCallFunc);
     iocshRegister(&taskwdShowFuncDef,taskwdShowCallFunc);
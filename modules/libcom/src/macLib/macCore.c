@@ -10,13 +10,13 @@
 /*
  * Implementation of core macro substitution library (macLib)
  *
- * The implementation is fairly unsophisticated and linked lists are
- * used to store macro values. Typically there will will be only a
- * small number of macros and performance won't be a problem. Special
- * measures are taken to avoid unnecessary expansion of macros whose
- * definitions reference other macros. Whenever a macro is created,
- * modified or deleted, a "dirty" flag is set; this causes a full
- * expansion of all macros the next time a macro value is read
+ * Macro values are stored in a linked list in the order they were
+ * defined, and a hash index of their names finds the most recent
+ * definition of a name without searching the list. Special measures
+ * are taken to avoid unnecessary expansion of macros whose definitions
+ * reference other macros. Whenever a macro is created, modified or
+ * deleted, a "dirty" flag is set; this causes a full expansion of all
+ * macros the next time a macro value is read
  *
  * Original Author: William Lupton, W. M. Keck Observatory
  */
@@ -29,6 +29,7 @@
 #include "dbDefs.h"
 #include "errlog.h"
 #include "dbmf.h"
+#include "epicsString.h"
 #include "macLib.h"
 
 
@@ -46,10 +47,53 @@ typedef struct mac_entry {
     size_t      length;         /* length of value */
     int         error;          /* error expanding value? */
     int         visited;        /* ever been visited? */
+    int         expanding;      /* value being expanded? */
+    int         fresh;          /* value expanded in this expand() pass? */
     int         special;        /* special (internal) entry? */
     int         level;          /* scoping level */
+    unsigned int hash;          /* hash of name */
+    struct mac_entry *chain;    /* next entry in same index bucket */
 } MAC_ENTRY;
 
+/*
+ * Hash index of the (non-special) entries of a context; each bucket is
+ * a chain of entries, most recently created first, so the first match
+ * is the one a backwards search of the list would have found
+ */
+struct macIndex {
+    MAC_ENTRY   **buckets;
+    unsigned int mask;          /* number of buckets - 1 */
+    unsigned int count;         /* number of entries */
+};
+
+/*
+ * Line of a pre-scanned template, and the extent of a macro reference
+ * within a line (from the '$' to just after the closing bracket)
+ */
+typedef struct {
+    size_t      offset;         /* start of line in template text */
+    size_t      length;         /* strlen(line) */
+    size_t      firstRef;       /* index of first reference in refs */
+    size_t      nrefs;          /* number of references in line */
+} MAC_TEMPLATE_LINE;
+
+typedef struct {
+    size_t      start;          /* offset of '$' in line */
+    size_t      end;            /* offset of character after reference */
+} MAC_TEMPLATE_REF;
+
+struct macTemplate {
+    char        *text;          /* all lines, each zero-terminated */
+    size_t      textSize;
+    size_t      textAlloc;
+    MAC_TEMPLATE_LINE *lines;
+    size_t      nlines;
+    size_t      linesAlloc;
+    MAC_TEMPLATE_REF *refs;
+    size_t      nrefs;
+    size_t      refsAlloc;
+};
+
 
 /*** Local function prototypes ***/
 
@@ -66,6 +110,9 @@ static MAC_ENTRY *lookup( MAC_HANDLE *handle, const char *name, int special );
 static char      *rawval( MAC_HANDLE *handle, MAC_ENTRY *entry, const char *value );
 static void       delete( MAC_HANDLE *handle, MAC_ENTRY *entry );
 static long       expand( MAC_HANDLE *handle );
+static long       expandEntry( MAC_HANDLE *handle, MAC_ENTRY *entry );
+static void       indexAdd( MAC_HANDLE *handle, MAC_ENTRY *entry );
+static void       indexRemove( MAC_HANDLE *handle, MAC_ENTRY *entry );
 static void       trans ( MAC_HANDLE *handle, MAC_ENTRY *entry, int level,
                           const char *term, const char **rawval, char **value,
                           char *valend );
@@ -73,6 +120,7 @@ static void       refer ( MAC_HANDLE *handle, MAC_ENTRY *entry, int level,
                           const char **rawval, char **value, char *valend );
 
 static void cpy2val( const char *src, char **value, char *valend );
+static int  addLine( macTemplate *tmpl, MAC_HANDLE *scratch, const char *line );
 static char *Strdup( const char *string );
 
 
@@ -87,6 +135,7 @@ static char *Strdup( const char *string );
  * Flag bits
  */
 #define FLAG_SUPPRESS_WARNINGS  0x1
+#define FLAG_EXPANDING          0x2
 #define FLAG_USE_ENVIRONMENT    0x80
 
 
@@ -125,6 +174,7 @@ epicsStdCall macCreateHandle(
     handle->level = 0;
     handle->debug = 0;
     handle->flags = 0;
+    handle->index = NULL;
     ellInit( &handle->list );
 
     /* use environment variables if so specified */
@@ -158,8 +208,13 @@ epicsStdCall macSuppressWarning(
 )
 {
     if ( handle && handle->magic == MAC_MAGIC ) {
-        handle->flags = (handle->flags & ~FLAG_SUPPRESS_WARNINGS) |
-                        (suppress ? FLAG_SUPPRESS_WARNINGS : 0);
+        int flags = (handle->flags & ~FLAG_SUPPRESS_WARNINGS) |
+                    (suppress ? FLAG_SUPPRESS_WARNINGS : 0);
+
+        /* expanded values with errors in them depend on this flag */
+        if ( flags != handle->flags )
+            handle->dirty = TRUE;
+        handle->flags = flags;
     }
 }
 
@@ -378,6 +433,10 @@ epicsStdCall macDeleteHandle(
         nextEntry = next( entry );
         delete( handle, entry );
     }
+    if ( handle->index ) {
+        free( handle->index->buckets );
+        free( handle->index );
+    }
 
     /* clear magic field and free context structure */
     handle->magic = 0;
@@ -503,6 +562,180 @@ epicsStdCall macReportMacros(
     return 0;
 }
 
+/*
+ * Read a file into a pre-scanned template
+ */
+macTemplate *                   /* NULL = ERROR */
+epicsStdCall macTemplateRead(
+    FILE        *fp,            /* file to read */
+
+    int         lineSize )      /* size of line buffer used with fgets() */
+{
+    macTemplate *tmpl;
+    MAC_HANDLE *scratch;
+    char *buffer;
+    int status = 0;
+
+    if ( fp == NULL || lineSize < 2 ) {
+        errlogPrintf( "macTemplateRead: invalid arguments\n" );
+        return NULL;
+    }
+
+    /* references are located by dry runs in an empty context */
+    if ( macCreateHandle( &scratch, NULL ) )
+        return NULL;
+    scratch->flags |= FLAG_SUPPRESS_WARNINGS;
+
+    tmpl = calloc( 1, sizeof( macTemplate ) );
+    buffer = malloc( lineSize );
+    if ( tmpl == NULL || buffer == NULL ) {
+        errlogPrintf( "macTemplateRead: failed to allocate template\n" );
+        status = -1;
+    }
+
+    while ( status == 0 && fgets( buffer, lineSize, fp ) != NULL )
+        status = addLine( tmpl, scratch, buffer );
+
+    if ( status == 0 && ferror( fp ) ) {
+        errlogPrintf( "macTemplateRead: read error\n" );
+        status = -1;
+    }
+
+    free( buffer );
+    macDeleteHandle( scratch );
+    if ( status ) {
+        macTemplateFree( tmpl );
+        return NULL;
+    }
+    return tmpl;
+}
+
+/*
+ * Return number of lines in a template
+ */
+int
+epicsStdCall macTemplateLines(
+    const macTemplate *tmpl )   /* template */
+{
+    return tmpl ? (int) tmpl->nlines : 0;
+}
+
+/*
+ * Return raw text of a template line
+ */
+const char *                    /* NULL if no such line */
+epicsStdCall macTemplateLine(
+    const macTemplate *tmpl,    /* template */
+
+    int         line )          /* line number */
+{
+    if ( tmpl == NULL || line < 0 || (size_t) line >= tmpl->nlines )
+        return NULL;
+    return tmpl->text + tmpl->lines[line].offset;
+}
+
+/*
+ * Expand a template line; equivalent to macExpandString() on the raw
+ * line, but only the macro references are parsed, the text between them
+ * is copied directly
+ */
+long                            /* strlen(dest), <0 if any macros are */
+                                /* undefined */
+epicsStdCall macTemplateExpandLine(
+    MAC_HANDLE  *handle,        /* opaque handle */
+
+    const macTemplate *tmpl,    /* template */
+
+    int         line,           /* line number */
+
+    char        *dest,          /* destination string */
+
+    long        capacity )      /* capacity of destination buffer (dest) */
+{
+    const MAC_TEMPLATE_LINE *pline;
+    const MAC_TEMPLATE_REF *pref;
+    MAC_ENTRY entry;
+    const char *src;
+    char *d, *dend;
+    size_t pos, n;
+    long length;
+
+    /* check handle */
+    if ( handle == NULL || handle->magic != MAC_MAGIC ) {
+        errlogPrintf( "macTemplateExpandLine: NULL or invalid handle\n" );
+        return -1;
+    }
+
+    /* Check line and size */
+    if ( tmpl == NULL || line < 0 || (size_t) line >= tmpl->nlines ||
+         capacity <= 1 )
+        return -1;
+
+    pline = &tmpl->lines[line];
+    src = tmpl->text + pline->offset;
+
+    /* debug output */
+    if ( handle->debug & 1 )
+        printf( "macTemplateExpandLine( %s, capacity = %ld )\n", src, capacity );
+
+    /* expand raw values if necessary */
+    if ( pline->nrefs && expand( handle ) < 0 )
+        errlogPrintf( "macTemplateExpandLine: failed to expand raw values\n" );
+
+    /* fill in necessary fields in fake macro entry structure */
+    entry.name  = (char *) src;
+    entry.type  = "string";
+    entry.error = FALSE;
+
+    /* copy the text, expanding the references */
+    d    = dest;
+    dend = dest + capacity - 1;
+    pos  = 0;
+    pref = tmpl->refs + pline->firstRef;
+    for ( n = 0; n <= pline->nrefs; n++, pref++ ) {
+        size_t end = ( n < pline->nrefs ) ? pref->start : pline->length;
+        size_t count = end - pos;
+
+        if ( count > (size_t) ( dend - d ) )
+            count = dend - d;
+        memcpy( d, src + pos, count );
+        d += count;
+        *d = '\0';
+
+        if ( n < pline->nrefs ) {
+            const char *r = src + pref->start;
+
+            refer( handle, &entry, 0, &r, &d, dend );
+            pos = pref->end;
+        }
+    }
+
+    /* return +/- #chars copied depending on successful expansion */
+    length = d - dest;
+    length = ( entry.error ) ? -length : length;
+
+    /* debug output */
+    if ( handle->debug & 1 )
+        printf( "macTemplateExpandLine() -> %ld\n", length );
+
+    return length;
+}
+
+/*
+ * Free a template
+ */
+void
+epicsStdCall macTemplateFree(
+    macTemplate *tmpl )         /* template */
+{
+    if ( tmpl == NULL )
+        return;
+    free( tmpl->text );
+    free( tmpl->lines );
+    free( tmpl->refs );
+    free( tmpl );
+}
+
 /******************** beginning of static functions ********************/
 
 /*
@@ -558,10 +791,15 @@ static MAC_ENTRY *create( MAC_HANDLE *handle, const char *name, int special )
             entry->length  = 0;
             entry->error   = FALSE;
             entry->visited = FALSE;
+            entry->expanding = FALSE;
+            entry->fresh   = FALSE;
             entry->special = special;
             entry->level   = handle->level;
+            entry->chain   = NULL;
 
             ellAdd( list, ( ELLNODE * ) entry );
+            if ( !special )
+                indexAdd( handle, entry );
         }
     }
 
@@ -579,12 +817,23 @@ static MAC_ENTRY *lookup( MAC_HANDLE *handle, const char *name, int special )
         printf( "lookup-> level = %d, name = %s, special = %d\n",
                 handle->level, name, special );
 
-    /* search backwards so scoping works */
-    for ( entry = last( handle ); entry != NULL; entry = previous( entry ) ) {
-        if ( entry->special != special )
-            continue;
-        if ( strcmp( name, entry->name ) == 0 )
-            break;
+    if ( !special && handle->index ) {
+        unsigned int hash = epicsStrHash( name, 0 );
+
+        for ( entry = handle->index->buckets[hash & handle->index->mask];
+              entry != NULL; entry = entry->chain ) {
+            if ( entry->hash == hash && strcmp( name, entry->name ) == 0 )
+                break;
+        }
+    }
+    else {
+        /* search backwards so scoping works */
+        for ( entry = last( handle ); entry != NULL; entry = previous( entry ) ) {
+            if ( entry->special != special )
+                continue;
+            if ( strcmp( name, entry->name ) == 0 )
+                break;
+        }
     }
     if ( (special == FALSE) && (entry == NULL) &&
          (handle->flags & FLAG_USE_ENVIRONMENT) ) {
@@ -628,6 +877,8 @@ static void delete( MAC_HANDLE *handle, MAC_ENTRY *entry )
 {
     ELLLIST *list = &handle->list;
 
+    if ( !entry->special )
+        indexRemove( handle, entry );
     ellDelete( list, ( ELLNODE * ) entry );
 
     dbmfFree( entry->name );
@@ -640,42 +891,142 @@ static void delete( MAC_HANDLE *handle, MAC_ENTRY *entry )
     handle->dirty = TRUE;
 }
 
+/*
+ * Add a new entry to the hash index, creating or growing the index as
+ * needed. If memory runs out the index is dropped and lookup() falls
+ * back to searching the list.
+ */
+static void indexAdd( MAC_HANDLE *handle, MAC_ENTRY *entry )
+{
+    struct macIndex *index = handle->index;
+
+    entry->hash = epicsStrHash( entry->name, 0 );
+
+    if ( index == NULL || index->count > index->mask ) {
+        unsigned int nbuckets = index ? 4 * ( index->mask + 1 ) : 16;
+        MAC_ENTRY **buckets = calloc( nbuckets, sizeof( MAC_ENTRY * ) );
+        MAC_ENTRY *e;
+
+        if ( index == NULL && buckets != NULL ) {
+            index = calloc( 1, sizeof( struct macIndex ) );
+            handle->index = index;
+        }
+        if ( buckets == NULL || index == NULL ) {
+            free( buckets );
+            if ( handle->index ) {
+                free( handle->index->buckets );
+                free( handle->index );
+                handle->index = NULL;
+            }
+            return;
+        }
+
+        /* re-insert in list order, which keeps the chains in order */
+        free( index->buckets );
+        index->buckets = buckets;
+        index->mask = nbuckets - 1;
+        index->count = 0;
+        for ( e = first( handle ); e != NULL; e = next( e ) ) {
+            if ( e->special || e == entry )
+                continue;
+            e->chain = buckets[e->hash & index->mask];
+            buckets[e->hash & index->mask] = e;
+            index->count++;
+        }
+    }
+
+    entry->chain = index->buckets[entry->hash & index->mask];
+    index->buckets[entry->hash & index->mask] = entry;
+    index->count++;
+}
+
+/*
+ * Remove an entry from the hash index
+ */
+static void indexRemove( MAC_HANDLE *handle, MAC_ENTRY *entry )
+{
+    struct macIndex *index = handle->index;
+    MAC_ENTRY **pe;
+
+    if ( index == NULL )
+        return;
+    for ( pe = &index->buckets[entry->hash & index->mask]; *pe != NULL;
+          pe = &( *pe )->chain ) {
+        if ( *pe == entry ) {
+            *pe = entry->chain;
+            index->count--;
+            return;
+        }
+    }
+}
+
 /*
  * Expand macro definitions (expensive but done very infrequently)
+ *
+ * While FLAG_EXPANDING is set, refer() expands a macro it needs that
+ * hasn't been expanded yet in this pass, and uses the value if it has no
+ * errors in it. Each value is then only expanded once however deeply the
+ * definitions are nested. refer() clears the flag whenever the context
+ * differs from the one at the top of an expansion (warnings suppressed,
+ * scoped macros defined, or translating a raw value of another macro),
+ * so every value comes out as if it had been expanded on its own.
  */
 static long expand( MAC_HANDLE *handle )
 {
     MAC_ENTRY *entry;
-    const char *rawval;
-    char      *value;
+    long status = 0;
 
     if ( !handle->dirty )
         return 0;
 
+    for ( entry = first( handle ); entry != NULL; entry = next( entry ) )
+        entry->fresh = FALSE;
+
+    handle->flags |= FLAG_EXPANDING;
     for ( entry = first( handle ); entry != NULL; entry = next( entry ) ) {
+        if ( !entry->fresh && expandEntry( handle, entry ) < 0 ) {
+            status = -1;
+            break;
+        }
+    }
+    handle->flags &= ~FLAG_EXPANDING;
 
-        if ( handle->debug & 2 )
-            printf( "\nexpand %s = %s\n", entry->name,
-                entry->rawval ? entry->rawval : "" );
+    if ( status == 0 )
+        handle->dirty = FALSE;
 
-        if ( entry->value == NULL ) {
-            if ( ( entry->value = malloc( MAC_SIZE + 1 ) ) == NULL ) {
-                return -1;
-            }
-        }
+    return status;
+}
+
+/*
+ * Expand the value of one macro definition
+ */
+static long expandEntry( MAC_HANDLE *handle, MAC_ENTRY *entry )
+{
+    const char *rawval;
+    char      *value;
 
-        /* start at level 1 so quotes and escapes will be removed from
-           expanded value */
-        rawval = entry->rawval;
-        value  = entry->value;
-        *value = '\0';
-        entry->error  = FALSE;
-        trans( handle, entry, 1, "", &rawval, &value, entry->value + MAC_SIZE );
-        entry->length = value - entry->value;
-        entry->value[MAC_SIZE] = '\0';
+    if ( handle->debug & 2 )
+        printf( "\nexpand %s = %s\n", entry->name,
+            entry->rawval ? entry->rawval : "" );
+
+    if ( entry->value == NULL ) {
+        if ( ( entry->value = malloc( MAC_SIZE + 1 ) ) == NULL ) {
+            return -1;
+        }
     }
 
-    handle->dirty = FALSE;
+    /* start at level 1 so quotes and escapes will be removed from
+       expanded value */
+    rawval = entry->rawval;
+    value  = entry->value;
+    *value = '\0';
+    entry->error  = FALSE;
+    entry->expanding = TRUE;
+    trans( handle, entry, 1, "", &rawval, &value, entry->value + MAC_SIZE );
+    entry->expanding = FALSE;
+    entry->fresh  = TRUE;
+    entry->length = value - entry->value;
+    entry->value[MAC_SIZE] = '\0';
 
     return 0;
 }
@@ -784,6 +1135,7 @@ static void refer ( MAC_HANDLE *handle, MAC_ENTRY *entry, int level,
     const char *macEnd;
     const char *errval = NULL;
     int pop = FALSE;
+    int expanding = handle->flags & FLAG_EXPANDING;
 
     /* debug output */
     if ( handle->debug & 2 )
@@ -805,6 +1157,7 @@ static void refer ( MAC_HANDLE *handle, MAC_ENTRY *entry, int level,
         MAC_ENTRY dflt;
         int flags = handle->flags;
         handle->flags |= FLAG_SUPPRESS_WARNINGS;
+        handle->flags &= ~FLAG_EXPANDING;
 
         /* store its location in case we need it */
         defval = ++r;
@@ -829,6 +1182,7 @@ static void refer ( MAC_HANDLE *handle, MAC_ENTRY *entry, int level,
 
         macPushScope( handle );
         pop = TRUE;
+        handle->flags &= ~FLAG_EXPANDING;
 
         while ( *r == ',' ) {
             char subname[MAC_SIZE + 1] = {'\0'};
@@ -857,7 +1211,8 @@ static void refer ( MAC_HANDLE *handle, MAC_ENTRY *entry, int level,
             }
         }
 
-        handle->flags = flags;
+        /* no expanding other macros while the scoped ones are defined */
+        handle->flags = flags & ~FLAG_EXPANDING;
     }
 
     /* Now we can look up the translated name */
@@ -866,16 +1221,25 @@ static void refer ( MAC_HANDLE *handle, MAC_ENTRY *entry, int level,
     if ( refentry ) {
         if ( !refentry->visited ) {
             /* reference is good, use it */
-            if ( !handle->dirty ) {
+            if ( handle->dirty && ( handle->flags & FLAG_EXPANDING ) &&
+                 !refentry->fresh && !refentry->expanding )
+                expandEntry( handle, refentry );
+
+            if ( !handle->dirty ||
+                 ( ( handle->flags & FLAG_EXPANDING ) &&
+                   refentry->fresh && !refentry->error ) ) {
                 /* copy the already-expanded value, merge any error status */
                 cpy2val( refentry->value, &v, valend );
                 entry->error = entry->error || refentry->error;
             } else {
                 /* translate raw value */
                 const char *rv = refentry->rawval;
+                int flags = handle->flags;
+                handle->flags &= ~FLAG_EXPANDING;
                 refentry->visited = TRUE;
                 trans( handle, entry, level + 1, "", &rv, &v, valend );
                 refentry->visited = FALSE;
+                handle->flags = flags;
             }
             goto cleanup;
         }
@@ -916,6 +1280,7 @@ static void refer ( MAC_HANDLE *handle, MAC_ENTRY *entry, int level,
 cleanup:
     if (pop) {
         macPopScope( handle );
+        handle->flags |= expanding;
     }
 
     /* debug output */
@@ -940,6 +1305,99 @@ static void cpy2val(const char *src, char **value, char *valend)
     *value = v;
 }
 
+/*
+ * Append a line to a template, locating its macro references. The scan
+ * follows trans() at level 0; the extent of each reference is found by
+ * letting refer() parse it in the scratch context, since the syntax
+ * alone determines where a reference ends.
+ */
+static int addLine( macTemplate *tmpl, MAC_HANDLE *scratch, const char *line )
+{
+    MAC_TEMPLATE_LINE *pline;
+    size_t length = strlen( line );
+    const char *r;
+    char quote = 0;
+
+    if ( tmpl->nlines == tmpl->linesAlloc ) {
+        size_t count = tmpl->linesAlloc ? 2 * tmpl->linesAlloc : 64;
+        void *lines = realloc( tmpl->lines, count * sizeof( MAC_TEMPLATE_LINE ) );
+
+        if ( lines == NULL ) goto nomem;
+        tmpl->lines = lines;
+        tmpl->linesAlloc = count;
+    }
+    if ( tmpl->textSize + length + 1 > tmpl->textAlloc ) {
+        size_t size = tmpl->textAlloc ? 2 * tmpl->textAlloc : 4096;
+        void *text;
+
+        while ( size < tmpl->textSize + length + 1 )
+            size *= 2;
+        text = realloc( tmpl->text, size );
+        if ( text == NULL ) goto nomem;
+        tmpl->text = text;
+        tmpl->textAlloc = size;
+    }
+
+    pline = &tmpl->lines[tmpl->nlines++];
+    pline->offset = tmpl->textSize;
+    pline->length = length;
+    pline->firstRef = tmpl->nrefs;
+    pline->nrefs = 0;
+    memcpy( tmpl->text + tmpl->textSize, line, length + 1 );
+    tmpl->textSize += length + 1;
+
+    for ( r = line; *r != '\0'; r++ ) {
+        int macRef;
+
+        if ( quote ) {
+            if ( *r == quote )
+                quote = 0;
+        }
+        else if ( *r == '"' || *r == '\'' ) {
+            quote = *r;
+        }
+
+        macRef = ( *r == '$' &&
+                   *( r + 1 ) != '\0' &&
+                   strchr( "({", *( r + 1 ) ) != NULL );
+
+        if ( macRef && quote != '\'' ) {
+            MAC_TEMPLATE_REF *pref;
+            MAC_ENTRY entry;
+            char value[MAC_SIZE + 1];
+            char *v = value;
+            size_t start = r - line;
+
+            entry.name  = (char *) line;
+            entry.type  = "string";
+            entry.error = FALSE;
+            refer( scratch, &entry, 0, &r, &v, value + MAC_SIZE );
+
+            if ( tmpl->nrefs == tmpl->refsAlloc ) {
+                size_t count = tmpl->refsAlloc ? 2 * tmpl->refsAlloc : 64;
+                void *refs = realloc( tmpl->refs,
+                    count * sizeof( MAC_TEMPLATE_REF ) );
+
+                if ( refs == NULL ) goto nomem;
+                tmpl->refs = refs;
+                tmpl->refsAlloc = count;
+            }
+            pref = &tmpl->refs[tmpl->nrefs++];
+            pref->start = start;
+            pref->end = r + 1 - line;
+            pline->nrefs++;
+        }
+        else if ( *r == '\\' && *( r + 1 ) != '\0' ) {
+            r++;
+        }
+    }
+    return 0;
+
+nomem:
+    errlogPrintf( "macTemplateRead: failed to allocate template\n" );
+    return -1;
+}
+
 /*
  * strdup() implementation which uses our own memory allocator
  */
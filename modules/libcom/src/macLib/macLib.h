@@ -25,6 +25,8 @@
 #ifndef INCmacLibH
 #define INCmacLibH
 
+#include <stdio.h>
+
 #include "ellLib.h"
 #include "libComAPI.h"
 
@@ -47,6 +49,7 @@ typedef struct {
     int         debug;          /**< \brief debugging level */
     ELLLIST     list;           /**< \brief macro name / value list */
     int         flags;          /**< \brief operating mode flags */
+    struct macIndex *index;     /**< \brief hashed macro names */
 } MAC_HANDLE;
 
 /** \name Core Library
@@ -302,6 +305,83 @@ epicsStdCall macDefExpand(
 );
 /** @} */
 
+/** \name Pre-scanned Templates
+ * A template holds the lines of a text file together with the positions
+ * of the macro references in each line, so a file that gets expanded
+ * many times with different macro values is only read and scanned once.
+ * Expanding a line of a template gives exactly the same result as
+ * passing the line to macExpandString().
+ * @{
+ */
+
+/** \brief Opaque template type. */
+typedef struct macTemplate macTemplate;
+
+/**
+ * \brief Read a file into a new template.
+ * \return The template; NULL on failure
+ *
+ * The file is split into lines the way repeated calls to
+ * fgets(buffer, lineSize, fp) would split it, so a line longer than
+ * \c lineSize-1 characters becomes several template lines.
+ */
+LIBCOM_API macTemplate *
+epicsStdCall macTemplateRead(
+    FILE        *fp,            /**< file to read, not closed */
+
+    int         lineSize        /**< size of a line buffer, at least 2 */
+);
+
+/**
+ * \brief Number of lines in a template.
+ */
+LIBCOM_API int
+epicsStdCall macTemplateLines(
+    const macTemplate *tmpl     /**< template */
+);
+
+/**
+ * \brief Raw (unexpanded) text of a template line.
+ * \return The line, including any newline; NULL if out of range
+ */
+LIBCOM_API const char *
+epicsStdCall macTemplateLine(
+    const macTemplate *tmpl,    /**< template */
+
+    int         line            /**< line number, starting at 0 */
+);
+
+/**
+ * \brief Expand a template line which may contain macro references.
+ * \return Returns the length of the expanded line, <0 if any macro are
+ * undefined
+ *
+ * The result, return value and any warnings are the same as those of
+ * macExpandString() called with the raw text of the line, but the text
+ * between macro references is copied without being parsed again.
+ */
+LIBCOM_API long
+epicsStdCall macTemplateExpandLine(
+    MAC_HANDLE  *handle,        /**< opaque handle */
+
+    const macTemplate *tmpl,    /**< template */
+
+    int         line,           /**< line number, starting at 0 */
+
+    char        *dest,          /**< destination string */
+
+    long        capacity        /**< capacity of destination buffer (dest) */
+);
+
+/**
+ * \brief Free a template.
+ */
+LIBCOM_API void
+epicsStdCall macTemplateFree(
+    macTemplate *tmpl           /**< template; may be NULL */
+);
+/** @} */
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,67 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/* Measure calcPerform() on some typical record expressions */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "postfix.h"
+#include "epicsTime.h"
+#include "epicsUnitTest.h"
+#include "testMain.h"
+
+#define NLOOPS 2000000
+
+static const char *exprs[] = {
+    "A+B",
+    "A>B?C:D",
+    "(A-B)/C*100",
+    "A*2+B*3+1",
+    "ABS(A-B)<0.5?1:0",
+    "SIN(A*D2R)*B",
+    "MAX(A,B,C,D)",
+    "A&0xff|B<<8",
+    "(A+B+C+D+E+F)/6",
+    "C:=A+1;C>10?0:C",
+    "1+2*3-4/8",
+    "A#0&&B#0?(A>B?A:B):-1",
+};
+
+MAIN(epicsCalcPerform)
+{
+    double args[CALCPERFORM_NARGS] = {
+        1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 11.0, 12.0
+    };
+    char rpn[INFIX_TO_POSTFIX_SIZE(80)];
+    double result = 0, total = 0;
+    size_t e;
+
+    testPlan(0);
+
+    for (e = 0; e < sizeof(exprs) / sizeof(exprs[0]); e++) {
+        epicsUInt64 start;
+        double elapsed;
+        short err;
+        int i;
+
+        if (postfix(exprs[e], rpn, &err))
+            testAbort("postfix: %s in '%s'", calcErrorStr(err), exprs[e]);
+
+        start = epicsMonotonicGet();
+        for (i = 0; i < NLOOPS; i++) {
+            args[0] = i & 15;
+            calcPerform(args, &result, rpn);
+        }
+        elapsed = (epicsMonotonicGet() - start) * 1e-9;
+        total += elapsed;
+        testDiag("%-24s %6.1f ns each", exprs[e], elapsed * 1e9 / NLOOPS);
+    }
+    testDiag("%-24s %6.1f ns each", "Average",
+        total * 1e9 / NLOOPS / (sizeof(exprs) / sizeof(exprs[0])));
+
+    return testDone();
+}
@@ -298,7 +298,7 @@ MAIN(epicsCalcTest)
     const double a=1.0, b=2.0, c=3.0, d=4.0, e=5.0, f=6.0,
                  g=7.0, h=8.0, i=9.0, j=10.0, k=11.0, l=12.0;
 
-    testPlan(630);
+    testPlan(641);
 
     /* LITERAL_OPERAND elements */
     testExpr(0);
@@ -903,6 +903,17 @@ MAIN(epicsCalcTest)
     testCalc("1+(1|2)**3", 1+pow((double) (1 | 2), 3.));// 8 6
     testExpr(1+(1?(1<2):(1>2))*2);
 
+    // Constant folding and fused operators
+    testCalc("1/(0*-1)", -Inf);
+    testCalc("0x80000000 % -1", 0);
+    testCalc("A % -1", 0);
+    testCalc("0 ? 1/0 : 2+3", 5);
+    testCalc("A>B?C:D", 4);
+    testCalc("B>A?C-A:D/B", 2);
+    testCalc("(A+B+C+D+E+F)/6", 3.5);
+    testCalc("C:=A+1;C>10?0:C", 2);
+    testCalc("B:=A;A*2+B*3+1", 6);
+
     testArgs("a", A_A, 0);
     testArgs("A", A_A, 0);
     testArgs("B", A_B, 0);
@@ -932,6 +943,8 @@ MAIN(epicsCalcTest)
     testArgs("11.1;L:=0", 0, A_L);
     testArgs("12.1;A:=0;B:=A;C:=B;D:=C", 0, A_A|A_B|A_C|A_D);
     testArgs("13.1;B:=A;A:=B;C:=D;D:=C", A_A|A_D, A_A|A_B|A_C|A_D);
+    testArgs("A:=1;B+A", A_B, A_A);
+    testArgs("C>B?A-L:D/E", A_A|A_B|A_C|A_D|A_E|A_L, 0);
 
     // Malformed expressions
     testBadExpr("0x0.1", CALC_ERR_SYNTAX);
@@ -11,6 +11,7 @@
 #include <testMain.h>
 #include <epicsUnitTest.h>
 
+#include <epicsThread.h>
 #include <initHooks.h>
 
 static
@@ -22,9 +23,39 @@ void testHookNames(void)
     testOk(strcmp(s, "initHookAtEnd")==0, "'%s' == 'initHookAtEnd'", s);
 }
 
+static
+void slowHook(initHookState state)
+{
+    if (state == initHookAfterInitDatabase)
+        epicsThreadSleep(0.1);
+}
+
+static
+void testHookTimes(void)
+{
+    double t;
+
+    testOk1(initHookRegister(slowHook) == 0);
+    initHookAnnounce(initHookAtIocBuild);
+    initHookAnnounce(initHookAfterInitDatabase);
+    initHookAnnounce(initHookAfterIocBuilt);
+
+    testOk1(initHookTime(initHookAtIocBuild) == 0.0);
+    t = initHookTime(initHookAfterIocBuilt);
+    testOk(t >= 0.09, "initHookAfterIocBuilt after %.3f sec", t);
+    testOk1(initHookTime(initHookAfterInitDatabase) < t);
+    testOk1(initHookTime(initHookAtIocRun) < 0);
+
+    initHookAnnounce(initHookAtIocBuild);
+    testOk(initHookTime(initHookAfterIocBuilt) < 0,
+        "initHookAtIocBuild starts a new profile");
+    initHookFree();
+}
+
 MAIN(initHookTest)
 {
-    testPlan(1);
+    testPlan(7);
     testHookNames();
+    testHookTimes();
     return testDone();
 }
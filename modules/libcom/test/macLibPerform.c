@@ -0,0 +1,97 @@
+/*************************************************************************\
+* SPDX-License-Identifier: EPICS
+* EPICS BASE is distributed subject to a Software License Agreement found
+* in file LICENSE that is included with this distribution.
+\*************************************************************************/
+
+/* Measure macro expansion with many macros and deeply nested values */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "macLib.h"
+#include "epicsStdio.h"
+#include "epicsTime.h"
+#include "epicsUnitTest.h"
+#include "testMain.h"
+
+#define NMACROS 200
+#define NDEPTH 50
+#define NLOOPS 100000
+
+static const char *line =
+    "record(ai, \"$(M0)$(M50):$(M199)\") { field(DESC, \"$(M100) $(M150)\") "
+    "field(INP, \"$(M10)$(M190) CP\") field(EGU, \"$(UNDEFINED=mm)\") }\n";
+
+static double since(epicsUInt64 start)
+{
+    return (epicsMonotonicGet() - start) * 1e-9;
+}
+
+static void report(const char *what, epicsUInt64 start, int count)
+{
+    double elapsed = since(start);
+
+    testDiag("%-34s %8.3f sec, %7.0f ns each", what, elapsed,
+        elapsed * 1e9 / count);
+}
+
+MAIN(macLibPerform)
+{
+    MAC_HANDLE *h;
+    char buffer[1024];
+    epicsUInt64 start;
+    int i;
+
+    testPlan(0);
+
+    if (macCreateHandle(&h, NULL))
+        testAbort("macCreateHandle() failed");
+
+    start = epicsMonotonicGet();
+    for (i = 0; i < NMACROS; i++) {
+        char name[20], value[40];
+
+        epicsSnprintf(name, sizeof(name), "M%d", i);
+        epicsSnprintf(value, sizeof(value), "value%d", i);
+        macPutValue(h, name, value);
+    }
+    macExpandString(h, "", buffer, sizeof(buffer));
+    report("Define and expand 200 macros:", start, NMACROS);
+
+    start = epicsMonotonicGet();
+    for (i = 0; i < NLOOPS; i++)
+        macExpandString(h, line, buffer, sizeof(buffer));
+    report("Expand a line with 8 references:", start, NLOOPS);
+
+    start = epicsMonotonicGet();
+    for (i = 0; i < NLOOPS; i++)
+        macExpandString(h, "$(M5,M1=scoped) $(M1)", buffer, sizeof(buffer));
+    report("Expand a scoped reference:", start, NLOOPS);
+
+    /* D0 refers to D1 which refers to D2 ... */
+    for (i = 0; i < NDEPTH; i++) {
+        char name[20], value[40];
+
+        epicsSnprintf(name, sizeof(name), "D%d", i);
+        if (i < NDEPTH - 1)
+            epicsSnprintf(value, sizeof(value), "$(D%d)x", i + 1);
+        else
+            strcpy(value, "end");
+        macPutValue(h, name, value);
+    }
+    start = epicsMonotonicGet();
+    for (i = 0; i < NLOOPS / 10; i++) {
+        macPutValue(h, "D49", i & 1 ? "odd" : "even");
+        macExpandString(h, "$(D0)", buffer, sizeof(buffer));
+    }
+    report("Redefine and expand 50 deep:", start, NLOOPS / 10);
+
+    start = epicsMonotonicGet();
+    for (i = 0; i < NLOOPS; i++)
+        macExpandString(h, "$(D0)", buffer, sizeof(buffer));
+    report("Expand 50 deep:", start, NLOOPS);
+
+    macDeleteHandle(h);
+    return testDone();
+}
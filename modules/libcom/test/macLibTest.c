@@ -14,6 +14,7 @@
 #include <stdio.h>
 
 #include "macLib.h"
+#include "epicsTempFile.h"
 #include "dbDefs.h"
 #include "envDefs.h"
 #include "errlog.h"
@@ -64,9 +65,94 @@ static void ovcheck(void)
     testOk(output[53] == '~', "sentinel character %x, expect 7e, (~)", output[53]);
 }
 
+static const char *tmplText[] = {
+    "record(ai, \"$(P)$(R=ai)\") {\n",
+    "    field(DESC, \"$(DESC='$(P)')\")\n",
+    "    field(INP, '$(P)') # \"$(P)\"\n",
+    "    field(OUT, \"\\$(P)\\\\$(P)\")\n",
+    "    alias(\"$(P,R=x)$(R)${${Q}}$(UNDEF)\")\n",
+    "abcdefghijklmnopqrstuvwxyz$(LONG)$(P)xyz$(LONG)\n",
+    "$(P) $(${Q}=\n",
+    "}\n",
+    "\n",
+    "no newline $(P)",
+};
+
+/* Template lines must expand exactly as macExpandString() would */
+static void tmplcheck(void)
+{
+    static const long capacity[] = {MAC_SIZE, 40, 8, 2};
+    MAC_HANDLE *t;
+    macTemplate *tmpl;
+    FILE *fp = epicsTempFile();
+    char buffer[40];
+    int i, j, nlines = 0, rawOk = 1;
+
+    if (!fp)
+        testAbort("epicsTempFile() failed");
+    for (i = 0; i < NELEMENTS(tmplText); i++)
+        fputs(tmplText[i], fp);
+
+    if (macCreateHandle(&t, NULL))
+        testAbort("macCreateHandle() failed");
+    macPutValue(t, "P", "pre:");
+    macPutValue(t, "Q", "P");
+    macPutValue(t, "LONG", "abcdefghijklmnopqrstuvwxyz");
+
+    /* Lines longer than the buffer get split, some inside a reference */
+    rewind(fp);
+    tmpl = macTemplateRead(fp, sizeof(buffer));
+    testOk(tmpl != NULL, "macTemplateRead()");
+    if (!tmpl)
+        testAbort("No template");
+
+    rewind(fp);
+    while (fgets(buffer, sizeof(buffer), fp)) {
+        const char *line = macTemplateLine(tmpl, nlines);
+
+        if (!line || strcmp(line, buffer)) {
+            testDiag("Line %d is \"%s\", expected \"%s\"", nlines,
+                line ? line : "(null)", buffer);
+            rawOk = 0;
+        }
+        nlines++;
+    }
+    testOk(macTemplateLines(tmpl) == nlines, "Template has %d lines (%d)",
+        macTemplateLines(tmpl), nlines);
+    testOk(rawOk, "Raw lines are split like fgets()");
+    testOk1(macTemplateLine(tmpl, nlines) == NULL);
+
+    for (j = 0; j < NELEMENTS(capacity); j++) {
+        int same = 1;
+
+        for (i = 0; i < nlines; i++) {
+            char expect[MAC_SIZE], output[MAC_SIZE];
+            long status, expectStatus;
+
+            memset(output, '~', sizeof(output));
+            memset(expect, '~', sizeof(expect));
+            expectStatus = macExpandString(t, macTemplateLine(tmpl, i),
+                expect, capacity[j]);
+            status = macTemplateExpandLine(t, tmpl, i, output, capacity[j]);
+            if (status != expectStatus ||
+                memcmp(output, expect, sizeof(output))) {
+                testDiag("Line %d gave %ld \"%s\", expected %ld \"%s\"",
+                    i, status, output, expectStatus, expect);
+                same = 0;
+            }
+        }
+        testOk(same, "Expansion with capacity %ld matches macExpandString()",
+            capacity[j]);
+    }
+
+    macTemplateFree(tmpl);
+    macDeleteHandle(t);
+    fclose(fp);
+}
+
 MAIN(macLibTest)
 {
-    testPlan(93);
+    testPlan(101);
 
     if (macCreateHandle(&h, NULL))
         testAbort("macCreateHandle() failed");
@@ -221,6 +307,7 @@ MAIN(macLibTest)
     check("${FOO}", "!$(BAR)");
 
     ovcheck();
+    tmplcheck();
 
     return testDone();
 }